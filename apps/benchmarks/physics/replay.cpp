@@ -0,0 +1,266 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw/mwphysics/collisiontype.hpp>
+#include <apps/openmw/mwphysics/movementsolver.hpp>
+#include <apps/openmw/mwphysics/physicssystem.hpp>
+#include <apps/openmw/mwphysics/replay.hpp>
+
+#include <components/misc/barrier.hpp>
+
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace MWPhysics;
+
+    std::vector<Replay::Frame> sFrames;
+    double sSingleThreadRate = 0;
+
+    Replay::Transform makeTranslation(const osg::Vec3f& position)
+    {
+        return { 1, 0, 0, 0, 1, 0, 0, 0, 1, position.x(), position.y(), position.z() };
+    }
+
+    //! A flat area with a grid of pillars and a crowd walking in random directions, used without a recording.
+    std::vector<Replay::Frame> makeSyntheticReplay(std::size_t actorCount, std::size_t frameCount)
+    {
+        constexpr float area = 2048;
+        constexpr float pillarSpacing = 256;
+        constexpr float actorHalfHeight = 64;
+        constexpr float walkSpeed = 150;
+        constexpr float physicsDt = 1.f / 60.f;
+        constexpr std::uint32_t groundShape = 1;
+        constexpr std::uint32_t pillarShape = 2;
+        constexpr std::uint32_t actorShape = 3;
+        constexpr int actorMask = CollisionType_World | CollisionType_HeightMap | CollisionType_Actor
+            | CollisionType_Projectile | CollisionType_Door;
+
+        std::minstd_rand random(42);
+        std::uniform_real_distribution<float> coordinate(-area / 2, area / 2);
+        std::uniform_real_distribution<float> angle(0, 2 * osg::PIf);
+
+        Replay::Frame first;
+        first.mNewShapes.push_back(
+            Replay::Shape{ .mId = groundShape, .mDimensions = osg::Vec3f(area, area, 10), .mMargin = 0.04f });
+        first.mNewShapes.push_back(
+            Replay::Shape{ .mId = pillarShape, .mDimensions = osg::Vec3f(24, 24, 256), .mMargin = 0.04f });
+        first.mNewShapes.push_back(Replay::Shape{
+            .mId = actorShape, .mDimensions = osg::Vec3f(24, 24, actorHalfHeight), .mMargin = 0.04f });
+
+        std::uint32_t nextObject = 1;
+        first.mUpdatedObjects.push_back(Replay::CollisionObject{ .mId = nextObject++,
+            .mShape = groundShape,
+            .mGroup = CollisionType_World,
+            .mMask = CollisionType_Actor | CollisionType_Projectile,
+            .mTransform = makeTranslation(osg::Vec3f(0, 0, -10)) });
+        for (float x = -area / 2; x <= area / 2; x += pillarSpacing)
+            for (float y = -area / 2; y <= area / 2; y += pillarSpacing)
+                first.mUpdatedObjects.push_back(Replay::CollisionObject{ .mId = nextObject++,
+                    .mShape = pillarShape,
+                    .mGroup = CollisionType_World,
+                    .mMask = CollisionType_Actor | CollisionType_Projectile,
+                    .mTransform = makeTranslation(osg::Vec3f(x, y, 256)) });
+
+        std::vector<Replay::ActorInput> actors(actorCount);
+        for (Replay::ActorInput& actor : actors)
+        {
+            const float direction = angle(random);
+            actor.mCollisionObject = nextObject++;
+            actor.mPosition = osg::Vec3f(coordinate(random), coordinate(random), 0);
+            actor.mCollisionObjectOffset = osg::Vec3f(0, 0, actorHalfHeight);
+            actor.mMovement = osg::Vec3f(std::cos(direction), std::sin(direction), 0) * walkSpeed;
+            actor.mLastStuckPosition = actor.mPosition;
+            actor.mWaterlevel = -10000;
+            actor.mSwimLevel = actor.mWaterlevel - 2 * actorHalfHeight;
+            actor.mHalfExtentsZ = actorHalfHeight;
+            actor.mIsOnGround = true;
+            actor.mWasOnGround = true;
+        }
+
+        std::vector<Replay::Frame> frames;
+        frames.reserve(frameCount);
+        frames.push_back(std::move(first));
+        frames.resize(frameCount);
+        for (Replay::Frame& frame : frames)
+        {
+            frame.mNumSteps = 1;
+            frame.mPhysicsDt = physicsDt;
+            for (Replay::ActorInput& actor : actors)
+            {
+                if (std::abs(actor.mPosition.x()) > area / 2)
+                    actor.mMovement.x() = -actor.mMovement.x();
+                if (std::abs(actor.mPosition.y()) > area / 2)
+                    actor.mMovement.y() = -actor.mMovement.y();
+                frame.mUpdatedObjects.push_back(Replay::CollisionObject{ .mId = actor.mCollisionObject,
+                    .mShape = actorShape,
+                    .mGroup = CollisionType_Actor,
+                    .mMask = actorMask,
+                    .mTransform = makeTranslation(actor.mPosition + actor.mCollisionObjectOffset) });
+                frame.mActors.push_back(actor);
+                actor.mPosition += actor.mMovement * physicsDt;
+            }
+        }
+        return frames;
+    }
+
+    //! Steps replay frames the way PhysicsTaskScheduler does: actors are unstuck and their collision objects moved on
+    //! one thread, while the movement itself is solved by all threads picking up actors one by one.
+    class Replayer
+    {
+    public:
+        explicit Replayer(unsigned threadCount)
+            : mStepStart(threadCount)
+            , mStepEnd(threadCount)
+        {
+            for (unsigned i = 1; i < threadCount; ++i)
+                mThreads.emplace_back([this] { worker(); });
+        }
+
+        ~Replayer()
+        {
+            mStop = true;
+            mStepStart.wait([] {});
+            for (std::thread& thread : mThreads)
+                thread.join();
+        }
+
+        struct Result
+        {
+            std::size_t mActorSteps = 0;
+            double mSeconds = 0;
+        };
+
+        Result run(const std::vector<Replay::Frame>& frames)
+        {
+            // Frames are incremental, so every pass needs a new world. Only stepping the simulation is timed.
+            Replay::World world;
+            std::chrono::steady_clock::duration elapsed{};
+            std::size_t actorSteps = 0;
+            for (const Replay::Frame& frame : frames)
+            {
+                world.apply(frame);
+                mActors = world.makeActorFrameData(frame);
+                mCollisionWorld = &world.getCollisionWorld();
+                mPhysicsDt = frame.mPhysicsDt;
+
+                const auto start = std::chrono::steady_clock::now();
+                for (unsigned step = 0; step < frame.mNumSteps; ++step)
+                {
+                    for (ActorFrameData& actor : mActors)
+                        MovementSolver::unstuck(actor, mCollisionWorld);
+                    mNextJob.store(0, std::memory_order_relaxed);
+                    mStepStart.wait([] {});
+                    moveActors();
+                    mStepEnd.wait([] {});
+                    for (std::size_t i = 0; i < mActors.size(); ++i)
+                        world.updateActorPosition(mActors[i], frame.mActors[i]);
+                }
+                elapsed += std::chrono::steady_clock::now() - start;
+                actorSteps += mActors.size() * frame.mNumSteps;
+            }
+            return Result{ actorSteps, std::chrono::duration<double>(elapsed).count() };
+        }
+
+    private:
+        void worker()
+        {
+            while (true)
+            {
+                mStepStart.wait([] {});
+                if (mStop)
+                    return;
+                moveActors();
+                mStepEnd.wait([] {});
+            }
+        }
+
+        void moveActors()
+        {
+            std::size_t job = 0;
+            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mActors.size())
+                MovementSolver::move(mActors[job], mPhysicsDt, mCollisionWorld, mWorldData);
+        }
+
+        // Storms need the game settings, replays are simulated without them
+        const WorldFrameData mWorldData{ false, osg::Vec3f() };
+        std::vector<ActorFrameData> mActors;
+        btCollisionWorld* mCollisionWorld = nullptr;
+        float mPhysicsDt = 0;
+        std::atomic<std::size_t> mNextJob{ 0 };
+        bool mStop = false;
+        Misc::Barrier mStepStart;
+        Misc::Barrier mStepEnd;
+        std::vector<std::thread> mThreads;
+    };
+
+    void replay(benchmark::State& state)
+    {
+        const unsigned threadCount = static_cast<unsigned>(state.range(0));
+        Replayer replayer(threadCount);
+        std::size_t actorSteps = 0;
+        double seconds = 0;
+        for (auto _ : state)
+        {
+            const Replayer::Result result = replayer.run(sFrames);
+            state.SetIterationTime(result.mSeconds);
+            actorSteps += result.mActorSteps;
+            seconds += result.mSeconds;
+        }
+
+        const double rate = seconds > 0 ? static_cast<double>(actorSteps) / seconds : 0;
+        if (threadCount == 1)
+            sSingleThreadRate = rate;
+        state.counters["actor_steps"] = benchmark::Counter(static_cast<double>(actorSteps), benchmark::Counter::kIsRate);
+        if (sSingleThreadRate > 0)
+        {
+            state.counters["speedup"] = rate / sSingleThreadRate;
+            state.counters["efficiency"] = rate / sSingleThreadRate / threadCount;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+
+    try
+    {
+        if (argc > 1)
+        {
+            Replay::Reader reader{ std::filesystem::path(argv[1]) };
+            Replay::Frame frame;
+            while (reader.read(frame))
+                sFrames.push_back(std::move(frame));
+        }
+        else
+            sFrames = makeSyntheticReplay(256, 120);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load physics replay: " << e.what() << std::endl;
+        return 1;
+    }
+
+    const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    benchmark::RegisterBenchmark("replay", replay)
+        ->ArgName("threads")
+        ->DenseRange(1, maxThreads)
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
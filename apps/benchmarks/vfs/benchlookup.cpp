@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include "components/vfs/fileindex.hpp"
+#include "components/vfs/filemap.hpp"
+#include "components/vfs/pathutil.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Similar to a large modded install
+    constexpr std::size_t filesCount = 200 * 1024;
+    constexpr std::size_t queriesCount = 64 * 1024;
+
+    template <class Random>
+    std::string generateName(Random& random)
+    {
+        std::uniform_int_distribution<std::size_t> size(4, 16);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::string result(size(random), ' ');
+        std::generate(result.begin(), result.end(), [&] { return static_cast<char>(letter(random)); });
+        return result;
+    }
+
+    // Paths share long prefixes like in real data, which is the worst case for comparing them
+    template <class Random>
+    std::string generatePath(Random& random)
+    {
+        constexpr std::array<std::string_view, 4> roots = { "meshes/", "textures/", "sound/", "icons/" };
+        constexpr std::array<std::string_view, 4> extensions = { ".nif", ".dds", ".wav", ".tga" };
+        std::uniform_int_distribution<std::size_t> kind(0, roots.size() - 1);
+        std::uniform_int_distribution<int> subdirectory(0, 63);
+        const std::size_t k = kind(random);
+        return std::string(roots[k]) + "mod_" + std::to_string(subdirectory(random)) + "/" + generateName(random)
+            + std::string(extensions[k]);
+    }
+
+    struct Data
+    {
+        VFS::FileMap mFiles;
+        std::vector<VFS::Path::Normalized> mExisting;
+        std::vector<VFS::Path::Normalized> mMissing;
+    };
+
+    const Data& getData()
+    {
+        static const Data data = [] {
+            std::minstd_rand random;
+            Data result;
+            while (result.mFiles.size() < filesCount)
+                result.mFiles.emplace(VFS::Path::Normalized(generatePath(random)), nullptr);
+            std::vector<VFS::Path::Normalized> paths;
+            paths.reserve(result.mFiles.size());
+            for (const auto& [path, file] : result.mFiles)
+                paths.push_back(path);
+            std::uniform_int_distribution<std::size_t> index(0, paths.size() - 1);
+            result.mExisting.reserve(queriesCount);
+            std::generate_n(std::back_inserter(result.mExisting), queriesCount, [&] { return paths[index(random)]; });
+            result.mMissing.reserve(queriesCount);
+            while (result.mMissing.size() < queriesCount)
+                if (VFS::Path::Normalized path(generatePath(random)); !result.mFiles.contains(path))
+                    result.mMissing.push_back(std::move(path));
+            return result;
+        }();
+        return data;
+    }
+
+    template <class Find>
+    void lookup(benchmark::State& state, const std::vector<VFS::Path::Normalized>& queries, Find&& find)
+    {
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(find(queries[i].view()));
+            if (++i >= queries.size())
+                i = 0;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void findExistingInFileMap(benchmark::State& state)
+    {
+        const Data& data = getData();
+        lookup(state, data.mExisting, [&](std::string_view path) { return data.mFiles.find(path); });
+    }
+
+    void findMissingInFileMap(benchmark::State& state)
+    {
+        const Data& data = getData();
+        lookup(state, data.mMissing, [&](std::string_view path) { return data.mFiles.find(path); });
+    }
+
+    void findExistingInFileIndex(benchmark::State& state)
+    {
+        const Data& data = getData();
+        VFS::FileIndex index;
+        index.build(data.mFiles);
+        lookup(state, data.mExisting, [&](std::string_view path) { return index.contains(path); });
+    }
+
+    void findMissingInFileIndex(benchmark::State& state)
+    {
+        const Data& data = getData();
+        VFS::FileIndex index;
+        index.build(data.mFiles);
+        lookup(state, data.mMissing, [&](std::string_view path) { return index.contains(path); });
+    }
+
+    void buildFileIndex(benchmark::State& state)
+    {
+        const Data& data = getData();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            VFS::FileIndex index;
+            index.build(data.mFiles);
+            benchmark::DoNotOptimize(index);
+        }
+    }
+}
+
+BENCHMARK(findExistingInFileMap);
+BENCHMARK(findMissingInFileMap);
+BENCHMARK(findExistingInFileIndex);
+BENCHMARK(findMissingInFileIndex);
+BENCHMARK(buildFileIndex);
+
+BENCHMARK_MAIN();
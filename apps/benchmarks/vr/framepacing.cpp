@@ -0,0 +1,362 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/strings/conversion.hpp>
+#include <components/settings/parser.hpp>
+#include <components/settings/settings.hpp>
+#include <components/settings/values.hpp>
+#include <components/stereo/stereomanager.hpp>
+#include <components/vr/frame.hpp>
+#include <components/vr/layer.hpp>
+#include <components/vr/session.hpp>
+#include <components/vr/space.hpp>
+#include <components/vr/swapchain.hpp>
+#include <components/vr/viewer.hpp>
+#include <components/vr/vr.hpp>
+
+#include <osg/RenderInfo>
+#include <osgViewer/Viewer>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    //! Stand-in for a typical 90 Hz headset.
+    constexpr VR::DisplayTime displayPeriod = 1000000000 / 90;
+
+    //! Collects one latency sample per iteration and reports the distribution as benchmark counters.
+    class LatencyHistogram
+    {
+    public:
+        explicit LatencyHistogram(std::string name)
+            : mName(std::move(name))
+        {
+        }
+
+        void add(Clock::duration value) { mSamples.push_back(value); }
+
+        void report(benchmark::State& state)
+        {
+            if (mSamples.empty())
+                return;
+            std::sort(mSamples.begin(), mSamples.end());
+            const auto percentile = [&](double p) {
+                const std::size_t index = static_cast<std::size_t>(p * static_cast<double>(mSamples.size() - 1));
+                return std::chrono::duration<double, std::micro>(mSamples[index]).count();
+            };
+            state.counters[mName + ".p50_us"] = percentile(0.5);
+            state.counters[mName + ".p90_us"] = percentile(0.9);
+            state.counters[mName + ".p99_us"] = percentile(0.99);
+            state.counters[mName + ".max_us"] = percentile(1.0);
+        }
+
+    private:
+        std::string mName;
+        std::vector<Clock::duration> mSamples;
+    };
+
+    template <class F>
+    void measure(LatencyHistogram& histogram, F&& f)
+    {
+        const auto start = Clock::now();
+        f();
+        histogram.add(Clock::now() - start);
+    }
+
+    class StubSwapchainImage : public VR::SwapchainImage
+    {
+    public:
+        explicit StubSwapchainImage(uint32_t image)
+            : mImage(image)
+        {
+        }
+
+        uint32_t glImage() const override { return mImage; }
+
+    private:
+        uint32_t mImage;
+    };
+
+    //! Mimics the acquire/wait/release cycle of an OpenXR swapchain with a small ring of images.
+    class StubSwapchain : public VR::Swapchain
+    {
+    public:
+        StubSwapchain(uint32_t width, uint32_t height, uint32_t samples, uint32_t arraySize, Attachment attachment,
+            const std::string& name, std::size_t imageCount)
+            : VR::Swapchain(width, height, samples, arraySize, attachment, name)
+        {
+            for (std::size_t i = 0; i < imageCount; ++i)
+                mImages.push_back(std::make_unique<StubSwapchainImage>(static_cast<uint32_t>(i + 1)));
+            mAcquiredIndex = mImages.size();
+        }
+
+        void beginFrame(osg::GraphicsContext* gc) override
+        {
+            std::lock_guard lock(mMutex);
+            if (mAcquiredIndex < mImages.size())
+                return;
+            mAcquiredIndex = mNextIndex;
+            mNextIndex = (mNextIndex + 1) % mImages.size();
+            mImages[mAcquiredIndex]->beginFrame(gc);
+        }
+
+        void endFrame(osg::GraphicsContext* gc) override
+        {
+            std::lock_guard lock(mMutex);
+            if (mAcquiredIndex >= mImages.size())
+                return;
+            mImages[mAcquiredIndex]->endFrame(gc);
+            mAcquiredIndex = mImages.size();
+        }
+
+        VR::SwapchainImage* image() override
+        {
+            return mAcquiredIndex < mImages.size() ? mImages[mAcquiredIndex].get() : nullptr;
+        }
+
+        void* handle() const override { return nullptr; }
+
+        bool mustFlipVertical() const override { return false; }
+
+    private:
+        std::mutex mMutex;
+        std::vector<std::unique_ptr<StubSwapchainImage>> mImages;
+        std::size_t mAcquiredIndex = 0;
+        std::size_t mNextIndex = 0;
+    };
+
+    class StubSpace : public VR::Space
+    {
+    public:
+        VR::TrackingPose locate(VR::Space& reference) override { return locateInWorld(); }
+
+        VR::TrackingPose locateInWorld() override
+        {
+            VR::TrackingPose pose;
+            pose.status = VR::TrackingStatus::Good;
+            pose.pose.position = Stereo::Position::fromMeters(0.f, 0.f, 1.7f);
+            pose.time = VR::getPredictedDisplayTime();
+            return pose;
+        }
+    };
+
+    //! A VR::Session backed by no runtime at all. Frame timing is derived from the steady clock so that the
+    //! session code paths see plausible, monotonically increasing display times.
+    class StubSession : public VR::Session
+    {
+    public:
+        StubSession()
+        {
+            mReferenceSpaces[0] = std::make_shared<StubSpace>();
+            mReferenceSpaces[1] = std::make_shared<StubSpace>();
+            mReferenceSpaces[2] = std::make_shared<StubSpace>();
+        }
+
+        std::shared_ptr<VR::Swapchain> createSwapchain(uint32_t width, uint32_t height, uint32_t samples,
+            uint32_t arraySize, VR::Swapchain::Attachment attachment, const std::string& name) override
+        {
+            return std::make_shared<StubSwapchain>(width, height, samples, arraySize, attachment, name, 3);
+        }
+
+        std::array<Stereo::View, 2> locateViews(int64_t predictedDisplayTime, VR::Space& reference) override
+        {
+            const auto head = reference.locate(reference);
+            std::array<Stereo::View, 2> views{};
+            for (auto side : { VR::Side_Left, VR::Side_Right })
+            {
+                views[side].pose = head.pose;
+                views[side].pose.position.mX
+                    = Stereo::Unit::fromMeters(side == VR::Side_Left ? -0.032f : 0.032f);
+                views[side].fov = { -0.9f, 0.9f, 0.9f, -0.9f };
+            }
+            return views;
+        }
+
+        std::array<VR::SwapchainConfig, 2> getRecommendedSwapchainConfig() const override
+        {
+            VR::SwapchainConfig config;
+            config.recommendedWidth = config.maxWidth = 1832;
+            config.recommendedHeight = config.maxHeight = 1920;
+            config.recommendedSamples = config.maxSamples = 1;
+            return { config, config };
+        }
+
+        std::vector<VR::ReferenceSpace> getSupportedReferenceSpaceTypes() const override
+        {
+            return { VR::ReferenceSpace::View, VR::ReferenceSpace::Local, VR::ReferenceSpace::Stage };
+        }
+
+        void setReferenceWorldPose(Stereo::Pose pose) override {}
+
+        std::shared_ptr<VR::Space> getReferenceSpace(VR::ReferenceSpace space) override
+        {
+            return mReferenceSpaces[static_cast<int>(space) - 1];
+        }
+
+        //! Public so the benchmark can stand in for Session::swapBuffers(), which needs a graphics context.
+        void syncFrameEnd(VR::Frame& frame) override { mSubmittedLayers += frame.layers.size(); }
+
+        std::size_t submittedLayers() const { return mSubmittedLayers; }
+
+    protected:
+        void newFrame(uint64_t frameNo, bool& shouldSyncFrame, bool& shouldSyncInput) override
+        {
+            shouldSyncFrame = true;
+            shouldSyncInput = true;
+        }
+
+        void syncFrameUpdate(uint64_t frameNo, bool& shouldRender, uint64_t& predictedDisplayTime,
+            uint64_t& predictedDisplayPeriod) override
+        {
+            const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch());
+            shouldRender = true;
+            predictedDisplayTime = static_cast<uint64_t>(now.count() + 2 * displayPeriod);
+            predictedDisplayPeriod = static_cast<uint64_t>(displayPeriod);
+        }
+
+        void syncFrameRender(VR::Frame& frame) override {}
+
+    private:
+        std::array<std::shared_ptr<VR::Space>, 3> mReferenceSpaces;
+        std::size_t mSubmittedLayers = 0;
+    };
+
+    //! Does roughly as much work per callback as the tracking and gui listeners in the game.
+    class StubListener : public VR::Session::Listener
+    {
+    public:
+        void onFrameUpdate(VR::Frame& frame) override { mLastFrame = frame.frameNumber; }
+        void onSpaceUpdate() override { mPose = mSpace.locateInWorld(); }
+        void onFrameRender(VR::Frame& frame) override { benchmark::DoNotOptimize(frame.layers.size()); }
+        void onFrameEnd(osg::RenderInfo& info, VR::Frame& frame) override { mLastFrame = frame.frameNumber; }
+
+    private:
+        StubSpace mSpace;
+        VR::TrackingPose mPose;
+        uint64_t mLastFrame = 0;
+    };
+
+    std::shared_ptr<StubSession> sSession;
+    std::unique_ptr<VR::Viewer> sViewer;
+
+    //! Drives one full frame per iteration through the real VR::Viewer update and draw callbacks and records the
+    //! cost of every phase. The final draw callback blits to the swapchains with GL, so the benchmark stops short of
+    //! it and does the session and swapchain work that would follow the blit itself.
+    void frameLoop(benchmark::State& state)
+    {
+        StubSession& session = *sSession;
+        VR::Session& base = session;
+        VR::Viewer& viewer = *sViewer;
+
+        std::vector<std::unique_ptr<StubListener>> listeners;
+        for (int64_t i = 0; i < state.range(0); ++i)
+            listeners.push_back(std::make_unique<StubListener>());
+
+        osg::RenderInfo renderInfo;
+        Stereo::View left;
+        Stereo::View right;
+
+        LatencyHistogram updateView("updateView");
+        LatencyHistogram updateSpaces("updateSpaces");
+        LatencyHistogram initialDraw("initialDraw");
+        LatencyHistogram frameEnd("frameEnd");
+        LatencyHistogram swapchain("swapchain");
+        LatencyHistogram submit("submit");
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            measure(updateView, [&] { viewer.updateView(left, right); });
+            VR::Frame frame = viewer.currentUpdateFrame();
+            measure(updateSpaces, [&] { base.updateSpaces(); });
+            measure(initialDraw, [&] { viewer.initialDrawCallback(renderInfo, Misc::CallbackManager::View::Left); });
+            measure(frameEnd, [&] { base.frameEnd(renderInfo, frame); });
+            measure(swapchain, [&] {
+                for (auto& layer : frame.layers)
+                {
+                    if (layer->getType() != VR::Layer::Type::ProjectionLayer)
+                        continue;
+                    for (auto& layerView : static_cast<VR::ProjectionLayer&>(*layer).views)
+                    {
+                        layerView.colorSwapchain->beginFrame(nullptr);
+                        benchmark::DoNotOptimize(layerView.colorSwapchain->image()->glImage());
+                        layerView.colorSwapchain->endFrame(nullptr);
+                    }
+                }
+            });
+            measure(submit, [&] { session.syncFrameEnd(frame); });
+        }
+
+        for (auto* histogram : { &updateView, &updateSpaces, &initialDraw, &frameEnd, &swapchain, &submit })
+            histogram->report(state);
+
+        state.counters["layers"] = benchmark::Counter(
+            static_cast<double>(session.submittedLayers()), benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //! Acquire/release cycles of a single swapchain, isolated from the rest of the frame.
+    void swapchainAcquireRelease(benchmark::State& state)
+    {
+        StubSwapchain swapchain(1832, 1920, 1, 1, VR::Swapchain::Attachment::Color, "Benchmark",
+            static_cast<std::size_t>(state.range(0)));
+
+        LatencyHistogram acquire("acquire");
+        LatencyHistogram release("release");
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            measure(acquire, [&] { swapchain.beginFrame(nullptr); });
+            benchmark::DoNotOptimize(swapchain.image());
+            measure(release, [&] { swapchain.endFrame(nullptr); });
+        }
+
+        acquire.report(state);
+        release.report(state);
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(frameLoop)->Arg(0)->Arg(8)->Arg(32);
+BENCHMARK(swapchainAcquireRelease)->Arg(2)->Arg(3);
+
+int main(int argc, char* argv[])
+{
+    const std::filesystem::path settingsDefaultPath = std::filesystem::path{ OPENMW_PROJECT_SOURCE_DIR } / "files"
+        / Misc::StringUtils::stringToU8String("settings-default.cfg");
+
+    Settings::SettingsFileParser parser;
+    parser.loadSettingsFile(settingsDefaultPath, Settings::Manager::mDefaultSettings);
+
+    Settings::StaticValues::initDefaults();
+    Settings::Manager::mUserSettings = Settings::Manager::mDefaultSettings;
+    Settings::StaticValues::init();
+
+    // Listeners only register themselves with the session in VR mode
+    VR::setVR(true);
+    sSession = std::make_shared<StubSession>();
+
+    // An embedded window stands in for the graphics context, nothing is ever realized or drawn with it
+    const auto config = sSession->getRecommendedSwapchainConfig();
+    osg::ref_ptr<osgViewer::Viewer> osgViewer = new osgViewer::Viewer;
+    osgViewer->setUpViewerAsEmbeddedInWindow(
+        0, 0, static_cast<int>(config[0].recommendedWidth), static_cast<int>(config[0].recommendedHeight));
+    Stereo::Manager stereoManager(osgViewer, true, 1.f, 7168.f, 1);
+    sViewer = std::make_unique<VR::Viewer>(sSession, osgViewer);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    sViewer.reset();
+    sSession.reset();
+
+    return 0;
+}
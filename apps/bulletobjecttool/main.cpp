@@ -9,20 +9,26 @@
 #include <components/fallback/validate.hpp>
 #include <components/files/collections.hpp>
 #include <components/files/configurationmanager.hpp>
+#include <components/files/conversion.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/misc/pathhelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/platform/platform.hpp>
 #include <components/resource/bgsmfilemanager.hpp>
 #include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapedb.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/foreachbulletobject.hpp>
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/niffilemanager.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/resource/transcodedimagecache.hpp>
 #include <components/settings/settings.hpp>
 #include <components/toutf8/toutf8.hpp>
 #include <components/version/version.hpp>
 #include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
 #include <components/vfs/registerarchives.hpp>
 
 #include <boost/program_options.hpp>
@@ -89,6 +95,13 @@ namespace
             bpo::value<Fallback::FallbackMap>()->default_value(Fallback::FallbackMap(), "")->multitoken()->composing(),
             "fallback values");
 
+        addOption("write-shape-db", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "build BVHs of all found collision shapes and store them in the shape disk cache used by the game");
+
+        addOption("write-transcoded-textures", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "transcode all found S3TC compressed DDS textures into ETC2 and store them in the texture cache used by "
+            "the game when the GPU doesn't support S3TC");
+
         Files::ConfigurationManager::addCommonOptions(result);
 
         return result;
@@ -178,6 +191,25 @@ namespace
         Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager, &bgsmFileManager, expiryDelay);
         Resource::BulletShapeManager bulletShapeManager(&vfs, &sceneManager, &nifFileManager, expiryDelay);
 
+        if (variables["write-shape-db"].as<bool>())
+        {
+            const std::string dbPath = Files::pathToUnicodeString(config.getUserDataPath() / "bulletshapes.db");
+            Log(Debug::Info) << "Using shape db at " << dbPath;
+            bulletShapeManager.setShapeDb(std::make_unique<Resource::BulletShapeDb>(dbPath), true);
+        }
+
+        if (variables["write-transcoded-textures"].as<bool>())
+        {
+            const std::filesystem::path cachePath = config.getCachePath() / "textures";
+            Log(Debug::Info) << "Using texture cache at " << Files::pathToUnicodeString(cachePath);
+            imageManager.setTranscodedImageCache(std::make_unique<Resource::TranscodedImageCache>(cachePath));
+            std::size_t transcoded = 0;
+            for (const VFS::Path::Normalized& path : vfs.getRecursiveDirectoryIterator())
+                if (Misc::getFileExtension(path.value()) == "dds" && imageManager.writeTranscodedImage(path))
+                    ++transcoded;
+            Log(Debug::Info) << "Transcoded " << transcoded << " textures";
+        }
+
         Resource::forEachBulletObject(
             readers, vfs, bulletShapeManager, esmData, [](const ESM::Cell& cell, const Resource::BulletObject& object) {
                 Log(Debug::Verbose) << "Found bullet object in " << (cell.isExterior() ? "exterior" : "interior")
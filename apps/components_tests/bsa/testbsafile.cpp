@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <vector>
@@ -284,6 +285,46 @@ namespace Bsa
                     }));
         }
 
+        TEST(BSAFileTest, getFileShouldReturnStreamWithFileContentValidAfterClose)
+        {
+            const std::filesystem::path path = makeOutputPath();
+
+            {
+                std::ofstream stream;
+                stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                stream.open(path, std::ios::binary);
+
+                const Header header{
+                    .mFormat = static_cast<std::uint32_t>(BsaVersion::Uncompressed),
+                    .mDirSize = 28,
+                    .mFileCount = 2,
+                };
+
+                const Archive archive{
+                    .mHeader = header,
+                    .mOffsets = { 3, 0, 5, 3, 0, 2 },
+                    .mStringBuffer = { 'a', '\0', 'b', '\0' },
+                    .mHashes = { BSAFile::Hash{ .mLow = 1, .mHigh = 2 }, BSAFile::Hash{ .mLow = 3, .mHigh = 4 } },
+                    .mTailSize = 0,
+                };
+
+                writeArchive(archive, stream);
+                stream << "foobarbaz";
+            }
+
+            BSAFile file;
+            file.open(path);
+
+            ASSERT_EQ(file.getList().size(), 2);
+            Files::IStreamPtr first = file.getFile(&file.getList()[0]);
+            Files::IStreamPtr second = file.getFile(&file.getList()[1]);
+            file.close();
+
+            EXPECT_EQ(std::string(std::istreambuf_iterator<char>(*first), {}), "foo");
+            EXPECT_EQ(std::string(std::istreambuf_iterator<char>(*second), {}), "barba");
+        }
+
         TEST(BSAFileTest, shouldHandleSomewhatLargeFiles)
         {
             constexpr std::uint32_t maxUInt32 = std::numeric_limits<uint32_t>::max();
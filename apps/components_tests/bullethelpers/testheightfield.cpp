@@ -0,0 +1,66 @@
+#include <components/bullethelpers/heightfield.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+namespace BulletHelpers
+{
+    namespace
+    {
+        // 3x3 vertices 10 units apart starting at (100, 200), height is 2 * column + 5 * row
+        constexpr std::array<float, 9> sPlaneHeights{ 0, 2, 4, 5, 7, 9, 10, 12, 14 };
+
+        HeightfieldGrid makePlaneGrid()
+        {
+            return HeightfieldGrid{ sPlaneHeights.data(), 3, 100, 200, 10 };
+        }
+
+        float getHeight(const HeightfieldGrid& grid, float x, float y)
+        {
+            float result = 0;
+            getHeightfieldHeights(grid, std::span(&x, 1), std::span(&y, 1), std::span(&result, 1));
+            return result;
+        }
+
+        TEST(BulletHelpersHeightfieldHeightsTest, shouldReturnVertexHeights)
+        {
+            const HeightfieldGrid grid = makePlaneGrid();
+            EXPECT_FLOAT_EQ(getHeight(grid, 100, 200), 0);
+            EXPECT_FLOAT_EQ(getHeight(grid, 110, 200), 2);
+            EXPECT_FLOAT_EQ(getHeight(grid, 100, 210), 5);
+            EXPECT_FLOAT_EQ(getHeight(grid, 120, 220), 14);
+        }
+
+        TEST(BulletHelpersHeightfieldHeightsTest, shouldInterpolatePlaneExactly)
+        {
+            const HeightfieldGrid grid = makePlaneGrid();
+            const std::vector<float> x{ 103, 117, 112, 104, 119 };
+            const std::vector<float> y{ 208, 201, 213, 219, 215 };
+            std::vector<float> result(x.size());
+            getHeightfieldHeights(grid, x, y, result);
+            for (std::size_t i = 0; i < x.size(); ++i)
+                EXPECT_NEAR(result[i], 0.2f * (x[i] - 100) + 0.5f * (y[i] - 200), 1e-4f) << i;
+        }
+
+        TEST(BulletHelpersHeightfieldHeightsTest, shouldClampToBorder)
+        {
+            const HeightfieldGrid grid = makePlaneGrid();
+            EXPECT_FLOAT_EQ(getHeight(grid, 50, 150), 0);
+            EXPECT_FLOAT_EQ(getHeight(grid, 500, 500), 14);
+        }
+
+        TEST(BulletHelpersHeightfieldHeightsTest, shouldFollowDiamondSubdivision)
+        {
+            // A single raised vertex in the middle, quad (0, 0) is split from (0, 0) to (1, 1) and quad (1, 0) from
+            // (1, 0) to (0, 1), so both diagonals through the middle vertex are triangle edges
+            const std::array<float, 9> heights{ 0, 0, 0, 0, 8, 0, 0, 0, 0 };
+            const HeightfieldGrid grid{ heights.data(), 3, 0, 0, 1 };
+            EXPECT_FLOAT_EQ(getHeight(grid, 0.5f, 0.5f), 4);
+            EXPECT_FLOAT_EQ(getHeight(grid, 1.5f, 0.5f), 4);
+            EXPECT_FLOAT_EQ(getHeight(grid, 0.75f, 0.25f), 2);
+            EXPECT_FLOAT_EQ(getHeight(grid, 1.25f, 0.25f), 2);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include <components/misc/workstealingranges.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    namespace
+    {
+        std::vector<int> takeAll(WorkStealingRanges& ranges, std::size_t worker, std::uint32_t jobCount)
+        {
+            std::vector<int> taken(jobCount, 0);
+            for (WorkStealingRanges::Batch batch = ranges.take(worker); !batch.empty(); batch = ranges.take(worker))
+                for (std::uint32_t job = batch.mBegin; job < batch.mEnd; ++job)
+                    ++taken[job];
+            return taken;
+        }
+
+        TEST(MiscWorkStealingRangesTest, takeShouldReturnEmptyBatchWithoutJobs)
+        {
+            WorkStealingRanges ranges(4);
+            EXPECT_TRUE(ranges.take(0).empty());
+            ranges.reset(0, 1);
+            EXPECT_TRUE(ranges.take(2).empty());
+        }
+
+        TEST(MiscWorkStealingRangesTest, takeShouldStartWithOwnRangeInBatches)
+        {
+            WorkStealingRanges ranges(2);
+            ranges.reset(8, 2);
+            const WorkStealingRanges::Batch first = ranges.take(1);
+            EXPECT_EQ(first.mBegin, 4u);
+            EXPECT_EQ(first.mEnd, 6u);
+            const WorkStealingRanges::Batch second = ranges.take(1);
+            EXPECT_EQ(second.mBegin, 6u);
+            EXPECT_EQ(second.mEnd, 8u);
+        }
+
+        TEST(MiscWorkStealingRangesTest, singleWorkerShouldStealAllJobsExactlyOnce)
+        {
+            WorkStealingRanges ranges(4);
+            ranges.reset(101, 3);
+            EXPECT_EQ(takeAll(ranges, 2, 101), std::vector<int>(101, 1));
+        }
+
+        TEST(MiscWorkStealingRangesTest, resetShouldRestoreAllJobs)
+        {
+            WorkStealingRanges ranges(3);
+            ranges.reset(10, 1);
+            takeAll(ranges, 0, 10);
+            ranges.reset(10, 1);
+            EXPECT_EQ(takeAll(ranges, 1, 10), std::vector<int>(10, 1));
+        }
+
+        TEST(MiscWorkStealingRangesTest, concurrentWorkersShouldTakeEachJobExactlyOnce)
+        {
+            constexpr std::size_t workerCount = 4;
+            constexpr std::uint32_t jobCount = 10000;
+            WorkStealingRanges ranges(workerCount);
+            ranges.reset(jobCount, 7);
+
+            std::vector<std::atomic<int>> taken(jobCount);
+            std::vector<std::thread> threads;
+            for (std::size_t worker = 0; worker < workerCount; ++worker)
+                threads.emplace_back([&, worker] {
+                    for (WorkStealingRanges::Batch batch = ranges.take(worker); !batch.empty();
+                         batch = ranges.take(worker))
+                        for (std::uint32_t job = batch.mBegin; job < batch.mEnd; ++job)
+                            taken[job].fetch_add(1, std::memory_order_relaxed);
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+
+            for (std::uint32_t job = 0; job < jobCount; ++job)
+                EXPECT_EQ(taken[job].load(), 1) << job;
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include <components/resource/bulletshape.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConcaveShape.h>
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace Resource
+{
+    namespace
+    {
+        std::unique_ptr<TriangleMeshShape> makeCube()
+        {
+            std::unique_ptr<btTriangleMesh> triangles(new btTriangleMesh(false));
+            const btVector3 v[] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 },
+                { 1, 1, 1 }, { 0, 1, 1 } };
+            const int faces[][4] = { { 0, 1, 2, 3 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 },
+                { 3, 0, 4, 7 } };
+            for (const auto& f : faces)
+            {
+                triangles->addTriangle(v[f[0]], v[f[1]], v[f[2]]);
+                triangles->addTriangle(v[f[0]], v[f[2]], v[f[3]]);
+            }
+            return std::make_unique<TriangleMeshShape>(triangles.release(), true);
+        }
+
+        CollisionShapePtr makeCompound()
+        {
+            std::unique_ptr<btCompoundShape, DeleteCollisionShape> compound(new btCompoundShape);
+            compound->addChildShape(btTransform(btQuaternion::getIdentity(), btVector3(10, 0, 0)),
+                new ScaledTriangleMeshShape(makeCube().release(), btVector3(2, 2, 2)));
+            compound->addChildShape(btTransform::getIdentity(), new btBoxShape(btVector3(1, 2, 3)));
+            return compound;
+        }
+
+        // Two walls of 100 by 200 units split into 2 unit squares with a 64 units wide doorway between them
+        std::unique_ptr<TriangleMeshShape> makeWallsWithDoorway()
+        {
+            std::unique_ptr<btTriangleMesh> triangles(new btTriangleMesh(false));
+            for (float start : { 0.f, 164.f })
+                for (float x = start; x < start + 100; x += 2)
+                    for (float z = 0; z < 200; z += 2)
+                    {
+                        triangles->addTriangle(btVector3(x, 0, z), btVector3(x + 2, 0, z), btVector3(x + 2, 0, z + 2));
+                        triangles->addTriangle(btVector3(x, 0, z), btVector3(x + 2, 0, z + 2), btVector3(x, 0, z + 2));
+                    }
+            return std::make_unique<TriangleMeshShape>(triangles.release(), true);
+        }
+
+        struct CountTriangles : btTriangleCallback
+        {
+            int mCount = 0;
+
+            void processTriangle(btVector3* /*triangle*/, int /*partId*/, int /*triangleIndex*/) override { ++mCount; }
+        };
+
+        int countTriangles(const btCollisionShape& shape, const btVector3& min, const btVector3& max)
+        {
+            CountTriangles count;
+            static_cast<const btConcaveShape&>(shape).processAllTriangles(&count, min, max);
+            return count.mCount;
+        }
+
+        TEST(ResourceBulletShapeTest, makeSimplifiedCollisionShapeShouldReplaceThinTriangleMeshByConvexHull)
+        {
+            const std::unique_ptr<TriangleMeshShape> cube = makeCube();
+            const CollisionShapePtr simplified = makeSimplifiedCollisionShape(*cube);
+            ASSERT_EQ(simplified->getShapeType(), CONVEX_HULL_SHAPE_PROXYTYPE);
+            EXPECT_EQ(static_cast<const btConvexHullShape&>(*simplified).getNumPoints(), 8);
+        }
+
+        TEST(ResourceBulletShapeTest, makeSimplifiedCollisionShapeShouldDecimateDetailedTriangleMeshKeepingOpenings)
+        {
+            const std::unique_ptr<TriangleMeshShape> walls = makeWallsWithDoorway();
+            const CollisionShapePtr simplified = makeSimplifiedCollisionShape(*walls);
+            ASSERT_NE(simplified, nullptr);
+            ASSERT_EQ(simplified->getShapeType(), TRIANGLE_MESH_SHAPE_PROXYTYPE);
+            const btVector3 infinity(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+            EXPECT_LT(
+                countTriangles(*simplified, -infinity, infinity), countTriangles(*walls, -infinity, infinity) / 4);
+            EXPECT_GT(countTriangles(*simplified, btVector3(40, -1, 90), btVector3(60, 1, 110)), 0);
+            EXPECT_EQ(countTriangles(*simplified, btVector3(101, -1, 0), btVector3(163, 1, 200)), 0);
+        }
+
+        TEST(ResourceBulletShapeTest, makeSimplifiedCollisionShapeShouldReturnNothingWithoutDetailToRemove)
+        {
+            const ScaledTriangleMeshShape cube(makeCube().release(), btVector3(100, 100, 100));
+            EXPECT_EQ(makeSimplifiedCollisionShape(cube), nullptr);
+            const btBoxShape box(btVector3(1, 2, 3));
+            EXPECT_EQ(makeSimplifiedCollisionShape(box), nullptr);
+        }
+
+        TEST(ResourceBulletShapeTest, makeSimplifiedCollisionShapeShouldKeepCompoundChildren)
+        {
+            const CollisionShapePtr compound = makeCompound();
+            const CollisionShapePtr simplified = makeSimplifiedCollisionShape(*compound);
+            ASSERT_TRUE(simplified->isCompound());
+            const auto& simplifiedCompound = static_cast<const btCompoundShape&>(*simplified);
+            ASSERT_EQ(simplifiedCompound.getNumChildShapes(), 2);
+            EXPECT_EQ(simplifiedCompound.getChildShape(0)->getShapeType(), CONVEX_HULL_SHAPE_PROXYTYPE);
+            EXPECT_EQ(simplifiedCompound.getChildShape(1)->getShapeType(), BOX_SHAPE_PROXYTYPE);
+            EXPECT_EQ(simplifiedCompound.getChildTransform(0).getOrigin(), btVector3(10, 0, 0));
+        }
+
+        TEST(ResourceBulletShapeTest, simplifiedCollisionShapeShouldHaveSameAabb)
+        {
+            const CollisionShapePtr compound = makeCompound();
+            const CollisionShapePtr simplified = makeSimplifiedCollisionShape(*compound);
+            btVector3 min;
+            btVector3 max;
+            compound->getAabb(btTransform::getIdentity(), min, max);
+            btVector3 simplifiedMin;
+            btVector3 simplifiedMax;
+            simplified->getAabb(btTransform::getIdentity(), simplifiedMin, simplifiedMax);
+            for (int i = 0; i < 3; ++i)
+            {
+                EXPECT_NEAR(simplifiedMin[i], min[i], 0.1f) << i;
+                EXPECT_NEAR(simplifiedMax[i], max[i], 0.1f) << i;
+            }
+        }
+
+        TEST(ResourceBulletShapeTest, instanceShouldScaleOwnSimplifiedCollisionShape)
+        {
+            osg::ref_ptr<BulletShape> shape(new BulletShape);
+            shape->mCollisionShape = makeCompound();
+            shape->mSimplifiedCollisionShape = makeSimplifiedCollisionShape(*shape->mCollisionShape);
+            const osg::ref_ptr<BulletShapeInstance> instance = makeInstance(shape);
+            ASSERT_NE(instance->mSimplifiedCollisionShape, nullptr);
+            EXPECT_NE(instance->mSimplifiedCollisionShape.get(), shape->mSimplifiedCollisionShape.get());
+
+            instance->setLocalScaling(btVector3(3, 3, 3));
+            EXPECT_EQ(instance->mSimplifiedCollisionShape->getLocalScaling(), btVector3(3, 3, 3));
+            EXPECT_EQ(shape->mSimplifiedCollisionShape->getLocalScaling(), btVector3(1, 1, 1));
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapedb.hpp>
+
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+namespace Resource
+{
+    namespace
+    {
+        osg::ref_ptr<BulletShape> makeShape(int numTriangles, bool buildBvh)
+        {
+            std::unique_ptr<btTriangleMesh> triangles(new btTriangleMesh(false));
+            for (int i = 0; i < numTriangles; ++i)
+                triangles->addTriangle(btVector3(i, 0, 0), btVector3(i + 1, 0, 0), btVector3(i, 1, 0));
+            auto mesh = std::make_unique<TriangleMeshShape>(triangles.release(), true, buildBvh);
+
+            std::unique_ptr<btCompoundShape, DeleteCollisionShape> compound(new btCompoundShape);
+            compound->addChildShape(
+                btTransform::getIdentity(), new ScaledTriangleMeshShape(mesh.release(), btVector3(1, 1, 1)));
+
+            osg::ref_ptr<BulletShape> shape(new BulletShape);
+            shape->mCollisionShape = std::move(compound);
+            return shape;
+        }
+
+        btBvhTriangleMeshShape& getMesh(BulletShape& shape)
+        {
+            auto& compound = static_cast<btCompoundShape&>(*shape.mCollisionShape);
+            return *static_cast<btScaledBvhTriangleMeshShape*>(compound.getChildShape(0))->getChildShape();
+        }
+
+        Sqlite3::ConstBlob makeBlob(const std::string& value)
+        {
+            return Sqlite3::ConstBlob{ value.data(), static_cast<int>(value.size()) };
+        }
+
+        TEST(ResourceBulletShapeDbTest, deserializeBvhsShouldRestoreSerializedBvhs)
+        {
+            const osg::ref_ptr<BulletShape> source = makeShape(10, true);
+            const std::vector<std::byte> data = serializeBvhs(*source);
+            ASSERT_FALSE(data.empty());
+
+            const osg::ref_ptr<BulletShape> shape = makeShape(10, false);
+            ASSERT_EQ(getMesh(*shape).getOptimizedBvh(), nullptr);
+            ASSERT_TRUE(deserializeBvhs(*shape, data));
+            ASSERT_NE(getMesh(*shape).getOptimizedBvh(), nullptr);
+            EXPECT_EQ(getMesh(*shape).getOptimizedBvh()->getQuantizedNodeArray().size(),
+                getMesh(*source).getOptimizedBvh()->getQuantizedNodeArray().size());
+        }
+
+        TEST(ResourceBulletShapeDbTest, deserializeBvhsShouldRejectOtherMesh)
+        {
+            const std::vector<std::byte> data = serializeBvhs(*makeShape(10, true));
+            const osg::ref_ptr<BulletShape> shape = makeShape(11, false);
+            EXPECT_FALSE(deserializeBvhs(*shape, data));
+            buildMissingBvhs(*shape);
+            EXPECT_NE(getMesh(*shape).getOptimizedBvh(), nullptr);
+        }
+
+        TEST(ResourceBulletShapeDbTest, serializeBvhsShouldReturnEmptyDataForShapeWithoutTriangleMeshes)
+        {
+            EXPECT_TRUE(serializeBvhs(BulletShape()).empty());
+        }
+
+        TEST(ResourceBulletShapeDbTest, getShapeDataShouldReturnInsertedDataForSameHash)
+        {
+            BulletShapeDb db(":memory:");
+            const std::string hash = "hash";
+            const std::vector<std::byte> data = serializeBvhs(*makeShape(3, true));
+            EXPECT_EQ(db.insertShape("meshes/a.nif", makeBlob(hash), data), 1);
+            EXPECT_EQ(db.getShapeData("meshes/a.nif", makeBlob(hash)), data);
+            EXPECT_EQ(db.getShapeData("meshes/a.nif", makeBlob("other hash")), std::nullopt);
+            EXPECT_EQ(db.getShapeData("meshes/b.nif", makeBlob(hash)), std::nullopt);
+        }
+
+        TEST(ResourceBulletShapeDbTest, insertShapeShouldReplaceDataForSameName)
+        {
+            BulletShapeDb db(":memory:");
+            const std::vector<std::byte> data = serializeBvhs(*makeShape(3, true));
+            db.insertShape("meshes/a.nif", makeBlob("old"), data);
+            db.insertShape("meshes/a.nif", makeBlob("new"), data);
+            EXPECT_EQ(db.getShapeData("meshes/a.nif", makeBlob("old")), std::nullopt);
+            EXPECT_EQ(db.getShapeData("meshes/a.nif", makeBlob("new")), data);
+        }
+    }
+}
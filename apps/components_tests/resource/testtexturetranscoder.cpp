@@ -0,0 +1,289 @@
+#include <components/resource/texturetranscoder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace Resource
+{
+    namespace
+    {
+        using Color = std::array<int, 4>;
+
+        // Pixel (x, y) is at y * 4 + x
+        using Pixels = std::array<Color, 16>;
+
+        constexpr int etcModifiers[8][2] = {
+            { 2, 8 },
+            { 5, 17 },
+            { 9, 29 },
+            { 13, 42 },
+            { 18, 60 },
+            { 24, 80 },
+            { 33, 106 },
+            { 47, 183 },
+        };
+
+        constexpr int eacModifiers[16][8] = {
+            { -3, -6, -9, -15, 2, 5, 8, 14 },
+            { -3, -7, -10, -13, 2, 6, 9, 12 },
+            { -2, -5, -8, -13, 1, 4, 7, 12 },
+            { -2, -4, -6, -13, 1, 3, 5, 12 },
+            { -3, -6, -8, -12, 2, 5, 7, 11 },
+            { -3, -7, -9, -11, 2, 6, 8, 10 },
+            { -4, -7, -8, -11, 3, 6, 7, 10 },
+            { -3, -5, -8, -11, 2, 4, 7, 10 },
+            { -2, -6, -8, -10, 1, 5, 7, 9 },
+            { -2, -5, -8, -10, 1, 4, 7, 9 },
+            { -2, -4, -8, -10, 1, 3, 7, 9 },
+            { -2, -5, -7, -10, 1, 4, 6, 9 },
+            { -3, -4, -7, -10, 2, 3, 6, 9 },
+            { -1, -2, -3, -10, 0, 1, 2, 9 },
+            { -4, -6, -8, -9, 3, 5, 7, 8 },
+            { -3, -5, -7, -9, 2, 4, 6, 8 },
+        };
+
+        std::uint64_t readBigEndian(const std::byte* data)
+        {
+            std::uint64_t result = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+                result = (result << 8) | std::to_integer<std::uint64_t>(data[i]);
+            return result;
+        }
+
+        int getBits(std::uint64_t value, int shift, int count)
+        {
+            return static_cast<int>((value >> shift) & ((1u << count) - 1));
+        }
+
+        // Decoder of the individual and differential modes as described by the OpenGL ES 3.0 specification
+        void decodeEtc(const std::byte* data, Pixels& pixels)
+        {
+            const std::uint64_t bits = readBigEndian(data);
+            const bool differential = getBits(bits, 33, 1) != 0;
+            const bool flip = getBits(bits, 32, 1) != 0;
+            std::array<Color, 2> bases;
+            for (int c = 0; c < 3; ++c)
+            {
+                const int shift = 56 - c * 8;
+                if (differential)
+                {
+                    const int first = getBits(bits, shift + 3, 5);
+                    const int delta = (getBits(bits, shift, 3) ^ 4) - 4;
+                    const int second = first + delta;
+                    ASSERT_GE(second, 0);
+                    ASSERT_LE(second, 31);
+                    bases[0][c] = (first << 3) | (first >> 2);
+                    bases[1][c] = (second << 3) | (second >> 2);
+                }
+                else
+                {
+                    bases[0][c] = getBits(bits, shift + 4, 4) * 17;
+                    bases[1][c] = getBits(bits, shift, 4) * 17;
+                }
+            }
+            const std::array<int, 2> tables = { getBits(bits, 37, 3), getBits(bits, 34, 3) };
+            for (int x = 0; x < 4; ++x)
+            {
+                for (int y = 0; y < 4; ++y)
+                {
+                    const int subblock = flip ? y / 2 : x / 2;
+                    const int position = x * 4 + y;
+                    const int msb = getBits(bits, 16 + position, 1);
+                    const int lsb = getBits(bits, position, 1);
+                    const int value = etcModifiers[tables[subblock]][lsb];
+                    const int modifier = msb != 0 ? -value : value;
+                    Color& color = pixels[y * 4 + x];
+                    for (int c = 0; c < 3; ++c)
+                        color[c] = std::clamp(bases[subblock][c] + modifier, 0, 255);
+                }
+            }
+        }
+
+        void decodeEac(const std::byte* data, Pixels& pixels)
+        {
+            const std::uint64_t bits = readBigEndian(data);
+            const int base = getBits(bits, 56, 8);
+            const int multiplier = getBits(bits, 52, 4);
+            const int table = getBits(bits, 48, 4);
+            for (int x = 0; x < 4; ++x)
+                for (int y = 0; y < 4; ++y)
+                {
+                    const int index = getBits(bits, 45 - 3 * (x * 4 + y), 3);
+                    pixels[y * 4 + x][3] = std::clamp(base + eacModifiers[table][index] * multiplier, 0, 255);
+                }
+        }
+
+        void appendUInt(std::uint32_t value, std::size_t size, std::vector<std::byte>& data)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                data.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xff));
+        }
+
+        std::uint32_t to565(int r, int g, int b)
+        {
+            return static_cast<std::uint32_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+        }
+
+        void appendColorBlock(
+            std::uint32_t color0, std::uint32_t color1, std::uint32_t indices, std::vector<std::byte>& data)
+        {
+            appendUInt(color0, 2, data);
+            appendUInt(color1, 2, data);
+            appendUInt(indices, 4, data);
+        }
+
+        int getMaxDifference(const Pixels& pixels, const Color& expected, int channels)
+        {
+            int result = 0;
+            for (const Color& color : pixels)
+                for (int c = 0; c < channels; ++c)
+                    result = std::max(result, std::abs(color[c] - expected[c]));
+            return result;
+        }
+
+        TEST(ResourceTextureTranscoderTest, shouldProduceBlockPerFourByFourPixelsIncludingPartialBlocks)
+        {
+            std::vector<std::byte> source;
+            for (int i = 0; i < 4; ++i)
+                appendColorBlock(to565(255, 0, 0), to565(255, 0, 0), 0, source);
+
+            std::vector<std::byte> rgb;
+            transcodeS3TCToEtc2(S3TCFormat::Dxt1Rgb, source.data(), 5, 7, rgb);
+            EXPECT_EQ(rgb.size(), 4 * getBlockSize(Etc2Format::Rgb8));
+
+            std::vector<std::byte> rgba;
+            transcodeS3TCToEtc2(S3TCFormat::Dxt1Rgba, source.data(), 8, 8, rgba);
+            EXPECT_EQ(rgba.size(), 4 * getBlockSize(Etc2Format::Rgba8Eac));
+        }
+
+        TEST(ResourceTextureTranscoderTest, shouldKeepSolidColor)
+        {
+            for (const Color& color : { Color{ 255, 0, 0, 255 }, Color{ 8, 128, 200, 255 }, Color{ 0, 0, 0, 255 },
+                     Color{ 255, 255, 255, 255 } })
+            {
+                std::vector<std::byte> source;
+                const std::uint32_t value = to565(color[0], color[1], color[2]);
+                appendColorBlock(value, value, 0, source);
+
+                std::vector<std::byte> result;
+                transcodeS3TCToEtc2(S3TCFormat::Dxt1Rgb, source.data(), 4, 4, result);
+                ASSERT_EQ(result.size(), 8);
+
+                Pixels pixels;
+                decodeEtc(result.data(), pixels);
+                EXPECT_LE(getMaxDifference(pixels, color, 3), 8);
+            }
+        }
+
+        TEST(ResourceTextureTranscoderTest, shouldKeepDifferentColorsOfBlockHalves)
+        {
+            // Left half uses the first color, right half the second one
+            std::uint32_t indices = 0;
+            for (int y = 0; y < 4; ++y)
+                for (int x = 2; x < 4; ++x)
+                    indices |= 1u << (2 * (y * 4 + x));
+            std::vector<std::byte> source;
+            appendColorBlock(to565(255, 255, 255), to565(0, 0, 0), indices, source);
+
+            std::vector<std::byte> result;
+            transcodeS3TCToEtc2(S3TCFormat::Dxt1Rgb, source.data(), 4, 4, result);
+            Pixels pixels;
+            decodeEtc(result.data(), pixels);
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                {
+                    const int expected = x < 2 ? 255 : 0;
+                    for (int c = 0; c < 3; ++c)
+                        EXPECT_NEAR(pixels[y * 4 + x][c], expected, 8) << x << " " << y << " " << c;
+                }
+        }
+
+        TEST(ResourceTextureTranscoderTest, shouldKeepTransparentPixelsOfDxt1)
+        {
+            // Color 3 is transparent when the first color is not greater than the second one
+            std::vector<std::byte> source;
+            appendColorBlock(to565(0, 0, 255), to565(0, 255, 0), 0xffff0000, source);
+
+            std::vector<std::byte> result;
+            transcodeS3TCToEtc2(S3TCFormat::Dxt1Rgba, source.data(), 4, 4, result);
+            ASSERT_EQ(result.size(), 16);
+            Pixels pixels;
+            decodeEac(result.data(), pixels);
+            for (int i = 0; i < 16; ++i)
+                EXPECT_EQ(pixels[i][3], i < 8 ? 255 : 0) << i;
+        }
+
+        TEST(ResourceTextureTranscoderTest, shouldKeepInterpolatedAlphaOfDxt5)
+        {
+            // Alpha palette is 255, 0 and 6 values in between, each pixel uses its index modulo 8
+            std::vector<std::byte> source;
+            source.push_back(std::byte{ 255 });
+            source.push_back(std::byte{ 0 });
+            std::uint64_t alphaIndices = 0;
+            for (int i = 0; i < 16; ++i)
+                alphaIndices |= static_cast<std::uint64_t>(i % 8) << (3 * i);
+            appendUInt(static_cast<std::uint32_t>(alphaIndices & 0xffffff), 3, source);
+            appendUInt(static_cast<std::uint32_t>(alphaIndices >> 24), 3, source);
+            appendColorBlock(to565(255, 255, 255), to565(255, 255, 255), 0, source);
+
+            std::vector<std::byte> result;
+            transcodeS3TCToEtc2(S3TCFormat::Dxt5, source.data(), 4, 4, result);
+            ASSERT_EQ(result.size(), 16);
+            Pixels pixels;
+            decodeEac(result.data(), pixels);
+            decodeEtc(result.data() + 8, pixels);
+            constexpr std::array<int, 8> palette = { 255, 0, 218, 182, 145, 109, 72, 36 };
+            for (int i = 0; i < 16; ++i)
+                EXPECT_NEAR(pixels[i][3], palette[i % 8], 20) << i;
+            EXPECT_LE(getMaxDifference(pixels, Color{ 255, 255, 255, 255 }, 3), 8);
+        }
+
+        TEST(ResourceTextureTranscoderTest, shouldKeepExplicitAlphaOfDxt3)
+        {
+            std::vector<std::byte> source;
+            for (int i = 0; i < 8; ++i)
+                source.push_back(std::byte{ 0xf0 });
+            appendColorBlock(to565(0, 0, 0), to565(0, 0, 0), 0, source);
+
+            std::vector<std::byte> result;
+            transcodeS3TCToEtc2(S3TCFormat::Dxt3, source.data(), 4, 4, result);
+            Pixels pixels;
+            decodeEac(result.data(), pixels);
+            for (int i = 0; i < 16; ++i)
+                EXPECT_EQ(pixels[i][3], i % 2 == 0 ? 0 : 255) << i;
+        }
+
+        TEST(ResourceTextureTranscoderTest, decompressShouldProduceRgba8PixelsIncludingPartialBlocks)
+        {
+            const std::array<Color, 4> colors = {
+                Color{ 255, 0, 0, 255 },
+                Color{ 0, 255, 0, 255 },
+                Color{ 0, 0, 255, 255 },
+                Color{ 255, 255, 255, 255 },
+            };
+            std::vector<std::byte> source;
+            for (const Color& color : colors)
+            {
+                const std::uint32_t value = to565(color[0], color[1], color[2]);
+                appendColorBlock(value, value, 0, source);
+            }
+
+            std::vector<std::byte> result;
+            decompressS3TC(S3TCFormat::Dxt1Rgb, source.data(), 5, 5, result);
+            ASSERT_EQ(result.size(), 5 * 5 * 4);
+            for (int y = 0; y < 5; ++y)
+                for (int x = 0; x < 5; ++x)
+                {
+                    const Color& expected = colors[(y / 4) * 2 + x / 4];
+                    for (int c = 0; c < 4; ++c)
+                        EXPECT_EQ(std::to_integer<int>(result[(y * 5 + x) * 4 + c]), expected[c])
+                            << x << " " << y << " " << c;
+                }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include <components/resource/transcodedimagecache.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct ResourceTranscodedImageCacheTest : Test
+        {
+            const std::filesystem::path mDirectory = TestingOpenMW::currentTestDirPath() / "textures";
+            const VFS::Path::Normalized mPath{ "textures/tx_a.dds" };
+            TranscodedImage mImage{
+                .mPixelFormat = 0x9274,
+                .mWidth = 8,
+                .mHeight = 4,
+                .mMipmapOffsets = { 16, 24 },
+                .mData = std::vector<std::byte>(32, std::byte{ 42 }),
+            };
+
+            ResourceTranscodedImageCacheTest() { std::filesystem::remove_all(mDirectory); }
+        };
+
+        void expectEqual(const TranscodedImage& actual, const TranscodedImage& expected)
+        {
+            EXPECT_EQ(actual.mPixelFormat, expected.mPixelFormat);
+            EXPECT_EQ(actual.mWidth, expected.mWidth);
+            EXPECT_EQ(actual.mHeight, expected.mHeight);
+            EXPECT_EQ(actual.mMipmapOffsets, expected.mMipmapOffsets);
+            EXPECT_EQ(actual.mData, expected.mData);
+        }
+
+        TEST_F(ResourceTranscodedImageCacheTest, getShouldReturnNothingForMissingImage)
+        {
+            const TranscodedImageCache cache(mDirectory);
+            EXPECT_EQ(cache.get(mPath, 1), std::nullopt);
+        }
+
+        TEST_F(ResourceTranscodedImageCacheTest, getShouldReturnPutImage)
+        {
+            const TranscodedImageCache cache(mDirectory);
+            cache.put(mPath, 1, mImage);
+            const std::optional<TranscodedImage> result = cache.get(mPath, 1);
+            ASSERT_TRUE(result.has_value());
+            expectEqual(*result, mImage);
+        }
+
+        TEST_F(ResourceTranscodedImageCacheTest, getShouldReturnNothingForOtherModificationTime)
+        {
+            const TranscodedImageCache cache(mDirectory);
+            cache.put(mPath, 1, mImage);
+            EXPECT_EQ(cache.get(mPath, 2), std::nullopt);
+        }
+
+        TEST_F(ResourceTranscodedImageCacheTest, putShouldReplaceImage)
+        {
+            const TranscodedImageCache cache(mDirectory);
+            cache.put(mPath, 1, mImage);
+            mImage.mData.resize(8);
+            cache.put(mPath, 2, mImage);
+            const std::optional<TranscodedImage> result = cache.get(mPath, 2);
+            ASSERT_TRUE(result.has_value());
+            expectEqual(*result, mImage);
+        }
+
+        TEST_F(ResourceTranscodedImageCacheTest, getShouldReturnNothingForInvalidFile)
+        {
+            std::filesystem::create_directories(mDirectory / "textures");
+            std::ofstream(mDirectory / "textures" / "tx_a.dds.etc2") << "garbage";
+            const TranscodedImageCache cache(mDirectory);
+            EXPECT_EQ(cache.get(mPath, 1), std::nullopt);
+        }
+    }
+}
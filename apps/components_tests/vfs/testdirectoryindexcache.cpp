@@ -0,0 +1,109 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/directoryindexcache.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct VFSDirectoryIndexCacheTest : Test
+        {
+            const std::filesystem::path mDir = TestingOpenMW::currentTestDirPath();
+            const std::filesystem::path mData = mDir / "data";
+            const std::filesystem::path mSnapshot = mDir / "vfsindex.bin";
+
+            VFSDirectoryIndexCacheTest()
+            {
+                std::filesystem::create_directories(mData / "meshes" / "x");
+                std::ofstream(mData / "meshes" / "a.nif");
+                std::ofstream(mData / "meshes" / "x" / "b.nif");
+                std::ofstream(mData / "c.esp");
+            }
+
+            // Don't rely on the file system updating modification time fast enough
+            void touch(const std::filesystem::path& directory)
+            {
+                std::filesystem::last_write_time(
+                    directory, std::filesystem::last_write_time(directory) + std::chrono::seconds(1));
+            }
+
+            static std::vector<std::string> listResources(FileSystemArchive& archive)
+            {
+                FileMap files;
+                archive.listResources(files);
+                std::vector<std::string> result;
+                for (const auto& [path, file] : files)
+                    result.push_back(path.value());
+                return result;
+            }
+        };
+
+        TEST_F(VFSDirectoryIndexCacheTest, listShouldReturnFilesAndDirectories)
+        {
+            DirectoryIndexCache cache(mSnapshot);
+            const DirectoryListing& listing = cache.list(mData / "meshes");
+            EXPECT_THAT(listing.mFiles, ElementsAre("a.nif"));
+            EXPECT_THAT(listing.mDirectories, ElementsAre("x"));
+            EXPECT_EQ(cache.getListedCount(), 1);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, listShouldUseSavedSnapshotForUnchangedDirectories)
+        {
+            {
+                DirectoryIndexCache cache(mSnapshot);
+                cache.list(mData);
+                cache.list(mData / "meshes");
+                cache.save();
+            }
+
+            DirectoryIndexCache cache(mSnapshot);
+            EXPECT_THAT(cache.list(mData).mFiles, ElementsAre("c.esp"));
+            EXPECT_THAT(cache.list(mData / "meshes").mFiles, ElementsAre("a.nif"));
+            EXPECT_EQ(cache.getListedCount(), 0);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, listShouldListChangedDirectoryAgain)
+        {
+            {
+                DirectoryIndexCache cache(mSnapshot);
+                cache.list(mData);
+                cache.list(mData / "meshes");
+                cache.save();
+            }
+
+            std::ofstream(mData / "meshes" / "d.nif");
+            touch(mData / "meshes");
+
+            DirectoryIndexCache cache(mSnapshot);
+            cache.list(mData);
+            EXPECT_THAT(cache.list(mData / "meshes").mFiles, UnorderedElementsAre("a.nif", "d.nif"));
+            EXPECT_EQ(cache.getListedCount(), 1);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, shouldIgnoreInvalidSnapshot)
+        {
+            std::ofstream(mSnapshot) << "garbage";
+            DirectoryIndexCache cache(mSnapshot);
+            EXPECT_THAT(cache.list(mData).mFiles, ElementsAre("c.esp"));
+            EXPECT_EQ(cache.getListedCount(), 1);
+        }
+
+        TEST_F(VFSDirectoryIndexCacheTest, fileSystemArchiveShouldListSameFilesWithCache)
+        {
+            FileSystemArchive withoutCache(mData);
+            DirectoryIndexCache cache(mSnapshot);
+            FileSystemArchive withCache(mData, &cache);
+            EXPECT_THAT(listResources(withCache), ElementsAre("c.esp", "meshes/a.nif", "meshes/x/b.nif"));
+            EXPECT_EQ(listResources(withCache), listResources(withoutCache));
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#include <components/vfs/fileindex.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <format>
+
+namespace VFS
+{
+    namespace
+    {
+        File* makeFile(std::size_t value)
+        {
+            return reinterpret_cast<File*>(value);
+        }
+
+        TEST(VFSFileIndexTest, findInEmptyIndexShouldReturnNullptr)
+        {
+            FileIndex index;
+            EXPECT_EQ(index.find("meshes/a.nif"), nullptr);
+            EXPECT_FALSE(index.contains("meshes/a.nif"));
+        }
+
+        TEST(VFSFileIndexTest, findShouldReturnFileForEachPath)
+        {
+            FileMap files;
+            for (std::size_t i = 1; i <= 1000; ++i)
+                files.emplace(Path::Normalized(std::format("textures/{}.dds", i)), makeFile(i));
+
+            FileIndex index;
+            index.build(files);
+
+            EXPECT_EQ(index.size(), files.size());
+            for (const auto& [path, file] : files)
+                EXPECT_EQ(index.find(path.view()), file) << path;
+            EXPECT_EQ(index.find("textures/0.dds"), nullptr);
+            EXPECT_EQ(index.find("textures/1001.dds"), nullptr);
+        }
+
+        TEST(VFSFileIndexTest, containsShouldReturnTrueForPathWithNullFile)
+        {
+            FileMap files;
+            files.emplace(Path::Normalized("meshes/a.nif"), nullptr);
+
+            FileIndex index;
+            index.build(files);
+
+            EXPECT_TRUE(index.contains("meshes/a.nif"));
+            EXPECT_EQ(index.find("meshes/a.nif"), nullptr);
+        }
+
+        TEST(VFSFileIndexTest, clearShouldRemoveAllFiles)
+        {
+            FileMap files;
+            files.emplace(Path::Normalized("meshes/a.nif"), makeFile(1));
+
+            FileIndex index;
+            index.build(files);
+            index.clear();
+
+            EXPECT_EQ(index.size(), 0);
+            EXPECT_FALSE(index.contains("meshes/a.nif"));
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include <components/vr/dynamicresolution.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace VR;
+
+    constexpr double displayPeriod = 1.0 / 90.0;
+
+    DynamicResolution::Config makeConfig()
+    {
+        DynamicResolution::Config config;
+        config.mMinScale = 0.5f;
+        config.mMaxScale = 1.f;
+        config.mStep = 0.1f;
+        config.mTargetBudget = 0.9f;
+        config.mHeadroomBudget = 0.7f;
+        config.mFramesToScaleDown = 3;
+        config.mFramesToScaleUp = 10;
+        config.mCooldownFrames = 2;
+        return config;
+    }
+
+    TEST(VRDynamicResolutionTest, should_start_at_max_scale)
+    {
+        DynamicResolution resolution(makeConfig());
+        EXPECT_FLOAT_EQ(resolution.getScale(), 1.f);
+    }
+
+    TEST(VRDynamicResolutionTest, should_scale_down_after_consecutive_frames_over_budget)
+    {
+        DynamicResolution resolution(makeConfig());
+        EXPECT_FALSE(resolution.update(displayPeriod, displayPeriod));
+        EXPECT_FALSE(resolution.update(displayPeriod, displayPeriod));
+        EXPECT_TRUE(resolution.update(displayPeriod, displayPeriod));
+        EXPECT_FLOAT_EQ(resolution.getScale(), 0.9f);
+    }
+
+    TEST(VRDynamicResolutionTest, should_not_scale_down_on_isolated_spikes)
+    {
+        DynamicResolution resolution(makeConfig());
+        for (int i = 0; i < 10; ++i)
+        {
+            EXPECT_FALSE(resolution.update(displayPeriod, displayPeriod));
+            EXPECT_FALSE(resolution.update(displayPeriod * 0.8, displayPeriod));
+        }
+        EXPECT_FLOAT_EQ(resolution.getScale(), 1.f);
+    }
+
+    TEST(VRDynamicResolutionTest, should_ignore_frames_during_cooldown)
+    {
+        DynamicResolution resolution(makeConfig());
+        for (int i = 0; i < 3; ++i)
+            resolution.update(displayPeriod, displayPeriod);
+        EXPECT_FLOAT_EQ(resolution.getScale(), 0.9f);
+        for (int i = 0; i < 4; ++i)
+            EXPECT_FALSE(resolution.update(displayPeriod, displayPeriod));
+        EXPECT_TRUE(resolution.update(displayPeriod, displayPeriod));
+        EXPECT_FLOAT_EQ(resolution.getScale(), 0.8f);
+    }
+
+    TEST(VRDynamicResolutionTest, should_not_go_below_min_scale)
+    {
+        DynamicResolution resolution(makeConfig());
+        for (int i = 0; i < 100; ++i)
+            resolution.update(displayPeriod * 2, displayPeriod);
+        EXPECT_FLOAT_EQ(resolution.getScale(), 0.5f);
+    }
+
+    TEST(VRDynamicResolutionTest, should_scale_up_only_with_headroom)
+    {
+        DynamicResolution resolution(makeConfig());
+        for (int i = 0; i < 3; ++i)
+            resolution.update(displayPeriod, displayPeriod);
+        EXPECT_FLOAT_EQ(resolution.getScale(), 0.9f);
+
+        // Within budget but without headroom holds the current scale
+        for (int i = 0; i < 50; ++i)
+            EXPECT_FALSE(resolution.update(displayPeriod * 0.8, displayPeriod));
+
+        for (int i = 0; i < 9; ++i)
+            EXPECT_FALSE(resolution.update(displayPeriod * 0.5, displayPeriod));
+        EXPECT_TRUE(resolution.update(displayPeriod * 0.5, displayPeriod));
+        EXPECT_FLOAT_EQ(resolution.getScale(), 1.f);
+    }
+
+    TEST(VRDynamicResolutionTest, should_ignore_unknown_display_period)
+    {
+        DynamicResolution resolution(makeConfig());
+        for (int i = 0; i < 10; ++i)
+            EXPECT_FALSE(resolution.update(displayPeriod, 0));
+        EXPECT_FLOAT_EQ(resolution.getScale(), 1.f);
+    }
+}
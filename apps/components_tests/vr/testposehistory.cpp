@@ -0,0 +1,165 @@
+#include <components/vr/posehistory.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace VR;
+
+    constexpr DisplayTime millisecond = 1000000;
+
+    TrackingPose makePose(DisplayTime time, const osg::Vec3f& positionMeters, const osg::Quat& orientation = {})
+    {
+        TrackingPose pose;
+        pose.status = TrackingStatus::Good;
+        pose.time = time;
+        pose.pose.position = Stereo::Position::fromMeters(positionMeters);
+        pose.pose.orientation = orientation;
+        return pose;
+    }
+
+    void expectNear(const osg::Vec3f& actual, const osg::Vec3f& expected)
+    {
+        EXPECT_NEAR(actual.x(), expected.x(), 1e-3f);
+        EXPECT_NEAR(actual.y(), expected.y(), 1e-3f);
+        EXPECT_NEAR(actual.z(), expected.z(), 1e-3f);
+    }
+
+    TEST(VRPoseHistoryTest, locate_on_empty_history_should_return_unknown_status)
+    {
+        PoseHistory history;
+        EXPECT_EQ(history.locate(10 * millisecond).status, TrackingStatus::Unknown);
+    }
+
+    TEST(VRPoseHistoryTest, should_ignore_untracked_and_out_of_order_poses)
+    {
+        PoseHistory history;
+        history.push(makePose(10 * millisecond, { 1, 0, 0 }));
+        TrackingPose lost = makePose(20 * millisecond, { 0, 0, 0 });
+        lost.status = TrackingStatus::Lost;
+        history.push(lost);
+        history.push(makePose(5 * millisecond, { 2, 0, 0 }));
+        EXPECT_EQ(history.size(), 1u);
+        EXPECT_EQ(history.latest().time, 10 * millisecond);
+    }
+
+    TEST(VRPoseHistoryTest, should_replace_pose_with_same_time)
+    {
+        PoseHistory history;
+        history.push(makePose(10 * millisecond, { 1, 0, 0 }));
+        history.push(makePose(10 * millisecond, { 2, 0, 0 }));
+        EXPECT_EQ(history.size(), 1u);
+        expectNear(history.latest().pose.position.asMeters(), { 2, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_keep_at_most_capacity_poses)
+    {
+        PoseHistory::Config config;
+        config.mCapacity = 4;
+        PoseHistory history(config);
+        for (int i = 0; i < 10; ++i)
+            history.push(makePose(i * millisecond, { static_cast<float>(i), 0, 0 }));
+        EXPECT_EQ(history.size(), 4u);
+        EXPECT_EQ(history.locate(0).status, TrackingStatus::Stale);
+        expectNear(history.locate(0).pose.position.asMeters(), { 6, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_interpolate_between_poses)
+    {
+        PoseHistory history;
+        history.push(makePose(10 * millisecond, { 0, 0, 0 }, osg::Quat()));
+        history.push(makePose(20 * millisecond, { 1, 0, 0 }, osg::Quat(osg::PI_2, osg::Z_AXIS)));
+        const TrackingPose pose = history.locate(15 * millisecond);
+        EXPECT_EQ(pose.status, TrackingStatus::Good);
+        expectNear(pose.pose.position.asMeters(), { 0.5f, 0, 0 });
+        double angle = 0;
+        osg::Vec3d axis;
+        pose.pose.orientation.getRotate(angle, axis);
+        EXPECT_NEAR(angle, osg::PI_4, 1e-4);
+    }
+
+    TEST(VRPoseHistoryTest, should_estimate_constant_velocity)
+    {
+        PoseHistory history;
+        for (int i = 0; i < 5; ++i)
+            history.push(makePose(i * 10 * millisecond, { i * 0.01f, 0, 0 }));
+        expectNear(history.linearVelocity(), { 1, 0, 0 });
+        expectNear(history.linearAcceleration(), { 0, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_estimate_constant_acceleration)
+    {
+        PoseHistory history;
+        for (int i = 0; i < 5; ++i)
+        {
+            const float t = i * 0.01f;
+            history.push(makePose(i * 10 * millisecond, { 0.5f * 4.f * t * t, 0, 0 }));
+        }
+        expectNear(history.linearAcceleration(), { 4, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_average_out_jitter_in_velocity)
+    {
+        PoseHistory history;
+        for (int i = 0; i < 5; ++i)
+        {
+            const float jitter = i % 2 == 0 ? 0.001f : -0.001f;
+            history.push(makePose(i * 10 * millisecond, { i * 0.01f + jitter, 0, 0 }));
+        }
+        // Differencing the last two samples gives 0.8 m/s
+        EXPECT_NEAR(history.linearVelocity().x(), 1.f, 0.05f);
+    }
+
+    TEST(VRPoseHistoryTest, should_fade_out_velocity_once_samples_stop)
+    {
+        PoseHistory::Config config;
+        config.mMaxExtrapolation = 0.1;
+        PoseHistory history(config);
+        history.push(makePose(0, { 0, 0, 0 }, osg::Quat()));
+        history.push(makePose(10 * millisecond, { 0.01f, 0, 0 }, osg::Quat(0.01, osg::Z_AXIS)));
+        expectNear(history.linearVelocity(10 * millisecond), { 1, 0, 0 });
+        expectNear(history.linearVelocity(60 * millisecond), { 0.5f, 0, 0 });
+        expectNear(history.linearVelocity(200 * millisecond), { 0, 0, 0 });
+        expectNear(history.angularVelocity(200 * millisecond), { 0, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_estimate_angular_velocity)
+    {
+        PoseHistory history;
+        history.push(makePose(0, { 0, 0, 0 }, osg::Quat()));
+        history.push(makePose(10 * millisecond, { 0, 0, 0 }, osg::Quat(0.01, osg::Z_AXIS)));
+        expectNear(history.angularVelocity(), { 0, 0, 1 });
+    }
+
+    TEST(VRPoseHistoryTest, should_extrapolate_past_newest_pose)
+    {
+        PoseHistory history;
+        history.push(makePose(0, { 0, 0, 0 }));
+        history.push(makePose(10 * millisecond, { 0.01f, 0, 0 }));
+        EXPECT_EQ(history.locate(10 * millisecond).status, TrackingStatus::Good);
+        const TrackingPose pose = history.locate(30 * millisecond);
+        EXPECT_EQ(pose.status, TrackingStatus::Stale);
+        expectNear(pose.pose.position.asMeters(), { 0.03f, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_clamp_extrapolation_and_report_stale)
+    {
+        PoseHistory::Config config;
+        config.mMaxExtrapolation = 0.02;
+        PoseHistory history(config);
+        history.push(makePose(0, { 0, 0, 0 }));
+        history.push(makePose(10 * millisecond, { 0.01f, 0, 0 }));
+        const TrackingPose pose = history.locate(100 * millisecond);
+        EXPECT_EQ(pose.status, TrackingStatus::Stale);
+        expectNear(pose.pose.position.asMeters(), { 0.03f, 0, 0 });
+    }
+
+    TEST(VRPoseHistoryTest, should_not_estimate_velocity_across_tracking_gaps)
+    {
+        PoseHistory history;
+        history.push(makePose(0, { 0, 0, 0 }));
+        history.push(makePose(500 * millisecond, { 1, 0, 0 }));
+        expectNear(history.linearVelocity(), { 0, 0, 0 });
+    }
+}
@@ -39,9 +39,11 @@
 #include <components/xr/session.hpp>
 // ## VR_PATCH END
 
+#include <components/resource/imagemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
+#include <components/resource/transcodedimagecache.hpp>
 
 #include <components/compiler/extensions0.hpp>
 
@@ -820,7 +822,8 @@ void OMW::Engine::prepareEngine()
 
     mVFS = std::make_unique<VFS::Manager>();
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder());
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder(),
+        mCfgMgr.getUserDataPath() / "vfsindex.bin");
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
@@ -833,6 +836,9 @@ void OMW::Engine::prepareEngine()
     mEnvironment.setResourceSystem(*mResourceSystem);
 
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
+    if (Settings::general().mTranscodeS3TCTextures)
+        mResourceSystem->getImageManager()->setTranscodedImageCache(
+            std::make_unique<Resource::TranscodedImageCache>(mCfgMgr.getCachePath() / "textures"), mWorkQueue.get());
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
 
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
@@ -1318,5 +1324,6 @@ void OMW::Engine::configureVRScene()
     mStereoManager->setShouldAttachMultiviewFramebufferToMainCamera(false);
     // Fully initialize with integration into the rendering manager
     mVrGUIManager->initScene();
+    mVrViewer->setupMotionVectors(mResourceSystem->getSceneManager()->getShaderManager());
 }
 // ## VR_PATCH END
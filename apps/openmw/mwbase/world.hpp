@@ -429,6 +429,9 @@ namespace MWBase
         virtual bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        virtual void requestLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
+        ///< compute Line of Sight in the background, for getLOS calls in the next frames
+
         virtual float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false)
             = 0;
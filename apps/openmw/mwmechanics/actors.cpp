@@ -1496,6 +1496,33 @@ namespace MWMechanics
         }
     }
 
+    void Actors::requestLineOfSight(const MWWorld::Ptr& player, int processingRange) const
+    {
+        // Combat AI checks the line of sight to its targets regularly. Requesting it early lets the physics threads
+        // compute it, so the check during the AI update is served from the cache. Requests nobody reads expire.
+        MWBase::World* const world = MWBase::Environment::get().getWorld();
+        const osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
+        const float maxDistSqr = static_cast<float>(processingRange) * static_cast<float>(processingRange);
+        std::vector<MWWorld::Ptr> targets;
+        for (const Actor& actor : mActors)
+        {
+            if (actor.isInvalid() || actor.getPtr() == player)
+                continue;
+            const MWWorld::Ptr& ptr = actor.getPtr();
+            const CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
+            if (stats.isDead() || !stats.getAiSequence().isInCombat()
+                || (playerPos - ptr.getRefData().getPosition().asVec3()).length2() > maxDistSqr)
+                continue;
+            targets.clear();
+            stats.getAiSequence().getCombatTargets(targets);
+            for (const MWWorld::Ptr& target : targets)
+            {
+                if (!target.isEmpty())
+                    world->requestLOS(ptr, target);
+            }
+        }
+    }
+
     void Actors::update(float duration, bool paused)
     {
         if (!paused)
@@ -1537,6 +1564,10 @@ namespace MWMechanics
             }
             const int actorsProcessingRange = Settings::game().mActorsProcessingRange;
 
+            // Without physics threads the requests would be computed on the main thread whether they are used or not
+            if (aiActive && Settings::physics().mAsyncNumThreads > 0)
+                requestLineOfSight(player, actorsProcessingRange);
+
             // AI and magic effects update
             for (Actor& actor : mActors)
             {
@@ -191,6 +191,8 @@ namespace MWMechanics
 
         void predictAndAvoidCollisions(float duration) const;
 
+        void requestLineOfSight(const MWWorld::Ptr& player, int processingRange) const;
+
         /** Start combat between two actors
             @Notes: If againstPlayer = true then actor2 should be the Player.
                     If one of the combatants is creature it should be actor1.
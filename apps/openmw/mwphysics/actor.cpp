@@ -1,6 +1,7 @@
 #include "actor.hpp"
 
 #include <BulletCollision/CollisionShapes/btCylinderShape.h>
+#include <LinearMath/btAabbUtil2.h>
 
 #include <components/debug/debuglog.hpp>
 #include <components/misc/convert.hpp>
@@ -11,9 +12,11 @@
 #include "../mwworld/class.hpp"
 
 #include "collisiontype.hpp"
+#include "constants.hpp"
 #include "mtphysics.hpp"
 #include "trace.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace MWPhysics
@@ -35,6 +38,7 @@ namespace MWPhysics
         , mInternalCollisionMode(true)
         , mExternalCollisionMode(true)
         , mActive(false)
+        , mIdleFrames(0)
         , mTaskScheduler(scheduler)
     {
         // We can not create actor without collisions - he will fall through the ground.
@@ -122,6 +126,8 @@ namespace MWPhysics
 
     void Actor::enableCollisionMode(bool collision)
     {
+        if (mInternalCollisionMode != collision)
+            wakeUp();
         mInternalCollisionMode = collision;
     }
 
@@ -164,6 +170,7 @@ namespace MWPhysics
         mPositionOffset = osg::Vec3f();
         mStandingOnPtr = nullptr;
         mSkipSimulation = true;
+        mIdleFrames = 0;
     }
 
     void Actor::setSimulationPosition(const osg::Vec3f& position)
@@ -216,6 +223,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         mPositionOffset += offset;
+        mIdleFrames = 0;
     }
 
     osg::Vec3f Actor::applyOffsetChange()
@@ -245,6 +253,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         updateScaleUnsafe();
+        mIdleFrames = 0;
     }
 
     void Actor::updateScaleUnsafe()
@@ -286,6 +295,19 @@ namespace MWPhysics
         mOnGround = grounded;
     }
 
+    void Actor::updateSleep(bool idle)
+    {
+        mIdleFrames = idle ? std::min(mIdleFrames + 1, sIdleFramesBeforeSleep) : 0;
+    }
+
+    bool Actor::isDisturbedBy(
+        const btVector3& actorMin, const btVector3& actorMax, const btVector3& changedMin, const btVector3& changedMax)
+    {
+        // The actor floats slightly above the ground it rests on
+        const btVector3 margin(sGroundOffset * 2, sGroundOffset * 2, sGroundOffset * 2);
+        return TestAabbAgainstAabb2(actorMin - margin, actorMax + margin, changedMin, changedMax);
+    }
+
     void Actor::setOnSlope(bool slope)
     {
         mOnSlope = slope;
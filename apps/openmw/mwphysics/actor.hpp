@@ -14,6 +14,7 @@
 class btCollisionShape;
 class btCollisionWorld;
 class btConvexShape;
+class btVector3;
 
 namespace Resource
 {
@@ -146,6 +147,25 @@ namespace MWPhysics
 
         void setActive(bool value) { mActive = value; }
 
+        /**
+         * Sleeping actors stand still on the ground, their movement isn't simulated until they wake up.
+         */
+        bool isSleeping() const { return mIdleFrames >= sIdleFramesBeforeSleep; }
+
+        /**
+         * Count the simulated frames the actor stayed idle, wake it up when it didn't.
+         */
+        void updateSleep(bool idle);
+
+        void wakeUp() { mIdleFrames = 0; }
+
+        /**
+         * Whether collision geometry within the changed bounds may have been supporting or touching a sleeping actor
+         * within the actor bounds, so that changing it has to wake the actor up.
+         */
+        static bool isDisturbedBy(const btVector3& actorMin, const btVector3& actorMax, const btVector3& changedMin,
+            const btVector3& changedMax);
+
         DetourNavigator::CollisionShapeType getCollisionShapeType() const { return mCollisionShapeType; }
 
     private:
@@ -189,6 +209,9 @@ namespace MWPhysics
         bool mExternalCollisionMode;
         bool mActive;
 
+        static constexpr unsigned sIdleFramesBeforeSleep = 5;
+        unsigned mIdleFrames;
+
         PhysicsTaskScheduler* mTaskScheduler;
 
         inline void updateScaleUnsafe();
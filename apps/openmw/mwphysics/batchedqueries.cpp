@@ -0,0 +1,100 @@
+#include "batchedqueries.hpp"
+
+#include "heightfield.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/NarrowPhaseCollision/btPersistentManifold.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MWPhysics
+{
+    void AabbBatch::update(btCollisionWorld& collisionWorld)
+    {
+        const std::size_t count = mCollisionObjects.size();
+        mMin.resize(count);
+        mMax.resize(count);
+
+        const btScalar threshold = gContactBreakingThreshold;
+        const btVector3 contactThreshold(threshold, threshold, threshold);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const btCollisionObject& collisionObject = *mCollisionObjects[i];
+            collisionObject.getCollisionShape()->getAabb(collisionObject.getWorldTransform(), mMin[i], mMax[i]);
+            mMin[i] -= contactThreshold;
+            mMax[i] += contactThreshold;
+        }
+
+        btBroadphaseInterface* const broadphase = collisionWorld.getBroadphase();
+        btDispatcher* const dispatcher = collisionWorld.getDispatcher();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            btCollisionObject* const collisionObject = mCollisionObjects[i];
+            // Moving objects should be moderately sized, leave reporting the others to Bullet
+            if (collisionObject->isStaticObject() || (mMax[i] - mMin[i]).length2() < btScalar(1e12))
+                broadphase->setAabb(collisionObject->getBroadphaseHandle(), mMin[i], mMax[i], dispatcher);
+            else
+                collisionWorld.updateSingleAabb(collisionObject);
+        }
+
+        mCollisionObjects.clear();
+    }
+
+    std::size_t HeightFieldQueries::add(const osg::Vec2f& position)
+    {
+        mX.push_back(position.x());
+        mY.push_back(position.y());
+        return mX.size() - 1;
+    }
+
+    void HeightFieldQueries::run(const HeightFields& heightFields, int cellSize)
+    {
+        mHeights.assign(mX.size(), std::numeric_limits<float>::lowest());
+        if (heightFields.empty() || cellSize <= 0)
+            return;
+
+        mQueries.clear();
+        for (std::size_t i = 0; i < mX.size(); ++i)
+        {
+            const std::pair cell(static_cast<int>(std::floor(mX[i] / cellSize)),
+                static_cast<int>(std::floor(mY[i] / cellSize)));
+            mQueries.push_back(Query{ cell, i });
+        }
+        std::sort(mQueries.begin(), mQueries.end(),
+            [](const Query& lhs, const Query& rhs) { return lhs.mCell < rhs.mCell; });
+
+        for (auto begin = mQueries.begin(); begin != mQueries.end();)
+        {
+            const auto end = std::find_if(
+                begin, mQueries.end(), [&](const Query& query) { return query.mCell != begin->mCell; });
+            const auto heightField = heightFields.find(begin->mCell);
+            if (heightField != heightFields.end())
+            {
+                // Gather the positions over this heightfield so it is sampled in one contiguous pass
+                mCellX.clear();
+                mCellY.clear();
+                for (auto it = begin; it != end; ++it)
+                {
+                    mCellX.push_back(mX[it->mIndex]);
+                    mCellY.push_back(mY[it->mIndex]);
+                }
+                mCellHeights.resize(mCellX.size());
+                heightField->second->getHeights(mCellX, mCellY, mCellHeights);
+                for (auto it = begin; it != end; ++it)
+                    mHeights[it->mIndex] = mCellHeights[static_cast<std::size_t>(it - begin)];
+            }
+            begin = end;
+        }
+    }
+
+    void HeightFieldQueries::clear()
+    {
+        mX.clear();
+        mY.clear();
+        mHeights.clear();
+    }
+}
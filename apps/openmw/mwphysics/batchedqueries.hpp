@@ -0,0 +1,71 @@
+#ifndef OPENMW_MWPHYSICS_BATCHEDQUERIES_H
+#define OPENMW_MWPHYSICS_BATCHEDQUERIES_H
+
+#include <LinearMath/btVector3.h>
+
+#include <osg/Vec2f>
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+class btCollisionObject;
+class btCollisionWorld;
+
+namespace MWPhysics
+{
+    class HeightField;
+
+    /// Updates broadphase AABBs of many collision objects the way btCollisionWorld::updateSingleAabb does, but
+    /// computes the AABBs of all shapes before touching the broadphase.
+    class AabbBatch
+    {
+    public:
+        void add(btCollisionObject* collisionObject) { mCollisionObjects.push_back(collisionObject); }
+
+        bool empty() const { return mCollisionObjects.empty(); }
+
+        /// Needs exclusive access to the collision world, clears the batch
+        void update(btCollisionWorld& collisionWorld);
+
+    private:
+        std::vector<btCollisionObject*> mCollisionObjects;
+        std::vector<btVector3> mMin;
+        std::vector<btVector3> mMax;
+    };
+
+    /// Looks up terrain heights for many positions, each heightfield is sampled once for all positions above it.
+    class HeightFieldQueries
+    {
+    public:
+        using HeightFields = std::map<std::pair<int, int>, const HeightField*>;
+
+        /// @return index of the height in the results
+        std::size_t add(const osg::Vec2f& position);
+
+        void run(const HeightFields& heightFields, int cellSize);
+
+        /// @return terrain height, lowest float when there is no heightfield at the position
+        float getHeight(std::size_t index) const { return mHeights[index]; }
+
+        void clear();
+
+    private:
+        struct Query
+        {
+            std::pair<int, int> mCell;
+            std::size_t mIndex;
+        };
+
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mHeights;
+        std::vector<Query> mQueries;
+        std::vector<float> mCellX;
+        std::vector<float> mCellY;
+        std::vector<float> mCellHeights;
+    };
+}
+
+#endif
@@ -55,6 +55,10 @@ namespace MWPhysics
     HeightField::HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
         const osg::Object* holdObject, PhysicsTaskScheduler* scheduler)
         : mHoldObject(holdObject)
+        , mGrid{ heights, verts, static_cast<float>(x * size), static_cast<float>(y * size),
+            static_cast<float>(size) / static_cast<float>(verts - 1) }
+        , mCell(x, y)
+        , mCellSize(size)
 #if BT_BULLET_VERSION < 310
         , mHeights(makeHeights(heights, verts))
 #endif
@@ -88,13 +92,20 @@ namespace MWPhysics
         mCollisionObject->setWorldTransform(transform);
         mTaskScheduler->addCollisionObject(
             mCollisionObject.get(), CollisionType_HeightMap, CollisionType_Actor | CollisionType_Projectile);
+        mTaskScheduler->addHeightField(*this);
     }
 
     HeightField::~HeightField()
     {
+        mTaskScheduler->removeHeightField(*this);
         mTaskScheduler->removeCollisionObject(mCollisionObject.get());
     }
 
+    void HeightField::getHeights(std::span<const float> x, std::span<const float> y, std::span<float> result) const
+    {
+        BulletHelpers::getHeightfieldHeights(mGrid, x, y, result);
+    }
+
     btCollisionObject* HeightField::getCollisionObject()
     {
         return mCollisionObject.get();
@@ -5,7 +5,11 @@
 
 #include <LinearMath/btScalar.h>
 
+#include <components/bullethelpers/heightfield.hpp>
+
 #include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 
 class btCollisionObject;
@@ -31,10 +35,20 @@ namespace MWPhysics
         const btCollisionObject* getCollisionObject() const;
         const btHeightfieldTerrainShape* getShape() const;
 
+        std::pair<int, int> getCell() const { return mCell; }
+        int getCellSize() const { return mCellSize; }
+
+        /// Get terrain heights at many world positions at once. Positions outside are clamped to the border.
+        void getHeights(std::span<const float> x, std::span<const float> y, std::span<float> result) const;
+
     private:
         std::unique_ptr<btHeightfieldTerrainShape> mShape;
         std::unique_ptr<btCollisionObject> mCollisionObject;
         osg::ref_ptr<const osg::Object> mHoldObject;
+        // Points to the heights held by mHoldObject
+        BulletHelpers::HeightfieldGrid mGrid;
+        std::pair<int, int> mCell;
+        int mCellSize;
 #if BT_BULLET_VERSION < 310
         std::vector<btScalar> mHeights;
 #endif
@@ -128,6 +128,9 @@ namespace MWPhysics
     void MovementSolver::move(
         ActorFrameData& actor, float time, const btCollisionWorld* collisionWorld, const WorldFrameData& worldData)
     {
+        // Sleeping actors stay where they are, skip all the sweeps
+        if (actor.mSleeping)
+            return;
         // Reset per-frame data
         actor.mWalkingOnWater = false;
         // Anything to collide with?
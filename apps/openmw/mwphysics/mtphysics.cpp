@@ -1,12 +1,16 @@
 #include "mtphysics.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <functional>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <span>
 #include <stdexcept>
 #include <variant>
+#include <vector>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
@@ -16,7 +20,9 @@
 
 #include "components/debug/debuglog.hpp"
 #include "components/misc/convert.hpp"
-#include <components/misc/barrier.hpp>
+#include "components/misc/hash.hpp"
+#include <components/files/conversion.hpp>
+#include <components/misc/workstealingranges.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
@@ -31,10 +37,12 @@
 
 #include "actor.hpp"
 #include "contacttestwrapper.h"
+#include "heightfield.hpp"
 #include "movementsolver.hpp"
 #include "object.hpp"
 #include "physicssystem.hpp"
 #include "projectile.hpp"
+#include "replay.hpp"
 
 //## VR_PATCH BEGIN
 #include <components/vr/session.hpp>
@@ -147,6 +155,60 @@ namespace
     using LockedProjectileSimulation
         = std::pair<std::shared_ptr<MWPhysics::Projectile>, std::reference_wrapper<MWPhysics::ProjectileFrameData>>;
 
+    btCollisionObject* commitCollisionObjectPosition(MWPhysics::PtrHolder& ptr)
+    {
+        if (auto* const actor = dynamic_cast<MWPhysics::Actor*>(&ptr))
+        {
+            actor->updateCollisionObjectPosition();
+            return actor->getCollisionObject();
+        }
+        if (auto* const object = dynamic_cast<MWPhysics::Object*>(&ptr))
+        {
+            object->commitPositionChange();
+            return object->getCollisionObject();
+        }
+        if (auto* const projectile = dynamic_cast<MWPhysics::Projectile*>(&ptr))
+        {
+            projectile->updateCollisionObjectPosition();
+            return projectile->getCollisionObject();
+        }
+        return nullptr;
+    }
+
+    // Heightfields have no holes, so an actor above the terrain at the beginning of a step and below it at the end went
+    // through it, usually falling fast at a low physics framerate. Put it back on top.
+    void keepAboveTerrain(std::span<const LockedActorSimulation> actors,
+        const MWPhysics::HeightFieldQueries::HeightFields& heightFields, int cellSize,
+        MWPhysics::HeightFieldQueries& queries)
+    {
+        constexpr float tolerance = 1.f;
+        if (heightFields.empty())
+            return;
+
+        queries.clear();
+        for (const auto& [actor, frameData] : actors)
+        {
+            const osg::Vec3d start = actor->getPosition();
+            queries.add(osg::Vec2f(start.x(), start.y()));
+            queries.add(osg::Vec2f(frameData.get().mPosition.x(), frameData.get().mPosition.y()));
+        }
+        queries.run(heightFields, cellSize);
+
+        for (std::size_t i = 0; i < actors.size(); ++i)
+        {
+            const auto& [actor, frameDataRef] = actors[i];
+            MWPhysics::ActorFrameData& frameData = frameDataRef.get();
+            if (frameData.mSkipCollisionDetection || frameData.mSleeping)
+                continue;
+            const float startHeight = queries.getHeight(2 * i);
+            const float endHeight = queries.getHeight(2 * i + 1);
+            if (actor->getPosition().z() < startHeight - tolerance || frameData.mPosition.z() >= endHeight - tolerance)
+                continue;
+            frameData.mPosition.z() = endHeight;
+            frameData.mInertia.z() = std::max(frameData.mInertia.z(), 0.f);
+        }
+    }
+
     namespace Visitors
     {
         template <class Impl, template <class> class Lock>
@@ -218,7 +280,7 @@ namespace
 
         struct UpdatePosition
         {
-            btCollisionWorld* mCollisionWorld;
+            MWPhysics::AabbBatch& mAabbBatch;
             void operator()(const LockedActorSimulation& sim) const
             {
                 auto& [actor, frameDataRef] = sim;
@@ -227,7 +289,7 @@ namespace
                 {
                     frameData.mPosition = actor->getPosition(); // account for potential position change made by script
                     actor->updateCollisionObjectPosition();
-                    mCollisionWorld->updateSingleAabb(actor->getCollisionObject());
+                    mAabbBatch.add(actor->getCollisionObject());
                 }
             }
             void operator()(const LockedProjectileSimulation& sim) const
@@ -236,7 +298,25 @@ namespace
                 auto& frameData = frameDataRef.get();
                 proj->setPosition(frameData.mPosition);
                 proj->updateCollisionObjectPosition();
-                mCollisionWorld->updateSingleAabb(proj->getCollisionObject());
+                mAabbBatch.add(proj->getCollisionObject());
+            }
+        };
+
+        // Collects the simulated objects, so all of them are updated under one collision world lock. They are kept
+        // locked until it is released, because the Ptr destructor also acquires mCollisionWorldMutex.
+        struct LockAll
+        {
+            std::vector<LockedActorSimulation>& mActors;
+            std::vector<LockedProjectileSimulation>& mProjectiles;
+            void operator()(MWPhysics::ActorSimulation& sim) const
+            {
+                if (auto locked = sim.lock())
+                    mActors.push_back(*std::move(locked));
+            }
+            void operator()(MWPhysics::ProjectileSimulation& sim) const
+            {
+                if (auto locked = sim.lock())
+                    mProjectiles.push_back(*std::move(locked));
             }
         };
 
@@ -283,7 +363,8 @@ namespace
                 actor->setSimulationPosition(::interpolateMovements(*actor, mTimeAccum, mPhysicsDt));
                 actor->setLastStuckPosition(frameData.mLastStuckPosition);
                 actor->setStuckFrames(frameData.mStuckFrames);
-                if (mAdvanceSimulation)
+                // a sleeping actor keeps its ground state, the solver didn't update it
+                if (mAdvanceSimulation && !frameData.mSleeping)
                 {
                     MWWorld::Ptr standingOn;
                     if (frameData.mStandingOn != nullptr)
@@ -413,17 +494,22 @@ namespace MWPhysics
     PhysicsTaskScheduler::PhysicsTaskScheduler(
         float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer)
         : mDefaultPhysicsDt(physicsDt)
+        , mFixedRate(Settings::physics().mFixedRate)
         , mPhysicsDt(physicsDt)
         , mTimeAccum(0.f)
         , mCollisionWorld(collisionWorld)
         , mDebugDrawer(debugDrawer)
+        , mPendingJobs(0)
+        , mFirstStepPending(false)
+        , mStepGeneration(0)
+        , mPendingPostSimJobs(0)
         , mLockingPolicy(detectLockingPolicy())
         , mNumThreads(getNumThreads(mLockingPolicy))
         , mNumJobs(0)
+        , mNumActors(0)
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::physics().mLineofsightKeepInactiveCache)
         , mAdvanceSimulation(false)
-        , mNextJob(0)
         , mNextLOS(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
@@ -441,18 +527,20 @@ namespace MWPhysics
         {
             Log(Debug::Info) << "Using " << mNumThreads << " async physics threads";
             for (unsigned i = 0; i < mNumThreads; ++i)
-                mThreads.emplace_back([&] { worker(); });
+                mThreads.emplace_back([this, i] { worker(i); });
         }
         else
         {
             mLOSCacheExpiry = 0;
         }
 
-        mPreStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
-
-        mPostStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
+        if (const std::string& path = Settings::physics().mReplayRecordingPath; !path.empty())
+        {
+            Log(Debug::Info) << "Recording physics replay to " << path;
+            mRecorder = std::make_unique<Replay::Recorder>(Files::pathFromUnicodeString(path));
+        }
 
-        mPostSimBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
+        mJobs = std::make_unique<Misc::WorkStealingRanges>(mNumThreads);
     }
 
     PhysicsTaskScheduler::~PhysicsTaskScheduler()
@@ -497,6 +585,11 @@ namespace MWPhysics
         // limit to a reasonable amount
         maxAllowedSteps = std::min(10u, maxAllowedSteps);
 
+        // the step length is what makes the simulation behave the same at any render framerate, keep it and let
+        // prepareWork drop the time left over
+        if (mFixedRate)
+            return std::make_tuple(std::min(numSteps, maxAllowedSteps), mDefaultPhysicsDt);
+
         // fall back to delta time for this frame if fixed timestep physics would fall behind
         float actualDelta = mDefaultPhysicsDt;
         if (numSteps > maxAllowedSteps)
@@ -548,6 +641,9 @@ namespace MWPhysics
 
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
+        // keep at most one step of backlog so a slow frame doesn't cause a burst of steps in the following ones
+        if (mFixedRate)
+            timeAccum = std::min(timeAccum, mDefaultPhysicsDt);
 
         // init
         const Visitors::InitPosition vis{ mCollisionWorld };
@@ -561,19 +657,30 @@ namespace MWPhysics
         mPhysicsDt = newDelta;
         mSimulations = &simulations;
         mAdvanceSimulation = (mRemainingSteps != 0);
-        mNumJobs = static_cast<int>(mSimulations->size());
-        mNextLOS.store(0, std::memory_order_relaxed);
-        mNextJob.store(0, std::memory_order_release);
+        assert(std::is_partitioned(mSimulations->begin(), mSimulations->end(),
+            [](const Simulation& sim) { return std::holds_alternative<ActorSimulation>(sim); }));
+        mNumActors = static_cast<std::size_t>(std::count_if(mSimulations->begin(), mSimulations->end(),
+            [](const Simulation& sim) { return std::holds_alternative<ActorSimulation>(sim); }));
+        const std::size_t numProjectiles = mSimulations->size() - mNumActors;
+        mNumJobs = static_cast<int>(mNumActors + (numProjectiles + sProjectilesPerJob - 1) / sProjectilesPerJob);
+        mJobs->reset(0, 1);
+        mFirstStepPending.store(true, std::memory_order_relaxed);
+        prepareLOSRefresh();
+        // One more job stands for the simulation steps, so the frame does not end before they do
+        mPendingPostSimJobs.store(static_cast<int>(mLOSRefresh.size()) + 1, std::memory_order_relaxed);
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
 
+        if (mRecorder != nullptr && mAdvanceSimulation)
+            mRecorder->record(*mCollisionWorld, simulations, numSteps, newDelta, *mWorldFrameData);
+
         if (mAdvanceSimulation)
             mBudgetCursor += 1;
 
         if (mNumThreads == 0)
         {
-            doSimulation();
+            doSimulation(0);
             syncWithMainThread();
             if (mAdvanceSimulation)
                 mBudget.update(mTimer->delta_s(timeStart, mTimer->tick()), numSteps, mBudgetCursor);
@@ -661,6 +768,17 @@ namespace MWPhysics
         collisionObject->getBroadphaseHandle()->m_collisionFilterMask = collisionFilterMask;
     }
 
+    void PhysicsTaskScheduler::setCollisionShape(btCollisionObject* collisionObject, btCollisionShape* shape)
+    {
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        // Collision algorithms cached for overlapping pairs depend on the shape type
+        if (btBroadphaseProxy* proxy = collisionObject->getBroadphaseHandle())
+            mCollisionWorld->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(
+                proxy, mCollisionWorld->getDispatcher());
+        collisionObject->setCollisionShape(shape);
+        mCollisionWorld->updateSingleAabb(collisionObject);
+    }
+
     void PhysicsTaskScheduler::addCollisionObject(
         btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask)
     {
@@ -676,6 +794,21 @@ namespace MWPhysics
         mCollisionWorld->removeCollisionObject(collisionObject);
     }
 
+    void PhysicsTaskScheduler::addHeightField(const HeightField& heightField)
+    {
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        mHeightFields[heightField.getCell()] = &heightField;
+        mHeightFieldCellSize = heightField.getCellSize();
+    }
+
+    void PhysicsTaskScheduler::removeHeightField(const HeightField& heightField)
+    {
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        const auto it = mHeightFields.find(heightField.getCell());
+        if (it != mHeightFields.end() && it->second == &heightField)
+            mHeightFields.erase(it);
+    }
+
     void PhysicsTaskScheduler::updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate)
     {
         if (immediate || mNumThreads == 0)
@@ -689,87 +822,147 @@ namespace MWPhysics
         }
     }
 
+    std::size_t PhysicsTaskScheduler::LOSKeyHash::operator()(const LOSKey& key) const
+    {
+        std::size_t seed = 0;
+        Misc::hashCombine(seed, key.first);
+        Misc::hashCombine(seed, key.second);
+        return seed;
+    }
+
+    LOSRequest* PhysicsTaskScheduler::findLOSRequest(
+        const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
+    {
+        // getLOS(A, B) and getLOS(B, A) share the same request
+        const Actor* const raw1 = actor1.get();
+        const Actor* const raw2 = actor2.get();
+        const LOSKey key = raw1 < raw2 ? LOSKey(raw1, raw2) : LOSKey(raw2, raw1);
+        LOSRequest& req = mLOSCache.try_emplace(key, actor1, actor2).first->second;
+        // A removed actor's requests stay until the next prepareWork, meanwhile a new actor may get its address
+        if (req.mActors[0].expired() || req.mActors[1].expired())
+            return nullptr;
+        return &req;
+    }
+
     bool PhysicsTaskScheduler::getLineOfSight(
         const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
     {
-        MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
+        LOSRequest* const req = findLOSRequest(actor1, actor2);
+        // Only reading the result keeps the request refreshed
+        if (req != nullptr)
+            req->mAge.store(0, std::memory_order_relaxed);
+        if (req != nullptr && req->mReady.load(std::memory_order_acquire))
+            return req->mResult.load(std::memory_order_relaxed);
+
+        // Not requested in time for the physics threads, compute it now
+        const bool result = hasLineOfSight(actor1.get(), actor2.get());
+        if (req != nullptr)
+        {
+            req->mResult.store(result, std::memory_order_relaxed);
+            req->mReady.store(true, std::memory_order_release);
+        }
+        return result;
+    }
+
+    void PhysicsTaskScheduler::requestLineOfSight(
+        const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
+    {
+        findLOSRequest(actor1, actor2);
+    }
 
-        auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+    void PhysicsTaskScheduler::prepareLOSRefresh()
+    {
+        mLOSRefresh.clear();
+        for (auto it = mLOSCache.begin(); it != mLOSCache.end();)
         {
-            req.mResult = hasLineOfSight(actor1.get(), actor2.get());
-            mLOSCache.push_back(req);
-            return req.mResult;
+            const LOSRequest& req = it->second;
+            if (req.mAge.load(std::memory_order_relaxed) > mLOSCacheExpiry || req.mActors[0].expired()
+                || req.mActors[1].expired())
+            {
+                it = mLOSCache.erase(it);
+                continue;
+            }
+            mLOSRefresh.push_back(&it->second);
+            ++it;
         }
-        result->mAge = 0;
-        return result->mResult;
+        mNextLOS.store(0, std::memory_order_relaxed);
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
     {
-        MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
+        const int numLOS = static_cast<int>(mLOSRefresh.size());
+        int done = 0;
         int job = 0;
-        int numLOS = static_cast<int>(mLOSCache.size());
         while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < numLOS)
         {
-            auto& req = mLOSCache[job];
-            auto actorPtr1 = req.mActors[0].lock();
-            auto actorPtr2 = req.mActors[1].lock();
-
-            if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
-                req.mStale = true;
-            else
-                req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+            LOSRequest& req = *mLOSRefresh[job];
+            req.mAge.fetch_add(1, std::memory_order_relaxed);
+            const auto actorPtr1 = req.mActors[0].lock();
+            const auto actorPtr2 = req.mActors[1].lock();
+            if (actorPtr1 != nullptr && actorPtr2 != nullptr)
+            {
+                req.mResult.store(hasLineOfSight(actorPtr1.get(), actorPtr2.get()), std::memory_order_relaxed);
+                req.mReady.store(true, std::memory_order_release);
+            }
+            ++done;
         }
+        if (done != 0)
+            releasePostSimJobs(done);
     }
 
     void PhysicsTaskScheduler::updateAabbs()
     {
-        MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
-        std::for_each(mUpdateAabb.begin(), mUpdateAabb.end(), [this](const std::weak_ptr<PtrHolder>& ptr) {
-            auto p = ptr.lock();
-            if (p != nullptr)
-                updatePtrAabb(p);
-        });
-        mUpdateAabb.clear();
+        std::vector<std::shared_ptr<PtrHolder>> ptrs;
+        {
+            MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
+            ptrs.reserve(mUpdateAabb.size());
+            for (const std::weak_ptr<PtrHolder>& ptr : mUpdateAabb)
+                if (auto p = ptr.lock())
+                    ptrs.push_back(std::move(p));
+            mUpdateAabb.clear();
+        }
+        if (ptrs.empty())
+            return;
+
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (const std::shared_ptr<PtrHolder>& ptr : ptrs)
+            if (btCollisionObject* collisionObject = ::commitCollisionObjectPosition(*ptr))
+                mAabbBatch.add(collisionObject);
+        mAabbBatch.update(*mCollisionWorld);
     }
 
     void PhysicsTaskScheduler::updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
-        if (const auto actor = std::dynamic_pointer_cast<Actor>(ptr))
-        {
-            actor->updateCollisionObjectPosition();
-            mCollisionWorld->updateSingleAabb(actor->getCollisionObject());
-        }
-        else if (const auto object = std::dynamic_pointer_cast<Object>(ptr))
-        {
-            object->commitPositionChange();
-            mCollisionWorld->updateSingleAabb(object->getCollisionObject());
-        }
-        else if (const auto projectile = std::dynamic_pointer_cast<Projectile>(ptr))
-        {
-            projectile->updateCollisionObjectPosition();
-            mCollisionWorld->updateSingleAabb(projectile->getCollisionObject());
-        }
+        if (btCollisionObject* collisionObject = ::commitCollisionObjectPosition(*ptr))
+            mCollisionWorld->updateSingleAabb(collisionObject);
     }
 
-    void PhysicsTaskScheduler::worker()
+    void PhysicsTaskScheduler::worker(std::size_t index)
     {
-        mWorkersSync->runWorker([this] {
+        mWorkersSync->runWorker([this, index] {
             std::shared_lock lock(mSimulationMutex);
-            doSimulation();
+            doSimulation(index);
         });
     }
 
     void PhysicsTaskScheduler::updateActorsPositions()
     {
-        const Visitors::UpdatePosition impl{ mCollisionWorld };
-        const Visitors::WithLockedPtr<Visitors::UpdatePosition, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
-            mLockingPolicy };
+        std::vector<LockedActorSimulation> actors;
+        std::vector<LockedProjectileSimulation> projectiles;
+        actors.reserve(mSimulations->size());
+        const Visitors::LockAll lockAll{ actors, projectiles };
         for (Simulation& sim : *mSimulations)
-            std::visit(vis, sim);
+            std::visit(lockAll, sim);
+
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        ::keepAboveTerrain(actors, mHeightFields, mHeightFieldCellSize, mTerrainQueries);
+        const Visitors::UpdatePosition vis{ mAabbBatch };
+        for (const LockedActorSimulation& sim : actors)
+            vis(sim);
+        for (const LockedProjectileSimulation& sim : projectiles)
+            vis(sim);
+        mAabbBatch.update(*mCollisionWorld);
     }
 
     bool PhysicsTaskScheduler::hasLineOfSight(const Actor* actor1, const Actor* actor2)
@@ -789,22 +982,135 @@ namespace MWPhysics
         return !resultCallback.hasHit();
     }
 
-    void PhysicsTaskScheduler::doSimulation()
+    void PhysicsTaskScheduler::doSimulation(std::size_t worker)
     {
-        while (mRemainingSteps)
+        // Threads may join late or not at all, whoever comes first starts the simulation
+        if (mFirstStepPending.exchange(false, std::memory_order_acq_rel))
         {
-            mPreStepBarrier->wait([this] { afterPreStep(); });
-            int job = 0;
-            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
-            const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
-            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+            if (mRemainingSteps.load(std::memory_order_relaxed) != 0)
+                beginStep();
+            else
+                finishSteps();
+        }
 
-            mPostStepBarrier->wait([this] { afterPostStep(); });
+        while (true)
+        {
+            // Read the generation before the steps so the last publication can't be missed
+            const unsigned generation = mStepGeneration.load(std::memory_order_acquire);
+            if (mRemainingSteps.load(std::memory_order_acquire) == 0)
+                break;
+            runJobs(worker);
+            waitForStep(generation);
         }
 
         refreshLOSCache();
-        mPostSimBarrier->wait([this] { afterPostSim(); });
+    }
+
+    void PhysicsTaskScheduler::beginStep()
+    {
+        updateAabbs();
+        const Visitors::PreStep impl{ mCollisionWorld };
+        const Visitors::WithLockedPtr<Visitors::PreStep, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
+            mLockingPolicy };
+        for (auto& sim : *mSimulations)
+            std::visit(vis, sim);
+        if (mNumJobs == 0)
+        {
+            endStep();
+            return;
+        }
+        const auto jobCount = static_cast<std::uint32_t>(mNumJobs);
+        // Small batches so a worker on a slow core never sits on many jobs
+        const auto batchSize = static_cast<std::uint32_t>(jobCount / (mJobs->getWorkerCount() * 8));
+        mPendingJobs.store(mNumJobs, std::memory_order_relaxed);
+        mJobs->reset(jobCount, batchSize);
+        publishStep();
+    }
+
+    void PhysicsTaskScheduler::runJobs(std::size_t worker)
+    {
+        const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
+        const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
+        while (true)
+        {
+            const Misc::WorkStealingRanges::Batch batch = mJobs->take(worker);
+            if (batch.empty())
+                return;
+            for (std::uint32_t job = batch.mBegin; job < batch.mEnd; ++job)
+            {
+                if (job < mNumActors)
+                    std::visit(vis, (*mSimulations)[job]);
+                else
+                    moveProjectiles(job - mNumActors);
+            }
+            const int done = static_cast<int>(batch.size());
+            // The thread finishing the step goes on with the next one, its jobs are taken by this same loop
+            if (mPendingJobs.fetch_sub(done, std::memory_order_acq_rel) == done)
+                endStep();
+        }
+    }
+
+    void PhysicsTaskScheduler::moveProjectiles(std::size_t job)
+    {
+        const std::size_t begin = mNumActors + job * sProjectilesPerJob;
+        const std::size_t end = std::min(begin + sProjectilesPerJob, mSimulations->size());
+
+        // Lock all projectiles of the job first and keep them until the collision world lock is released, the
+        // projectile destructor also acquires it
+        std::array<std::shared_ptr<Projectile>, sProjectilesPerJob> projectiles;
+        std::array<ProjectileFrameData*, sProjectilesPerJob> frameData;
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (auto locked = std::get<ProjectileSimulation>((*mSimulations)[i]).lock())
+            {
+                projectiles[count] = std::move(locked->first);
+                frameData[count] = &locked->second.get();
+                ++count;
+            }
+        }
+
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (std::size_t i = 0; i < count; ++i)
+            if (projectiles[i]->isActive())
+                MovementSolver::move(*frameData[i], mPhysicsDt, mCollisionWorld);
+    }
+
+    void PhysicsTaskScheduler::endStep()
+    {
+        updateActorsPositions();
+        if (mRemainingSteps.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            finishSteps();
+        else
+            beginStep();
+    }
+
+    void PhysicsTaskScheduler::finishSteps()
+    {
+        // Wake up threads waiting for a step that won't come
+        publishStep();
+        releasePostSimJobs(1);
+    }
+
+    void PhysicsTaskScheduler::publishStep()
+    {
+        {
+            const std::lock_guard lock(mStepMutex);
+            mStepGeneration.fetch_add(1, std::memory_order_release);
+        }
+        mStepPublished.notify_all();
+    }
+
+    void PhysicsTaskScheduler::waitForStep(unsigned generation)
+    {
+        std::unique_lock lock(mStepMutex);
+        mStepPublished.wait(lock, [&] { return mStepGeneration.load(std::memory_order_acquire) != generation; });
+    }
+
+    void PhysicsTaskScheduler::releasePostSimJobs(int count)
+    {
+        if (mPendingPostSimJobs.fetch_sub(count, std::memory_order_acq_rel) == count)
+            afterPostSim();
     }
 
     void PhysicsTaskScheduler::updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
@@ -848,36 +1154,8 @@ namespace MWPhysics
         mUpdateAabb.clear();
     }
 
-    void PhysicsTaskScheduler::afterPreStep()
-    {
-        updateAabbs();
-        if (!mRemainingSteps)
-            return;
-        const Visitors::PreStep impl{ mCollisionWorld };
-        const Visitors::WithLockedPtr<Visitors::PreStep, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
-            mLockingPolicy };
-        for (auto& sim : *mSimulations)
-            std::visit(vis, sim);
-    }
-
-    void PhysicsTaskScheduler::afterPostStep()
-    {
-        if (mRemainingSteps)
-        {
-            --mRemainingSteps;
-            updateActorsPositions();
-        }
-        mNextJob.store(0, std::memory_order_release);
-    }
-
     void PhysicsTaskScheduler::afterPostSim()
     {
-        {
-            MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
-            mLOSCache.erase(
-                std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
-                mLOSCache.end());
-        }
         mTimeEnd = mTimer->tick();
         if (mWorkersSync != nullptr)
             mWorkersSync->workIsDone();
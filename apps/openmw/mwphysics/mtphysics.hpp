@@ -4,23 +4,27 @@
 #include <atomic>
 #include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <shared_mutex>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
 #include <osg/Timer>
 
 #include "components/misc/budgetmeasurement.hpp"
+#include "batchedqueries.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 
 namespace Misc
 {
-    class Barrier;
+    class WorkStealingRanges;
 }
 
 namespace MWRender
@@ -37,6 +41,11 @@ namespace MWPhysics
         AllowSharedLocks,
     };
 
+    namespace Replay
+    {
+        class Recorder;
+    }
+
     class PhysicsTaskScheduler
     {
     public:
@@ -53,6 +62,9 @@ namespace MWPhysics
 
         void resetSimulation(const ActorMap& actors);
 
+        /// @return number of steps simulated by the last applyQueuedMovements
+        unsigned getStepCount() const { return mPrevStepCount; }
+
         // Thread safe wrappers
         void rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
             btCollisionWorld::RayResultCallback& resultCallback) const;
@@ -63,10 +75,17 @@ namespace MWPhysics
         void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
         void getAabb(const btCollisionObject* obj, btVector3& min, btVector3& max);
         void setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask);
+        void setCollisionShape(btCollisionObject* collisionObject, btCollisionShape* shape);
         void addCollisionObject(btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask);
         void removeCollisionObject(btCollisionObject* collisionObject);
+        void addHeightField(const HeightField& heightField);
+        void removeHeightField(const HeightField& heightField);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
+        /// Must be called from the main thread, like requestLineOfSight
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// Queue the line of sight test for the physics threads, the result is cached for later getLineOfSight calls.
+        /// The request expires like any other one nobody reads, requesting it again doesn't keep it alive.
+        void requestLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -75,17 +94,32 @@ namespace MWPhysics
     private:
         class WorkersSync;
 
-        void doSimulation();
-        void worker();
+        using LOSKey = std::pair<const Actor*, const Actor*>;
+
+        struct LOSKeyHash
+        {
+            std::size_t operator()(const LOSKey& key) const;
+        };
+
+        void doSimulation(std::size_t worker);
+        void worker(std::size_t index);
+        void beginStep();
+        void runJobs(std::size_t worker);
+        void endStep();
+        void finishSteps();
+        void publishStep();
+        void waitForStep(unsigned generation);
+        void releasePostSimJobs(int count);
         void updateActorsPositions();
+        void moveProjectiles(std::size_t job);
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
+        LOSRequest* findLOSRequest(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
         void refreshLOSCache();
+        void prepareLOSRefresh();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
         std::tuple<unsigned, float> calculateStepConfig(float timeAccum) const;
-        void afterPreStep();
-        void afterPostStep();
         void afterPostSim();
         void syncWithMainThread();
         void waitForWorkers();
@@ -96,31 +130,49 @@ namespace MWPhysics
         std::vector<Simulation>* mSimulations = nullptr;
         std::unordered_set<const btCollisionObject*> mCollisionObjects;
         float mDefaultPhysicsDt;
+        // Never lengthen steps to catch up, drop the time that doesn't fit into the allowed steps instead
+        const bool mFixedRate;
         float mPhysicsDt;
         float mTimeAccum;
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
-        std::vector<LOSRequest> mLOSCache;
+        // Only the main thread adds and removes requests, so lookups need no lock. Physics threads update the
+        // requests listed in mLOSRefresh, whose addresses are stable until the next prepareWork.
+        std::unordered_map<LOSKey, LOSRequest, LOSKeyHash> mLOSCache;
+        std::vector<LOSRequest*> mLOSRefresh;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
-
-        // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
-        std::unique_ptr<Misc::Barrier> mPreStepBarrier;
-        std::unique_ptr<Misc::Barrier> mPostStepBarrier;
-        std::unique_ptr<Misc::Barrier> mPostSimBarrier;
+        // Used by the thread running the serial part of a step
+        AabbBatch mAabbBatch;
+        HeightFieldQueries mTerrainQueries;
+        // Guarded by mCollisionWorldMutex like the collision objects
+        HeightFieldQueries::HeightFields mHeightFields;
+        int mHeightFieldCellSize = 0;
+
+        // Each step is unstuck and AABB update on one thread, then actor movement spread over all threads, then
+        // position update on the thread finishing the last movement job. There is no rendezvous of all threads.
+        std::unique_ptr<Misc::WorkStealingRanges> mJobs;
+        std::atomic<int> mPendingJobs;
+        std::atomic<bool> mFirstStepPending;
+        std::atomic<unsigned> mStepGeneration;
+        std::mutex mStepMutex;
+        std::condition_variable mStepPublished;
+        std::atomic<int> mPendingPostSimJobs;
 
         LockingPolicy mLockingPolicy;
         unsigned mNumThreads;
         int mNumJobs;
-        unsigned mRemainingSteps;
+        // Simulations hold actors first, then projectiles. Every actor is a job, projectiles are swept in chunks of
+        // sProjectilesPerJob because a single sweep is too cheap to pay for the job overhead.
+        static constexpr std::size_t sProjectilesPerJob = 16;
+        std::size_t mNumActors;
+        std::atomic<unsigned> mRemainingSteps;
         int mLOSCacheExpiry;
         bool mAdvanceSimulation;
-        std::atomic<int> mNextJob;
         std::atomic<int> mNextLOS;
         std::vector<std::thread> mThreads;
 
         mutable std::shared_mutex mSimulationMutex;
         mutable std::shared_mutex mCollisionWorldMutex;
-        mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
 
         unsigned int mFrameNumber;
@@ -136,6 +188,7 @@ namespace MWPhysics
         osg::Timer_t mFrameStart;
 
         std::unique_ptr<WorkersSync> mWorkersSync;
+        std::unique_ptr<Replay::Recorder> mRecorder;
     };
 
 }
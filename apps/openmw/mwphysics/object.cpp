@@ -106,6 +106,21 @@ namespace MWPhysics
         return mShapeInstance->isAnimated();
     }
 
+    bool Object::hasSimplifiedShape() const
+    {
+        return mShapeInstance->mSimplifiedCollisionShape != nullptr;
+    }
+
+    void Object::setSimplified(bool simplified)
+    {
+        if (simplified == mSimplified || !hasSimplifiedShape())
+            return;
+        mSimplified = simplified;
+        btCollisionShape* shape = simplified ? mShapeInstance->mSimplifiedCollisionShape.get()
+                                             : mShapeInstance->mCollisionShape.get();
+        mTaskScheduler->setCollisionShape(mCollisionObject.get(), shape);
+    }
+
     bool Object::animateCollisionShapes()
     {
         if (mShapeInstance->mAnimatedShapes.empty())
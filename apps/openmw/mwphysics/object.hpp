@@ -43,6 +43,11 @@ namespace MWPhysics
         bool isSolid() const;
         void setSolid(bool solid);
         bool isAnimated() const;
+        bool hasSimplifiedShape() const;
+        bool isSimplified() const { return mSimplified; }
+        /// Collide using the simplified collision shape instead of the full one, see
+        /// Resource::BulletShape::mSimplifiedCollisionShape
+        void setSimplified(bool simplified);
         /// @brief update object shape
         /// @return true if shape changed
         bool animateCollisionShapes();
@@ -59,6 +64,7 @@ namespace MWPhysics
         osg::Quat mRotation;
         bool mScaleUpdatePending = false;
         bool mTransformUpdatePending = false;
+        bool mSimplified = false;
         mutable std::mutex mPositionMutex;
         PhysicsTaskScheduler* mTaskScheduler;
         char mCollidedWith;
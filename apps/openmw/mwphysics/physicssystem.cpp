@@ -1,6 +1,7 @@
 #include "physicssystem.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -8,13 +9,13 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
-#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <BulletCollision/CollisionShapes/btConeShape.h>
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+#include <LinearMath/btAabbUtil2.h>
 
 #include <LinearMath/btQuickprof.h>
 #include <LinearMath/btVector3.h>
@@ -22,9 +23,12 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadmgef.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/constants.hpp>
 #include <components/misc/convert.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
+#include <components/resource/bulletshapedb.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/settings/values.hpp>
@@ -56,6 +60,8 @@
 #include "mtphysics.hpp"
 #include "object.hpp"
 #include "projectile.hpp"
+#include "regionbroadphase.hpp"
+#include "replay.hpp"
 
 namespace
 {
@@ -93,24 +99,51 @@ namespace
 
 namespace MWPhysics
 {
-    PhysicsSystem::PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode)
-        : mPhysicsDt(1.f / 60.f)
+    PhysicsSystem::PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode,
+        const std::filesystem::path& userDataPath)
+        : mPhysicsDt(1.f / Settings::physics().mPhysicsFramerate)
         , mShapeManager(std::make_unique<Resource::BulletShapeManager>(resourceSystem->getVFS(),
               resourceSystem->getSceneManager(), resourceSystem->getNifFileManager(),
               Settings::cells().mCacheExpiryDelay))
         , mResourceSystem(resourceSystem)
         , mDebugDrawEnabled(false)
         , mTimeAccum(0.0f)
+        , mRateTime(0.0f)
+        , mRateSteps(0)
+        , mRateFrames(0)
+        , mPhysicsRate(0.0f)
+        , mRenderRate(0.0f)
+        , mSimulatedActors(0)
+        , mSleepingActors(0)
+        , mCollisionLodDistance(Settings::physics().mCollisionLodDistance)
+        , mCollisionLodSmallObjectSize(Settings::physics().mCollisionLodSmallObjectSize)
+        , mSimplifiedObjects(0)
         , mProjectileId(0)
         , mWaterHeight(0)
         , mWaterEnabled(false)
         , mParentNode(std::move(parentNode))
     {
         mResourceSystem->addResourceManager(mShapeManager.get());
+        mShapeManager->setCreateSimplifiedShapes(mCollisionLodDistance > 0 || mCollisionLodSmallObjectSize > 0);
+
+        if (Settings::physics().mEnableShapeDiskCache)
+        {
+            const std::string path = Files::pathToUnicodeString(userDataPath / "bulletshapes.db");
+            Log(Debug::Info) << "Using " << path << " to store collision shape cache";
+            try
+            {
+                mShapeManager->setShapeDb(
+                    std::make_unique<Resource::BulletShapeDb>(path), Settings::physics().mWriteToShapeDb);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << e.what() << ", collision shape disk cache will be disabled";
+            }
+        }
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
         mDispatcher = std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get());
-        mBroadphase = std::make_unique<btDbvtBroadphase>();
+        mBroadphase = std::make_unique<RegionBroadphase>(Constants::CellSizeInUnits);
 
         mCollisionWorld
             = std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get());
@@ -350,6 +383,19 @@ namespace MWPhysics
         return mTaskScheduler->getLineOfSight(it1->second, it2->second);
     }
 
+    void PhysicsSystem::requestLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const
+    {
+        if (actor1 == actor2)
+            return;
+
+        const auto it1 = mActors.find(actor1.mRef);
+        const auto it2 = mActors.find(actor2.mRef);
+        if (it1 == mActors.end() || it2 == mActors.end())
+            return;
+
+        mTaskScheduler->requestLineOfSight(it1->second, it2->second);
+    }
+
     bool PhysicsSystem::isOnGround(const MWWorld::Ptr& actor)
     {
         Actor* physactor = getActor(actor);
@@ -453,7 +499,15 @@ namespace MWPhysics
     {
         HeightFieldMap::iterator heightfield = mHeightFields.find(std::make_pair(x, y));
         if (heightfield != mHeightFields.end())
+        {
+            // Anything standing above the terrain may have been supported by it
+            btVector3 aabbMin;
+            btVector3 aabbMax;
+            mTaskScheduler->getAabb(heightfield->second->getCollisionObject(), aabbMin, aabbMax);
+            aabbMax.setZ(std::numeric_limits<btScalar>::max());
+            wakeUpActors(aabbMin, aabbMax, MWWorld::ConstPtr());
             mHeightFields.erase(heightfield);
+        }
     }
 
     const HeightField* PhysicsSystem::getHeightField(int x, int y) const
@@ -497,6 +551,8 @@ namespace MWPhysics
 
         if (obj->isAnimated())
             mAnimatedObjects.emplace(obj.get(), false);
+        else if (mCollisionLodPosition.has_value())
+            updateCollisionLod(*obj, *mCollisionLodPosition);
     }
 
     void PhysicsSystem::remove(const MWWorld::Ptr& ptr)
@@ -504,6 +560,9 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
             mAnimatedObjects.erase(foundObject->second.get());
+            if (foundObject->second->isSimplified())
+                --mSimplifiedObjects;
+            wakeUpActors(*foundObject->second);
 
             mObjects.erase(foundObject);
         }
@@ -577,8 +636,10 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
             float scale = ptr.getCellRef().getScale();
+            wakeUpActors(*foundObject->second);
             foundObject->second->setScale(scale);
             mTaskScheduler->updateSingleAabb(foundObject->second);
+            wakeUpActors(*foundObject->second);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
@@ -591,8 +652,10 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            wakeUpActors(*foundObject->second);
             foundObject->second->setRotation(rotate);
             mTaskScheduler->updateSingleAabb(foundObject->second);
+            wakeUpActors(*foundObject->second);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
@@ -608,8 +671,10 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            wakeUpActors(*foundObject->second);
             foundObject->second->updatePosition();
             mTaskScheduler->updateSingleAabb(foundObject->second);
+            wakeUpActors(*foundObject->second);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
@@ -705,6 +770,8 @@ namespace MWPhysics
     {
         assert(simulations.empty());
         simulations.reserve(mActors.size() + mProjectiles.size());
+        mSimulatedActors = 0;
+        mSleepingActors = 0;
         const MWBase::World* world = MWBase::Environment::get().getWorld();
         for (const auto& [ref, physicActor] : mActors)
         {
@@ -738,8 +805,16 @@ namespace MWPhysics
             const bool inert = stats.isDead()
                 || (!godmode && stats.getMagicEffects().getOrDefault(ESM::MagicEffect::Paralyze).getModifier() > 0);
 
-            simulations.emplace_back(ActorSimulation{
-                physicActor, ActorFrameData{ *physicActor, inert, waterCollision, slowFall, waterlevel, isPlayer } });
+            ActorFrameData frameData{ *physicActor, inert, waterCollision, slowFall, waterlevel, isPlayer };
+            // The player is never put to sleep to not delay reacting to input
+            if (willSimulate)
+                physicActor->updateSleep(!isPlayer && isIdle(*physicActor, frameData));
+            frameData.mSleeping = physicActor->isSleeping();
+            ++mSimulatedActors;
+            if (frameData.mSleeping)
+                ++mSleepingActors;
+
+            simulations.emplace_back(ActorSimulation{ physicActor, std::move(frameData) });
 
             // if the simulation will run, a jump request will be fulfilled. Update mechanics accordingly.
             if (willSimulate)
@@ -752,9 +827,106 @@ namespace MWPhysics
         }
     }
 
+    bool PhysicsSystem::isIdle(const Actor& actor, const ActorFrameData& frameData) const
+    {
+        if (frameData.mMovement.length2() != 0 || !frameData.mIsOnGround || frameData.mIsOnSlope
+            || frameData.mFlying || frameData.mSkipCollisionDetection || actor.getInertialForce().length2() != 0)
+            return false;
+
+        // Wait for the last step to not have moved the actor, so it settles on the ground before sleeping
+        const osg::Vec3d position = actor.getPosition();
+        if (position != actor.getPreviousPosition() || position.z() < frameData.mSwimLevel)
+            return false;
+
+        // Doors and platforms can push or carry the actor
+        const btCollisionObject* collisionObject = actor.getCollisionObject();
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        collisionObject->getCollisionShape()->getAabb(collisionObject->getWorldTransform(), aabbMin, aabbMax);
+        for (const auto& [movedMin, movedMax] : mMovedAnimatedAabbs)
+            if (TestAabbAgainstAabb2(aabbMin, aabbMax, movedMin, movedMax))
+                return false;
+
+        return true;
+    }
+
+    void PhysicsSystem::wakeUpActors(const PtrHolder& object)
+    {
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        mTaskScheduler->getAabb(object.getCollisionObject(), aabbMin, aabbMax);
+        wakeUpActors(aabbMin, aabbMax, object.getPtr());
+    }
+
+    void PhysicsSystem::wakeUpActors(
+        const btVector3& changedMin, const btVector3& changedMax, const MWWorld::ConstPtr& ptr)
+    {
+        for (const auto& [_, actor] : mActors)
+        {
+            if (!actor->isSleeping())
+                continue;
+            if (!ptr.isEmpty() && actor->getStandingOnPtr() == ptr)
+            {
+                actor->wakeUp();
+                continue;
+            }
+            btVector3 actorMin;
+            btVector3 actorMax;
+            mTaskScheduler->getAabb(actor->getCollisionObject(), actorMin, actorMax);
+            if (Actor::isDisturbedBy(actorMin, actorMax, changedMin, changedMax))
+                actor->wakeUp();
+        }
+    }
+
+    void PhysicsSystem::updateCollisionLod()
+    {
+        // Switching shapes needs the collision world lock, so don't reevaluate every frame
+        constexpr float updateDistance = 256;
+
+        if (mCollisionLodDistance <= 0 && mCollisionLodSmallObjectSize <= 0)
+            return;
+        const MWWorld::Ptr player = MWMechanics::getPlayer();
+        if (player.isEmpty())
+            return;
+        const osg::Vec3f playerPosition = player.getRefData().getPosition().asVec3();
+        if (mCollisionLodPosition.has_value()
+            && (playerPosition - *mCollisionLodPosition).length2() < updateDistance * updateDistance)
+            return;
+        mCollisionLodPosition = playerPosition;
+        for (auto& [_, object] : mObjects)
+            if (!object->isAnimated())
+                updateCollisionLod(*object, playerPosition);
+    }
+
+    void PhysicsSystem::updateCollisionLod(Object& object, const osg::Vec3f& playerPosition)
+    {
+        if (!object.hasSimplifiedShape())
+            return;
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        mTaskScheduler->getAabb(object.getCollisionObject(), aabbMin, aabbMax);
+        const float size = (aabbMax - aabbMin).length();
+        const osg::Vec3f center = Misc::Convert::toOsg((aabbMin + aabbMax) / 2);
+        // Distance to the bounding sphere, so large objects keep their full shapes while the player is close to any
+        // part of them
+        const float distance = (center - playerPosition).length() - size / 2;
+        const bool simplified = (mCollisionLodSmallObjectSize > 0 && size < mCollisionLodSmallObjectSize)
+            || (mCollisionLodDistance > 0 && distance > mCollisionLodDistance);
+        if (simplified == object.isSimplified())
+            return;
+        // The shapes differ in detail, an actor resting on one may not be supported by the other
+        wakeUpActors(object);
+        object.setSimplified(simplified);
+        if (simplified)
+            ++mSimplifiedObjects;
+        else
+            --mSimplifiedObjects;
+    }
+
     void PhysicsSystem::stepSimulation(
         float dt, bool skipSimulation, osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
     {
+        mMovedAnimatedAabbs.clear();
         for (auto& [animatedObject, changed] : mAnimatedObjects)
         {
             if (animatedObject->animateCollisionShapes())
@@ -763,6 +935,12 @@ namespace MWPhysics
                 assert(obj != mObjects.end());
                 mTaskScheduler->updateSingleAabb(obj->second);
                 changed = true;
+                const btCollisionObject* collisionObject = animatedObject->getCollisionObject();
+                btVector3 aabbMin;
+                btVector3 aabbMax;
+                collisionObject->getCollisionShape()->getAabb(
+                    collisionObject->getWorldTransform(), aabbMin, aabbMax);
+                mMovedAnimatedAabbs.emplace_back(aabbMin, aabbMax);
             }
             else
             {
@@ -772,6 +950,8 @@ namespace MWPhysics
         for (auto& [_, object] : mObjects)
             object->resetCollisions();
 
+        updateCollisionLod();
+
 #ifndef BT_NO_PROFILE
         CProfileManager::Reset();
         CProfileManager::Increment_Frame_Counter();
@@ -787,6 +967,18 @@ namespace MWPhysics
             prepareSimulation(mTimeAccum >= mPhysicsDt, simulations);
             // modifies mTimeAccum
             mTaskScheduler->applyQueuedMovements(mTimeAccum, simulations, frameStart, frameNumber, stats);
+            mRateSteps += mTaskScheduler->getStepCount();
+        }
+
+        mRateTime += dt;
+        ++mRateFrames;
+        if (mRateTime >= 1.0f)
+        {
+            mPhysicsRate = mRateSteps / mRateTime;
+            mRenderRate = mRateFrames / mRateTime;
+            mRateTime = 0.0f;
+            mRateSteps = 0;
+            mRateFrames = 0;
         }
     }
 
@@ -929,6 +1121,12 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Objects", static_cast<double>(mObjects.size()));
         stats.setAttribute(frameNumber, "Physics Projectiles", static_cast<double>(mProjectiles.size()));
         stats.setAttribute(frameNumber, "Physics HeightFields", static_cast<double>(mHeightFields.size()));
+        stats.setAttribute(
+            frameNumber, "Physics Active Actors", static_cast<double>(mSimulatedActors - mSleepingActors));
+        stats.setAttribute(frameNumber, "Physics Sleeping Actors", static_cast<double>(mSleepingActors));
+        stats.setAttribute(frameNumber, "Physics Rate", mPhysicsRate);
+        stats.setAttribute(frameNumber, "Physics Render Rate", mRenderRate);
+        stats.setAttribute(frameNumber, "Physics Simplified Objects", static_cast<double>(mSimplifiedObjects));
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -966,6 +1164,36 @@ namespace MWPhysics
         , mWaterCollision(waterCollision)
         , mSkipCollisionDetection(!actor.getCollisionMode())
         , mIsPlayer(isPlayer)
+        , mSleeping(false)
+    {
+    }
+
+    ActorFrameData::ActorFrameData(
+        const Replay::ActorInput& input, btCollisionObject* collisionObject, const btCollisionObject* standingOn)
+        : mPosition(input.mPosition)
+        , mInertia(input.mInertia)
+        , mStandingOn(standingOn)
+        , mIsOnGround(input.mIsOnGround)
+        , mIsOnSlope(input.mIsOnSlope)
+        , mWalkingOnWater(false)
+        , mInert(input.mInert)
+        , mCollisionObject(collisionObject)
+        , mSwimLevel(input.mSwimLevel)
+        , mSlowFall(input.mSlowFall)
+        , mRotation(input.mRotation)
+        , mMovement(input.mMovement)
+        , mLastStuckPosition(input.mLastStuckPosition)
+        , mWaterlevel(input.mWaterlevel)
+        , mHalfExtentsZ(input.mHalfExtentsZ)
+        , mOldHeight(input.mOldHeight)
+        , mStuckFrames(input.mStuckFrames)
+        , mFlying(input.mFlying)
+        , mWasOnGround(input.mWasOnGround)
+        , mIsAquatic(input.mIsAquatic)
+        , mWaterCollision(input.mWaterCollision)
+        , mSkipCollisionDetection(input.mSkipCollisionDetection)
+        , mIsPlayer(input.mIsPlayer)
+        , mSleeping(false)
     {
     }
 
@@ -984,31 +1212,24 @@ namespace MWPhysics
     {
     }
 
+    WorldFrameData::WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection)
+        : mIsInStorm(isInStorm)
+        , mStormDirection(stormDirection)
+    {
+    }
+
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
         : mResult(false)
-        , mStale(false)
+        , mReady(false)
         , mAge(0)
     {
-        // we use raw actor pointer pair to uniquely identify request
-        // sort the pointer value in ascending order to not duplicate equivalent requests, eg. getLOS(A, B) and
-        // getLOS(B, A)
+        // Sorted by address, so getLOS(A, B) and getLOS(B, A) cast the same ray
         auto* raw1 = a1.lock().get();
         auto* raw2 = a2.lock().get();
         assert(raw1 != raw2);
         if (raw1 < raw2)
-        {
             mActors = { a1, a2 };
-            mRawActors = { raw1, raw2 };
-        }
         else
-        {
             mActors = { a2, a1 };
-            mRawActors = { raw2, raw1 };
-        }
-    }
-
-    bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept
-    {
-        return lhs.mRawActors == rhs.mRawActors;
     }
 }
@@ -3,19 +3,25 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <filesystem>
 #include <functional>
 #include <map>
 #include <memory>
 #include <optional>
 #include <span>
 #include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include <osg/BoundingBox>
 #include <osg/Quat>
 #include <osg/Timer>
 #include <osg/ref_ptr>
 
+#include <LinearMath/btVector3.h>
+
 #include <components/vfs/pathutil.hpp>
 
 #include "../mwworld/ptr.hpp"
@@ -47,7 +53,6 @@ class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 class btCollisionObject;
 class btCollisionShape;
-class btVector3;
 
 namespace MWPhysics
 {
@@ -56,8 +61,14 @@ namespace MWPhysics
     class Actor;
     class PhysicsTaskScheduler;
     class Projectile;
+    class PtrHolder;
     enum ScriptedCollisionType : char;
 
+    namespace Replay
+    {
+        struct ActorInput;
+    }
+
     using ActorMap = std::unordered_map<const MWWorld::LiveCellRefBase*, std::shared_ptr<Actor>>;
 
     struct ContactPoint
@@ -71,16 +82,17 @@ namespace MWPhysics
     {
         LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2);
         std::array<std::weak_ptr<Actor>, 2> mActors;
-        std::array<const Actor*, 2> mRawActors;
-        bool mResult;
-        bool mStale;
-        int mAge;
+        // Written by the physics threads refreshing the request while the main thread reads it
+        std::atomic<bool> mResult;
+        std::atomic<bool> mReady;
+        std::atomic<int> mAge;
     };
-    bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
 
     struct ActorFrameData
     {
         ActorFrameData(Actor& actor, bool inert, bool waterCollision, float slowFall, float waterlevel, bool isPlayer);
+        ActorFrameData(
+            const Replay::ActorInput& input, btCollisionObject* collisionObject, const btCollisionObject* standingOn);
         osg::Vec3f mPosition;
         osg::Vec3f mInertia;
         const btCollisionObject* mStandingOn;
@@ -104,6 +116,7 @@ namespace MWPhysics
         const bool mWaterCollision;
         const bool mSkipCollisionDetection;
         const bool mIsPlayer;
+        bool mSleeping;
     };
 
     struct ProjectileFrameData
@@ -119,6 +132,7 @@ namespace MWPhysics
     struct WorldFrameData
     {
         WorldFrameData();
+        WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection);
         bool mIsInStorm;
         osg::Vec3f mStormDirection;
     };
@@ -152,7 +166,8 @@ namespace MWPhysics
     class PhysicsSystem : public RayCastingInterface
     {
     public:
-        PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode);
+        PhysicsSystem(Resource::ResourceSystem* resourceSystem, osg::ref_ptr<osg::Group> parentNode,
+            const std::filesystem::path& userDataPath);
         virtual ~PhysicsSystem();
 
         Resource::BulletShapeManager* getShapeManager();
@@ -228,6 +243,10 @@ namespace MWPhysics
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
+        /// Test line of sight between both actors on the physics threads, so the next getLineOfSight gets it from the
+        /// cache. Expires unless read.
+        void requestLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const;
+
         bool isOnGround(const MWWorld::Ptr& actor);
 
         bool canMoveToWaterSurface(const MWWorld::ConstPtr& actor, const float waterlevel);
@@ -300,6 +319,15 @@ namespace MWPhysics
 
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        bool isIdle(const Actor& actor, const ActorFrameData& frameData) const;
+
+        /// Wake up the sleeping actors that stand on or touch the object, before and after it changes
+        void wakeUpActors(const PtrHolder& object);
+        void wakeUpActors(const btVector3& changedMin, const btVector3& changedMax, const MWWorld::ConstPtr& ptr);
+
+        void updateCollisionLod();
+        void updateCollisionLod(Object& object, const osg::Vec3f& playerPosition);
+
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
@@ -313,6 +341,8 @@ namespace MWPhysics
         ObjectMap mObjects;
 
         std::map<Object*, bool> mAnimatedObjects; // stores pointers to elements in mObjects
+        // AABBs of animated objects that moved this frame, they wake up the actors they touch
+        std::vector<std::pair<btVector3, btVector3>> mMovedAnimatedAabbs;
 
         ActorMap mActors;
 
@@ -326,6 +356,23 @@ namespace MWPhysics
 
         float mTimeAccum;
 
+        // Simulated steps and rendered frames over the last second, reported as rates in stats
+        float mRateTime;
+        unsigned mRateSteps;
+        unsigned mRateFrames;
+        float mPhysicsRate;
+        float mRenderRate;
+
+        std::size_t mSimulatedActors;
+        std::size_t mSleepingActors;
+
+        // Objects farther from the player than the distance or smaller than the size collide using their simplified
+        // shapes. Reevaluated once the player moved far enough from the last position used.
+        const float mCollisionLodDistance;
+        const float mCollisionLodSmallObjectSize;
+        std::optional<osg::Vec3f> mCollisionLodPosition;
+        std::size_t mSimplifiedObjects;
+
         unsigned int mProjectileId;
 
         float mWaterHeight;
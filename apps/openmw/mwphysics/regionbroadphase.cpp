@@ -0,0 +1,210 @@
+#include "regionbroadphase.hpp"
+
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <LinearMath/btAabbUtil2.h>
+
+#include <cassert>
+#include <cmath>
+
+namespace MWPhysics
+{
+    RegionBroadphase::Region::Region(const RegionKey& key, btOverlappingPairCache* pairCache)
+        : mKey(key)
+        , mBroadphase(pairCache)
+    {
+        // Collide new and moved proxies with others only when pairs are calculated, which never happens
+        mBroadphase.m_deferedcollide = true;
+    }
+
+    bool RegionBroadphase::Region::getBounds(btVector3& aabbMin, btVector3& aabbMax) const
+    {
+        bool result = false;
+        for (const btDbvt& set : mBroadphase.m_sets)
+        {
+            if (set.m_root == nullptr)
+                continue;
+            if (!result)
+            {
+                aabbMin = set.m_root->volume.Mins();
+                aabbMax = set.m_root->volume.Maxs();
+                result = true;
+                continue;
+            }
+            aabbMin.setMin(set.m_root->volume.Mins());
+            aabbMax.setMax(set.m_root->volume.Maxs());
+        }
+        return result;
+    }
+
+    RegionBroadphase::RegionBroadphase(float regionSize)
+        : mRegionSize(regionSize)
+    {
+    }
+
+    RegionBroadphase::~RegionBroadphase() = default;
+
+#if BT_BULLET_VERSION < 287
+    btBroadphaseProxy* RegionBroadphase::createProxy(const btVector3& aabbMin, const btVector3& aabbMax,
+        int shapeType, void* userPtr, short collisionFilterGroup, short collisionFilterMask, btDispatcher* dispatcher,
+        void* /*multiSapProxy*/)
+#else
+    btBroadphaseProxy* RegionBroadphase::createProxy(const btVector3& aabbMin, const btVector3& aabbMax,
+        int shapeType, void* userPtr, int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher)
+#endif
+    {
+        return addProxy(aabbMin, aabbMax, shapeType, userPtr, collisionFilterGroup, collisionFilterMask, dispatcher);
+    }
+
+    void RegionBroadphase::destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher)
+    {
+        removeProxy(proxy, dispatcher);
+    }
+
+    void RegionBroadphase::setAabb(
+        btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher* dispatcher)
+    {
+        Region& region = *mProxyRegions.at(proxy);
+        if (!isOutsideRegion(region, aabbMin, aabbMax))
+        {
+            region.mBroadphase.setAabb(proxy, aabbMin, aabbMax, dispatcher);
+            return;
+        }
+
+        // Move to the tree of the region the object is in now. Proxies are owned by the trees, so the collision
+        // object gets a new one.
+        btCollisionObject* const collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        const int shapeType = proxy->getShapeType();
+        const int collisionFilterGroup = proxy->m_collisionFilterGroup;
+        const int collisionFilterMask = proxy->m_collisionFilterMask;
+        removeProxy(proxy, dispatcher);
+        btBroadphaseProxy* const moved = addProxy(
+            aabbMin, aabbMax, shapeType, collisionObject, collisionFilterGroup, collisionFilterMask, dispatcher);
+        collisionObject->setBroadphaseHandle(moved);
+    }
+
+    void RegionBroadphase::getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const
+    {
+        mProxyRegions.at(proxy)->mBroadphase.getAabb(proxy, aabbMin, aabbMax);
+    }
+
+    void RegionBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo,
+        btBroadphaseRayCallback& rayCallback, const btVector3& aabbMin, const btVector3& aabbMax)
+    {
+        btVector3 rayMin = rayFrom;
+        btVector3 rayMax = rayFrom;
+        rayMin.setMin(rayTo);
+        rayMax.setMax(rayTo);
+        forEachRegion(rayMin + aabbMin, rayMax + aabbMax, [&](Region& region) {
+            region.mBroadphase.rayTest(rayFrom, rayTo, rayCallback, aabbMin, aabbMax);
+        });
+    }
+
+    void RegionBroadphase::aabbTest(
+        const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback)
+    {
+        forEachRegion(
+            aabbMin, aabbMax, [&](Region& region) { region.mBroadphase.aabbTest(aabbMin, aabbMax, callback); });
+    }
+
+    void RegionBroadphase::calculateOverlappingPairs(btDispatcher* dispatcher)
+    {
+        for (const auto& [key, region] : mRegions)
+            region->mBroadphase.calculateOverlappingPairs(dispatcher);
+    }
+
+    void RegionBroadphase::getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const
+    {
+        bool found = false;
+        for (const auto& [key, region] : mRegions)
+        {
+            btVector3 regionMin;
+            btVector3 regionMax;
+            if (!region->getBounds(regionMin, regionMax))
+                continue;
+            if (!found)
+            {
+                aabbMin = regionMin;
+                aabbMax = regionMax;
+                found = true;
+                continue;
+            }
+            aabbMin.setMin(regionMin);
+            aabbMax.setMax(regionMax);
+        }
+        if (!found)
+        {
+            aabbMin.setValue(0, 0, 0);
+            aabbMax.setValue(0, 0, 0);
+        }
+    }
+
+    void RegionBroadphase::resetPool(btDispatcher* dispatcher)
+    {
+        for (const auto& [key, region] : mRegions)
+            region->mBroadphase.resetPool(dispatcher);
+    }
+
+    RegionBroadphase::RegionKey RegionBroadphase::getRegionKey(
+        const btVector3& aabbMin, const btVector3& aabbMax) const
+    {
+        const btVector3 center = (aabbMin + aabbMax) / 2;
+        return RegionKey(static_cast<int>(std::floor(center.x() / mRegionSize)),
+            static_cast<int>(std::floor(center.y() / mRegionSize)));
+    }
+
+    bool RegionBroadphase::isOutsideRegion(
+        const Region& region, const btVector3& aabbMin, const btVector3& aabbMax) const
+    {
+        // Objects moving along a region border shouldn't jump between trees back and forth
+        const float margin = mRegionSize / 4;
+        const btVector3 center = (aabbMin + aabbMax) / 2;
+        const float minX = region.mKey.first * mRegionSize - margin;
+        const float minY = region.mKey.second * mRegionSize - margin;
+        const float maxX = (region.mKey.first + 1) * mRegionSize + margin;
+        const float maxY = (region.mKey.second + 1) * mRegionSize + margin;
+        return center.x() < minX || center.y() < minY || center.x() > maxX || center.y() > maxY;
+    }
+
+    btBroadphaseProxy* RegionBroadphase::addProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType,
+        void* userPtr, int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher)
+    {
+        const RegionKey key = getRegionKey(aabbMin, aabbMax);
+        std::unique_ptr<Region>& region = mRegions[key];
+        if (region == nullptr)
+            region = std::make_unique<Region>(key, &mPairCache);
+#if BT_BULLET_VERSION < 287
+        btBroadphaseProxy* const proxy = region->mBroadphase.createProxy(aabbMin, aabbMax, shapeType, userPtr,
+            static_cast<short>(collisionFilterGroup), static_cast<short>(collisionFilterMask), dispatcher, nullptr);
+#else
+        btBroadphaseProxy* const proxy = region->mBroadphase.createProxy(
+            aabbMin, aabbMax, shapeType, userPtr, collisionFilterGroup, collisionFilterMask, dispatcher);
+#endif
+        ++region->mProxyCount;
+        mProxyRegions.emplace(proxy, region.get());
+        return proxy;
+    }
+
+    void RegionBroadphase::removeProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher)
+    {
+        const auto it = mProxyRegions.find(proxy);
+        assert(it != mProxyRegions.end());
+        Region& region = *it->second;
+        mProxyRegions.erase(it);
+        region.mBroadphase.destroyProxy(proxy, dispatcher);
+        assert(region.mProxyCount > 0);
+        if (--region.mProxyCount == 0)
+            mRegions.erase(region.mKey);
+    }
+
+    template <class Function>
+    void RegionBroadphase::forEachRegion(const btVector3& aabbMin, const btVector3& aabbMax, Function&& function) const
+    {
+        for (const auto& [key, region] : mRegions)
+        {
+            btVector3 regionMin;
+            btVector3 regionMax;
+            if (region->getBounds(regionMin, regionMax) && TestAabbAgainstAabb2(aabbMin, aabbMax, regionMin, regionMax))
+                function(*region);
+        }
+    }
+}
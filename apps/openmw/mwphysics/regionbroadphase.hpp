@@ -0,0 +1,86 @@
+#ifndef OPENMW_MWPHYSICS_REGIONBROADPHASE_H
+#define OPENMW_MWPHYSICS_REGIONBROADPHASE_H
+
+#include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/BroadphaseCollision/btOverlappingPairCache.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace MWPhysics
+{
+    /// Broadphase made of a btDbvtBroadphase per square region of the world, so adding, moving and removing objects
+    /// only touches the tree of their region and queries skip regions they don't reach. A region is created with its
+    /// first object and dropped with its last one, so regions follow the loaded cells.
+    /// Overlapping pairs are never computed, collision world queries don't use them.
+    class RegionBroadphase final : public btBroadphaseInterface
+    {
+    public:
+        explicit RegionBroadphase(float regionSize);
+        ~RegionBroadphase() override;
+
+        std::size_t getRegionCount() const { return mRegions.size(); }
+
+#if BT_BULLET_VERSION < 287
+        btBroadphaseProxy* createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType,
+            void* userPtr, short collisionFilterGroup, short collisionFilterMask, btDispatcher* dispatcher,
+            void* multiSapProxy) override;
+#else
+        btBroadphaseProxy* createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType,
+            void* userPtr, int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher) override;
+#endif
+        void destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher) override;
+        void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax,
+            btDispatcher* dispatcher) override;
+        void getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const override;
+
+        void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback,
+            const btVector3& aabbMin = btVector3(0, 0, 0), const btVector3& aabbMax = btVector3(0, 0, 0)) override;
+        void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback) override;
+
+        void calculateOverlappingPairs(btDispatcher* dispatcher) override;
+        btOverlappingPairCache* getOverlappingPairCache() override { return &mPairCache; }
+        const btOverlappingPairCache* getOverlappingPairCache() const override { return &mPairCache; }
+        void getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const override;
+        void resetPool(btDispatcher* dispatcher) override;
+        void printStats() override {}
+
+    private:
+        using RegionKey = std::pair<int, int>;
+
+        struct Region
+        {
+            RegionKey mKey;
+            btDbvtBroadphase mBroadphase;
+            std::size_t mProxyCount = 0;
+
+            Region(const RegionKey& key, btOverlappingPairCache* pairCache);
+
+            /// @return false if the region has no objects
+            bool getBounds(btVector3& aabbMin, btVector3& aabbMax) const;
+        };
+
+        const float mRegionSize;
+        btNullPairCache mPairCache;
+        std::map<RegionKey, std::unique_ptr<Region>> mRegions;
+        std::unordered_map<const btBroadphaseProxy*, Region*> mProxyRegions;
+
+        RegionKey getRegionKey(const btVector3& aabbMin, const btVector3& aabbMax) const;
+
+        bool isOutsideRegion(const Region& region, const btVector3& aabbMin, const btVector3& aabbMax) const;
+
+        btBroadphaseProxy* addProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType, void* userPtr,
+            int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher);
+
+        void removeProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher);
+
+        template <class Function>
+        void forEachRegion(const btVector3& aabbMin, const btVector3& aabbMax, Function&& function) const;
+    };
+}
+
+#endif
@@ -0,0 +1,596 @@
+#include "replay.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btCylinderShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <components/misc/constants.hpp>
+#include <components/misc/convert.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include "collisiontype.hpp"
+#include "regionbroadphase.hpp"
+
+namespace MWPhysics::Replay
+{
+    namespace
+    {
+        constexpr char replayMagic[] = { 'O', 'M', 'W', 'P', 'H', 'Y', 'S', 'R' };
+        constexpr std::uint32_t replayVersion = 1;
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, osg::Vec2f>>
+            {
+                visitor(*this, value.ptr(), 2);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, osg::Vec3f>>
+            {
+                visitor(*this, value.ptr(), 3);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CompoundChild>>
+            {
+                visitor(*this, value.mShape);
+                visitor(*this, value.mTransform);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Shape>>
+            {
+                visitor(*this, value.mId);
+                visitor(*this, value.mType);
+                visitor(*this, value.mDimensions);
+                visitor(*this, value.mUpAxis);
+                visitor(*this, value.mMargin);
+                visitor(*this, value.mLocalScaling);
+                visitor(*this, value.mPoints);
+                visitor(*this, value.mChildren);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CollisionObject>>
+            {
+                visitor(*this, value.mId);
+                visitor(*this, value.mShape);
+                visitor(*this, value.mGroup);
+                visitor(*this, value.mMask);
+                visitor(*this, value.mFlags);
+                visitor(*this, value.mTransform);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ActorInput>>
+            {
+                visitor(*this, value.mCollisionObject);
+                visitor(*this, value.mStandingOn);
+                visitor(*this, value.mPosition);
+                visitor(*this, value.mCollisionObjectOffset);
+                visitor(*this, value.mInertia);
+                visitor(*this, value.mRotation);
+                visitor(*this, value.mMovement);
+                visitor(*this, value.mLastStuckPosition);
+                visitor(*this, value.mSwimLevel);
+                visitor(*this, value.mSlowFall);
+                visitor(*this, value.mWaterlevel);
+                visitor(*this, value.mHalfExtentsZ);
+                visitor(*this, value.mOldHeight);
+                visitor(*this, value.mStuckFrames);
+                visitor(*this, value.mIsOnGround);
+                visitor(*this, value.mIsOnSlope);
+                visitor(*this, value.mInert);
+                visitor(*this, value.mFlying);
+                visitor(*this, value.mWasOnGround);
+                visitor(*this, value.mIsAquatic);
+                visitor(*this, value.mWaterCollision);
+                visitor(*this, value.mSkipCollisionDetection);
+                visitor(*this, value.mIsPlayer);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Frame>>
+            {
+                visitor(*this, value.mNumSteps);
+                visitor(*this, value.mPhysicsDt);
+                visitor(*this, value.mIsInStorm);
+                visitor(*this, value.mStormDirection);
+                visitor(*this, value.mNewShapes);
+                visitor(*this, value.mRemovedObjects);
+                visitor(*this, value.mUpdatedObjects);
+                visitor(*this, value.mActors);
+            }
+        };
+
+        Transform toTransform(const btTransform& value)
+        {
+            Transform result;
+            const btMatrix3x3& basis = value.getBasis();
+            for (int row = 0; row < 3; ++row)
+                for (int column = 0; column < 3; ++column)
+                    result[row * 3 + column] = static_cast<float>(basis[row][column]);
+            for (int i = 0; i < 3; ++i)
+                result[9 + i] = static_cast<float>(value.getOrigin()[i]);
+            return result;
+        }
+
+        btTransform toBullet(const Transform& value)
+        {
+            const btMatrix3x3 basis(value[0], value[1], value[2], value[3], value[4], value[5], value[6], value[7],
+                value[8]);
+            return btTransform(basis, btVector3(value[9], value[10], value[11]));
+        }
+
+        struct TriangleCollector : btTriangleCallback
+        {
+            std::vector<float>& mPoints;
+
+            explicit TriangleCollector(std::vector<float>& points)
+                : mPoints(points)
+            {
+            }
+
+            void processTriangle(btVector3* triangle, int /*partId*/, int /*triangleIndex*/) override
+            {
+                for (int i = 0; i < 3; ++i)
+                    for (int axis = 0; axis < 3; ++axis)
+                        mPoints.push_back(static_cast<float>(triangle[i][axis]));
+            }
+        };
+    }
+
+    bool operator==(const CollisionObject& lhs, const CollisionObject& rhs)
+    {
+        return lhs.mId == rhs.mId && lhs.mShape == rhs.mShape && lhs.mGroup == rhs.mGroup && lhs.mMask == rhs.mMask
+            && lhs.mFlags == rhs.mFlags && lhs.mTransform == rhs.mTransform;
+    }
+
+    Writer::Writer(const std::filesystem::path& path)
+        : mStream(path, std::ios::binary)
+    {
+        if (!mStream)
+            throw std::runtime_error("Failed to open physics replay file for writing: " + path.string());
+        mStream.write(replayMagic, sizeof(replayMagic));
+        mStream.write(reinterpret_cast<const char*>(&replayVersion), sizeof(replayVersion));
+    }
+
+    void Writer::write(const Frame& frame)
+    {
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, frame);
+        std::vector<std::byte> buffer(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(buffer.data(), buffer.data() + buffer.size()), frame);
+
+        const std::uint64_t size = buffer.size();
+        mStream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        mStream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        mStream.flush();
+    }
+
+    Reader::Reader(const std::filesystem::path& path)
+        : mStream(path, std::ios::binary)
+    {
+        if (!mStream)
+            throw std::runtime_error("Failed to open physics replay file: " + path.string());
+        char magic[sizeof(replayMagic)];
+        std::uint32_t version = 0;
+        mStream.read(magic, sizeof(magic));
+        mStream.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (!mStream || std::memcmp(magic, replayMagic, sizeof(magic)) != 0)
+            throw std::runtime_error("Not a physics replay file: " + path.string());
+        if (version != replayVersion)
+            throw std::runtime_error("Unsupported physics replay version " + std::to_string(version) + ": "
+                + path.string());
+    }
+
+    bool Reader::read(Frame& frame)
+    {
+        std::uint64_t size = 0;
+        if (!mStream.read(reinterpret_cast<char*>(&size), sizeof(size)))
+            return false;
+        std::vector<std::byte> buffer(static_cast<std::size_t>(size));
+        if (!mStream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+            return false; // Truncated by a crash while recording
+
+        constexpr Format<Serialization::Mode::Read> format;
+        frame = Frame{};
+        Serialization::BinaryReader reader(buffer.data(), buffer.data() + buffer.size());
+        format(reader, frame);
+        return true;
+    }
+
+    Recorder::Recorder(const std::filesystem::path& path)
+        : mWriter(path)
+    {
+    }
+
+    void Recorder::record(const btCollisionWorld& world, std::vector<Simulation>& simulations, unsigned numSteps,
+        float physicsDt, const WorldFrameData& worldData)
+    {
+        Frame frame;
+        frame.mNumSteps = numSteps;
+        frame.mPhysicsDt = physicsDt;
+        frame.mIsInStorm = worldData.mIsInStorm;
+        frame.mStormDirection = worldData.mStormDirection;
+
+        ++mGeneration;
+        const btCollisionObjectArray& objects = world.getCollisionObjectArray();
+        for (int i = 0; i < objects.size(); ++i)
+        {
+            const btCollisionObject* object = objects[i];
+            const btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+            if (proxy == nullptr || proxy->m_collisionFilterGroup == CollisionType_Projectile)
+                continue;
+
+            auto it = mObjects.find(object);
+            if (it == mObjects.end())
+            {
+                it = mObjects.emplace(object, RecordedObject{}).first;
+                it->second.mState.mId = mNextObjectId++;
+            }
+            RecordedObject& recorded = it->second;
+            recorded.mGeneration = mGeneration;
+
+            CollisionObject state;
+            state.mId = recorded.mState.mId;
+            state.mShape = recorded.mState.mShape;
+            if (recorded.mShape != object->getCollisionShape())
+            {
+                releaseShape(recorded.mShape);
+                recorded.mShape = object->getCollisionShape();
+                state.mShape = acquireShape(*recorded.mShape, frame);
+            }
+            state.mGroup = proxy->m_collisionFilterGroup;
+            state.mMask = proxy->m_collisionFilterMask;
+            state.mFlags = object->getCollisionFlags();
+            state.mTransform = toTransform(object->getWorldTransform());
+
+            if (!(state == recorded.mState))
+            {
+                recorded.mState = state;
+                frame.mUpdatedObjects.push_back(state);
+            }
+        }
+
+        for (auto it = mObjects.begin(); it != mObjects.end();)
+        {
+            if (it->second.mGeneration == mGeneration)
+            {
+                ++it;
+                continue;
+            }
+            frame.mRemovedObjects.push_back(it->second.mState.mId);
+            releaseShape(it->second.mShape);
+            it = mObjects.erase(it);
+        }
+
+        const auto findId = [&](const btCollisionObject* object) -> std::uint32_t {
+            const auto it = mObjects.find(object);
+            return it == mObjects.end() ? 0 : it->second.mState.mId;
+        };
+
+        for (Simulation& sim : simulations)
+        {
+            auto* actorSimulation = std::get_if<ActorSimulation>(&sim);
+            if (actorSimulation == nullptr)
+                continue;
+            auto locked = actorSimulation->lock();
+            if (!locked.has_value())
+                continue;
+            const ActorFrameData& data = locked->second.get();
+            ActorInput input;
+            input.mCollisionObject = findId(data.mCollisionObject);
+            if (input.mCollisionObject == 0)
+                continue;
+            input.mStandingOn = findId(data.mStandingOn);
+            input.mPosition = data.mPosition;
+            input.mCollisionObjectOffset
+                = Misc::Convert::toOsg(data.mCollisionObject->getWorldTransform().getOrigin()) - data.mPosition;
+            input.mInertia = data.mInertia;
+            input.mRotation = data.mRotation;
+            input.mMovement = data.mMovement;
+            input.mLastStuckPosition = data.mLastStuckPosition;
+            input.mSwimLevel = data.mSwimLevel;
+            input.mSlowFall = data.mSlowFall;
+            input.mWaterlevel = data.mWaterlevel;
+            input.mHalfExtentsZ = data.mHalfExtentsZ;
+            input.mOldHeight = data.mOldHeight;
+            input.mStuckFrames = data.mStuckFrames;
+            input.mIsOnGround = data.mIsOnGround;
+            input.mIsOnSlope = data.mIsOnSlope;
+            input.mInert = data.mInert;
+            input.mFlying = data.mFlying;
+            input.mWasOnGround = data.mWasOnGround;
+            input.mIsAquatic = data.mIsAquatic;
+            input.mWaterCollision = data.mWaterCollision;
+            input.mSkipCollisionDetection = data.mSkipCollisionDetection;
+            input.mIsPlayer = data.mIsPlayer;
+            frame.mActors.push_back(input);
+        }
+
+        mWriter.write(frame);
+    }
+
+    std::uint32_t Recorder::acquireShape(const btCollisionShape& shape, Frame& frame)
+    {
+        const auto it = mShapes.find(&shape);
+        if (it != mShapes.end())
+        {
+            ++it->second.mUsers;
+            return it->second.mId;
+        }
+        const std::uint32_t id = addShape(shape, frame);
+        mShapes.emplace(&shape, RecordedShape{ id, 1 });
+        return id;
+    }
+
+    void Recorder::releaseShape(const btCollisionShape* shape)
+    {
+        // Forget unused shapes, their address may be reused by a different shape
+        const auto it = mShapes.find(shape);
+        if (it != mShapes.end() && --it->second.mUsers == 0)
+            mShapes.erase(it);
+    }
+
+    std::uint32_t Recorder::addShape(const btCollisionShape& shape, Frame& frame)
+    {
+        Shape result;
+        result.mMargin = static_cast<float>(shape.getMargin());
+        switch (shape.getShapeType())
+        {
+            case BOX_SHAPE_PROXYTYPE:
+                result.mType = ShapeType::Box;
+                result.mDimensions = Misc::Convert::toOsg(static_cast<const btBoxShape&>(shape).getHalfExtentsWithMargin());
+                break;
+            case SPHERE_SHAPE_PROXYTYPE:
+                result.mType = ShapeType::Sphere;
+                result.mDimensions.x() = static_cast<float>(static_cast<const btSphereShape&>(shape).getRadius());
+                break;
+            case CAPSULE_SHAPE_PROXYTYPE:
+            {
+                const auto& capsule = static_cast<const btCapsuleShape&>(shape);
+                result.mType = ShapeType::Capsule;
+                result.mDimensions.x() = static_cast<float>(capsule.getRadius());
+                result.mDimensions.y() = static_cast<float>(capsule.getHalfHeight());
+                result.mUpAxis = capsule.getUpAxis();
+                break;
+            }
+            case CYLINDER_SHAPE_PROXYTYPE:
+            {
+                const auto& cylinder = static_cast<const btCylinderShape&>(shape);
+                result.mType = ShapeType::Cylinder;
+                result.mDimensions = Misc::Convert::toOsg(cylinder.getHalfExtentsWithMargin());
+                result.mUpAxis = cylinder.getUpAxis();
+                break;
+            }
+            case CONVEX_HULL_SHAPE_PROXYTYPE:
+            {
+                const auto& hull = static_cast<const btConvexHullShape&>(shape);
+                result.mType = ShapeType::ConvexHull;
+                result.mLocalScaling = Misc::Convert::toOsg(hull.getLocalScaling());
+                for (int i = 0; i < hull.getNumPoints(); ++i)
+                    for (int axis = 0; axis < 3; ++axis)
+                        result.mPoints.push_back(static_cast<float>(hull.getUnscaledPoints()[i][axis]));
+                break;
+            }
+            case COMPOUND_SHAPE_PROXYTYPE:
+            {
+                const auto& compound = static_cast<const btCompoundShape&>(shape);
+                result.mType = ShapeType::Compound;
+                for (int i = 0; i < compound.getNumChildShapes(); ++i)
+                    result.mChildren.push_back(CompoundChild{ addShape(*compound.getChildShape(i), frame),
+                        toTransform(compound.getChildTransform(i)) });
+                break;
+            }
+            default:
+            {
+                btVector3 aabbMin;
+                btVector3 aabbMax;
+                shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+                if (shape.isConcave())
+                {
+                    // Meshes and heightfields, flattened to triangles with any scaling applied
+                    result.mType = ShapeType::TriangleMesh;
+                    TriangleCollector collector(result.mPoints);
+                    static_cast<const btConcaveShape&>(shape).processAllTriangles(&collector, aabbMin, aabbMax);
+                }
+                else if (shape.isPolyhedral())
+                {
+                    const auto& polyhedron = static_cast<const btPolyhedralConvexShape&>(shape);
+                    result.mType = ShapeType::ConvexHull;
+                    for (int i = 0; i < polyhedron.getNumVertices(); ++i)
+                    {
+                        btVector3 vertex;
+                        polyhedron.getVertex(i, vertex);
+                        for (int axis = 0; axis < 3; ++axis)
+                            result.mPoints.push_back(static_cast<float>(vertex[axis]));
+                    }
+                }
+                else
+                {
+                    result.mType = ShapeType::Box;
+                    result.mDimensions = Misc::Convert::toOsg((aabbMax - aabbMin) * 0.5);
+                }
+                break;
+            }
+        }
+        result.mId = mNextShapeId++;
+        frame.mNewShapes.push_back(std::move(result));
+        return frame.mNewShapes.back().mId;
+    }
+
+    World::World()
+        : mCollisionConfiguration(std::make_unique<btDefaultCollisionConfiguration>())
+        , mDispatcher(std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get()))
+        , mBroadphase(std::make_unique<RegionBroadphase>(Constants::CellSizeInUnits))
+        , mCollisionWorld(
+              std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get()))
+    {
+        mCollisionWorld->setForceUpdateAllAabbs(false);
+    }
+
+    World::~World()
+    {
+        for (const auto& [id, object] : mObjects)
+            mCollisionWorld->removeCollisionObject(object.get());
+    }
+
+    void World::apply(const Frame& frame)
+    {
+        for (const Shape& shape : frame.mNewShapes)
+            createShape(shape);
+
+        for (const std::uint32_t id : frame.mRemovedObjects)
+        {
+            const auto it = mObjects.find(id);
+            if (it == mObjects.end())
+                continue;
+            mCollisionWorld->removeCollisionObject(it->second.get());
+            mObjects.erase(it);
+        }
+
+        for (const CollisionObject& state : frame.mUpdatedObjects)
+        {
+            auto& object = mObjects[state.mId];
+            if (object != nullptr)
+                mCollisionWorld->removeCollisionObject(object.get());
+            else
+                object = std::make_unique<btCollisionObject>();
+            object->setCollisionShape(mShapes.at(state.mShape).get());
+            object->setCollisionFlags(state.mFlags);
+            object->setWorldTransform(toBullet(state.mTransform));
+            mCollisionWorld->addCollisionObject(object.get(), state.mGroup, state.mMask);
+        }
+    }
+
+    std::vector<ActorFrameData> World::makeActorFrameData(const Frame& frame)
+    {
+        std::vector<ActorFrameData> result;
+        result.reserve(frame.mActors.size());
+        for (const ActorInput& input : frame.mActors)
+            result.emplace_back(input, findObject(input.mCollisionObject), findObject(input.mStandingOn));
+        return result;
+    }
+
+    void World::updateActorPosition(const ActorFrameData& data, const ActorInput& input)
+    {
+        btTransform transform = data.mCollisionObject->getWorldTransform();
+        transform.setOrigin(Misc::Convert::toBullet(data.mPosition + input.mCollisionObjectOffset));
+        data.mCollisionObject->setWorldTransform(transform);
+        mCollisionWorld->updateSingleAabb(data.mCollisionObject);
+    }
+
+    btCollisionShape& World::createShape(const Shape& shape)
+    {
+        std::unique_ptr<btCollisionShape> result;
+        switch (shape.mType)
+        {
+            case ShapeType::Box:
+                result = std::make_unique<btBoxShape>(Misc::Convert::toBullet(shape.mDimensions));
+                result->setMargin(shape.mMargin);
+                break;
+            case ShapeType::Sphere:
+                result = std::make_unique<btSphereShape>(shape.mDimensions.x());
+                break;
+            case ShapeType::Capsule:
+                if (shape.mUpAxis == 0)
+                    result = std::make_unique<btCapsuleShapeX>(shape.mDimensions.x(), 2 * shape.mDimensions.y());
+                else if (shape.mUpAxis == 1)
+                    result = std::make_unique<btCapsuleShape>(shape.mDimensions.x(), 2 * shape.mDimensions.y());
+                else
+                    result = std::make_unique<btCapsuleShapeZ>(shape.mDimensions.x(), 2 * shape.mDimensions.y());
+                break;
+            case ShapeType::Cylinder:
+                if (shape.mUpAxis == 0)
+                    result = std::make_unique<btCylinderShapeX>(Misc::Convert::toBullet(shape.mDimensions));
+                else if (shape.mUpAxis == 1)
+                    result = std::make_unique<btCylinderShape>(Misc::Convert::toBullet(shape.mDimensions));
+                else
+                    result = std::make_unique<btCylinderShapeZ>(Misc::Convert::toBullet(shape.mDimensions));
+                result->setMargin(shape.mMargin);
+                break;
+            case ShapeType::ConvexHull:
+            {
+                auto hull = std::make_unique<btConvexHullShape>();
+                for (std::size_t i = 0; i + 2 < shape.mPoints.size(); i += 3)
+                    hull->addPoint(btVector3(shape.mPoints[i], shape.mPoints[i + 1], shape.mPoints[i + 2]), false);
+                hull->recalcLocalAabb();
+                hull->setLocalScaling(Misc::Convert::toBullet(shape.mLocalScaling));
+                hull->setMargin(shape.mMargin);
+                result = std::move(hull);
+                break;
+            }
+            case ShapeType::Compound:
+            {
+                auto compound = std::make_unique<btCompoundShape>();
+                for (const CompoundChild& child : shape.mChildren)
+                    compound->addChildShape(toBullet(child.mTransform), mShapes.at(child.mShape).get());
+                result = std::move(compound);
+                break;
+            }
+            case ShapeType::TriangleMesh:
+            {
+                if (shape.mPoints.size() < 9)
+                {
+                    // Bullet does not support empty triangle meshes
+                    result = std::make_unique<btCompoundShape>();
+                    break;
+                }
+                auto mesh = std::make_unique<btTriangleMesh>();
+                const auto vertex = [&](std::size_t i) {
+                    return btVector3(shape.mPoints[i], shape.mPoints[i + 1], shape.mPoints[i + 2]);
+                };
+                for (std::size_t i = 0; i + 8 < shape.mPoints.size(); i += 9)
+                    mesh->addTriangle(vertex(i), vertex(i + 3), vertex(i + 6));
+                result = std::make_unique<btBvhTriangleMeshShape>(mesh.get(), true);
+                result->setMargin(shape.mMargin);
+                mMeshes.push_back(std::move(mesh));
+                break;
+            }
+        }
+        if (result == nullptr)
+            throw std::runtime_error("Unsupported physics replay shape type: "
+                + std::to_string(static_cast<int>(shape.mType)));
+
+        auto& stored = mShapes[shape.mId];
+        stored = std::move(result);
+        return *stored;
+    }
+
+    btCollisionObject* World::findObject(std::uint32_t id) const
+    {
+        const auto it = mObjects.find(id);
+        return it == mObjects.end() ? nullptr : it->second.get();
+    }
+}
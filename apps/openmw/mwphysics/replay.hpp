@@ -0,0 +1,210 @@
+#ifndef OPENMW_MWPHYSICS_REPLAY_H
+#define OPENMW_MWPHYSICS_REPLAY_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+#include "physicssystem.hpp"
+
+class btBroadphaseInterface;
+class btCollisionConfiguration;
+class btCollisionDispatcher;
+class btCollisionObject;
+class btCollisionShape;
+class btCollisionWorld;
+class btStridingMeshInterface;
+
+namespace MWPhysics::Replay
+{
+    // A replay holds everything PhysicsTaskScheduler feeds into MovementSolver for a frame: the actor simulation
+    // inputs and the changes to the collision world since the previous frame. Projectiles are not recorded, their
+    // collision callbacks need live game objects.
+
+    enum class ShapeType : std::uint8_t
+    {
+        Box,
+        Sphere,
+        Capsule,
+        Cylinder,
+        ConvexHull,
+        Compound,
+        TriangleMesh,
+    };
+
+    /// Basis rows followed by the origin
+    using Transform = std::array<float, 12>;
+
+    struct CompoundChild
+    {
+        std::uint32_t mShape = 0;
+        Transform mTransform{};
+    };
+
+    struct Shape
+    {
+        std::uint32_t mId = 0;
+        ShapeType mType = ShapeType::Box;
+        /// Half extents for boxes and cylinders, radius and half height for capsules, radius for spheres
+        osg::Vec3f mDimensions;
+        std::int32_t mUpAxis = 2;
+        float mMargin = 0;
+        osg::Vec3f mLocalScaling{ 1, 1, 1 };
+        /// Hull points, or three vertices per triangle for meshes
+        std::vector<float> mPoints;
+        std::vector<CompoundChild> mChildren;
+    };
+
+    struct CollisionObject
+    {
+        std::uint32_t mId = 0;
+        std::uint32_t mShape = 0;
+        std::int32_t mGroup = 0;
+        std::int32_t mMask = 0;
+        std::int32_t mFlags = 0;
+        Transform mTransform{};
+    };
+
+    bool operator==(const CollisionObject& lhs, const CollisionObject& rhs);
+
+    /// Serializable copy of ActorFrameData, with collision objects referred to by replay id
+    struct ActorInput
+    {
+        std::uint32_t mCollisionObject = 0;
+        std::uint32_t mStandingOn = 0;
+        osg::Vec3f mPosition;
+        /// Offset of the collision object origin from mPosition
+        osg::Vec3f mCollisionObjectOffset;
+        osg::Vec3f mInertia;
+        osg::Vec2f mRotation;
+        osg::Vec3f mMovement;
+        osg::Vec3f mLastStuckPosition;
+        float mSwimLevel = 0;
+        float mSlowFall = 0;
+        float mWaterlevel = 0;
+        float mHalfExtentsZ = 0;
+        float mOldHeight = 0;
+        std::uint32_t mStuckFrames = 0;
+        bool mIsOnGround = false;
+        bool mIsOnSlope = false;
+        bool mInert = false;
+        bool mFlying = false;
+        bool mWasOnGround = false;
+        bool mIsAquatic = false;
+        bool mWaterCollision = false;
+        bool mSkipCollisionDetection = false;
+        bool mIsPlayer = false;
+    };
+
+    struct Frame
+    {
+        std::uint32_t mNumSteps = 0;
+        float mPhysicsDt = 0;
+        bool mIsInStorm = false;
+        osg::Vec3f mStormDirection;
+        /// Shapes used by mUpdatedObjects for the first time, compound children come before their parent
+        std::vector<Shape> mNewShapes;
+        std::vector<std::uint32_t> mRemovedObjects;
+        /// Objects added to the world or changed since the previous frame
+        std::vector<CollisionObject> mUpdatedObjects;
+        std::vector<ActorInput> mActors;
+    };
+
+    class Writer
+    {
+    public:
+        explicit Writer(const std::filesystem::path& path);
+
+        void write(const Frame& frame);
+
+    private:
+        std::ofstream mStream;
+    };
+
+    class Reader
+    {
+    public:
+        explicit Reader(const std::filesystem::path& path);
+
+        /// @return false at the end of the replay
+        bool read(Frame& frame);
+
+    private:
+        std::ifstream mStream;
+    };
+
+    /// @brief Turns the collision world and simulations of each frame into replay frames
+    class Recorder
+    {
+    public:
+        explicit Recorder(const std::filesystem::path& path);
+
+        /// Must be called while no other thread accesses the collision world
+        void record(const btCollisionWorld& world, std::vector<Simulation>& simulations, unsigned numSteps,
+            float physicsDt, const WorldFrameData& worldData);
+
+    private:
+        struct RecordedShape
+        {
+            std::uint32_t mId;
+            std::size_t mUsers;
+        };
+
+        struct RecordedObject
+        {
+            CollisionObject mState;
+            const btCollisionShape* mShape = nullptr;
+            std::size_t mGeneration = 0;
+        };
+
+        std::uint32_t acquireShape(const btCollisionShape& shape, Frame& frame);
+        void releaseShape(const btCollisionShape* shape);
+        std::uint32_t addShape(const btCollisionShape& shape, Frame& frame);
+
+        Writer mWriter;
+        std::unordered_map<const btCollisionShape*, RecordedShape> mShapes;
+        std::unordered_map<const btCollisionObject*, RecordedObject> mObjects;
+        std::uint32_t mNextShapeId = 1;
+        std::uint32_t mNextObjectId = 1;
+        std::size_t mGeneration = 0;
+    };
+
+    /// @brief Standalone collision world rebuilt from replay frames
+    class World
+    {
+    public:
+        World();
+        ~World();
+
+        void apply(const Frame& frame);
+
+        btCollisionWorld& getCollisionWorld() { return *mCollisionWorld; }
+
+        std::vector<ActorFrameData> makeActorFrameData(const Frame& frame);
+
+        /// Move the actor collision object along with the simulated position, like the scheduler does after each step
+        void updateActorPosition(const ActorFrameData& data, const ActorInput& input);
+
+    private:
+        btCollisionShape& createShape(const Shape& shape);
+        btCollisionObject* findObject(std::uint32_t id) const;
+
+        std::unique_ptr<btCollisionConfiguration> mCollisionConfiguration;
+        std::unique_ptr<btCollisionDispatcher> mDispatcher;
+        std::unique_ptr<btBroadphaseInterface> mBroadphase;
+        std::unique_ptr<btCollisionWorld> mCollisionWorld;
+        std::vector<std::unique_ptr<btStridingMeshInterface>> mMeshes;
+        std::map<std::uint32_t, std::unique_ptr<btCollisionShape>> mShapes;
+        std::map<std::uint32_t, std::unique_ptr<btCollisionObject>> mObjects;
+    };
+}
+
+#endif
@@ -17,6 +17,10 @@
 #include "npcanimation.hpp"
 #include "vismask.hpp"
 
+//## VR_PATCH BEGIN
+#include <components/vr/motionvectors.hpp>
+//## VR_PATCH END
+
 namespace MWRender
 {
 
@@ -95,6 +99,9 @@ namespace MWRender
     {
         insertBegin(ptr);
         ptr.getRefData().getBaseNode()->setNodeMask(Mask_Actor);
+//## VR_PATCH BEGIN
+        VR::MotionVectors::track(ptr.getRefData().getBaseNode(), ~(Mask_Effect | Mask_ParticleSystem));
+//## VR_PATCH END
 
         bool animated = true;
         std::string animationMesh
@@ -118,6 +125,9 @@ namespace MWRender
     {
         insertBegin(ptr);
         ptr.getRefData().getBaseNode()->setNodeMask(Mask_Actor);
+//## VR_PATCH BEGIN
+        VR::MotionVectors::track(ptr.getRefData().getBaseNode(), ~(Mask_Effect | Mask_ParticleSystem));
+//## VR_PATCH END
 
         if (ptr.getType() == ESM::REC_NPC_4)
         {
@@ -2,7 +2,9 @@
 
 #include <cassert>
 
+#include <components/sceneutil/renderpass.hpp>
 #include <components/shader/shadermanager.hpp>
+#include <components/stereo/foveation.hpp>
 #include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
 
@@ -21,6 +23,7 @@ namespace MWRender
         : mFallbackStateSet(new osg::StateSet)
         , mMultiviewResolveStateSet(new osg::StateSet)
         , mLuminanceCalculator(luminanceCalculator)
+        , mFoveationStateSet(new osg::StateSet)
     {
         setUseDisplayList(false);
         setUseVertexBufferObjects(true);
@@ -40,6 +43,7 @@ namespace MWRender
         Stereo::shaderStereoDefines(defines);
 
 //## VR_PATCH BEGIN
+        defines["foveation"] = "0";
         mFallbackProgram = shaderManager.getProgram("fullscreen_tri", defines);
 //## VR_PATCH END
 
@@ -47,6 +51,17 @@ namespace MWRender
         mFallbackStateSet->addUniform(new osg::Uniform("lastShader", 0));
         mFallbackStateSet->addUniform(new osg::Uniform("scaling", osg::Vec2f(1, 1)));
 
+//## VR_PATCH BEGIN
+        defines["foveation"] = "1";
+        mFoveationProgram = shaderManager.getProgram("fullscreen_tri", defines);
+
+        mFoveationStateSet->setAttributeAndModes(mFoveationProgram);
+        mFoveationStateSet->addUniform(new osg::Uniform("lastShader", 0));
+        mFoveationStateSet->addUniform(new osg::Uniform("scaling", osg::Vec2f(1, 1)));
+        mFoveationStateSet->addUniform(new osg::Uniform("opaqueDepthTex", PostProcessor::Unit_Depth));
+        Stereo::addFoveationReconstructUniforms(mFoveationStateSet);
+//## VR_PATCH END
+
         mMultiviewResolveProgram = shaderManager.getProgram("multiview_resolve");
         mMultiviewResolveStateSet->setAttributeAndModes(mMultiviewResolveProgram);
         mMultiviewResolveStateSet->addUniform(new osg::Uniform("lastShader", 0));
@@ -115,10 +130,28 @@ namespace MWRender
 
         if (filtered.empty() || !mPostprocessing)
         {
-            state.pushStateSet(mFallbackStateSet);
+//## VR_PATCH BEGIN
+            const bool foveation = mFoveation && mTextureDepth;
+            const osg::Vec2f textureSize(mTextureScene->getTextureWidth(), mTextureScene->getTextureHeight());
+            const osg::Vec2f sceneResolution = mSceneResolution.x() > 0
+                ? osg::Vec2f(mSceneResolution.x(), mSceneResolution.y())
+                : textureSize;
+            const osg::Vec2f scaling(sceneResolution.x() / textureSize.x(), sceneResolution.y() / textureSize.y());
+            if (foveation)
+            {
+                mFoveationStateSet->getUniform("scaling")->set(scaling);
+                mFoveationStateSet->getUniform("foveationTexelSize")
+                    ->set(osg::Vec2f(1.f / textureSize.x(), 1.f / textureSize.y()));
+                mFoveationStateSet->getUniform("foveationResolution")->set(sceneResolution);
+                state.pushStateSet(mFoveationStateSet);
+            }
+            else
+            {
+                mFallbackStateSet->getUniform("scaling")->set(scaling);
+                state.pushStateSet(mFallbackStateSet);
+            }
             state.apply();
 
-//## VR_PATCH BEGIN
 // VR-TODO: I'll have to dig back in an figure out what i was doing here :|
             if (Stereo::getMultiview() && !VR::getVR())
 //## VR_PATCH END
@@ -128,12 +161,20 @@ namespace MWRender
             }
 
             state.applyTextureAttribute(0, mTextureScene);
+//## VR_PATCH BEGIN
+            if (foveation)
+                state.applyTextureAttribute(PostProcessor::Unit_Depth, mTextureDepth);
+//## VR_PATCH END
             resolveViewport->apply(state);
 
 //## VR_PATCH BEGIN
             if (mDestinationFBO)
             {
                 mDestinationFBO->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+                // Every pixel is overwritten, skip loading the previous contents into tile memory
+                SceneUtil::invalidateFramebuffer(state, GL_DRAW_FRAMEBUFFER_EXT, GL_COLOR_BUFFER_BIT);
+                if (mPingPongCallback)
+                    mPingPongCallback->destinationBound(state, *this);
                 drawGeometry(renderInfo);
                 ext->glBindFramebuffer(GL_DRAW_FRAMEBUFFER_EXT, 0);
             }
@@ -218,6 +259,11 @@ namespace MWRender
             if (destinationFbo)
             {
                 destinationFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+                SceneUtil::invalidateFramebuffer(state, GL_DRAW_FRAMEBUFFER_EXT, GL_COLOR_BUFFER_BIT);
+//## VR_PATCH BEGIN
+                if (mPingPongCallback)
+                    mPingPongCallback->destinationBound(state, *this);
+//## VR_PATCH END
                 lastApplied = destinationHandle;
             }
             else if (Stereo::getMultiview())
@@ -320,7 +366,10 @@ namespace MWRender
                 else if (pass.mResolve && index == filtered.back())
                 {
                     bindDestinationFbo();
-                    if (!destinationFbo && !Stereo::getMultiview())
+//## VR_PATCH BEGIN
+                    // Dynamic resolution may render to part of the destination
+                    if (VR::getVR() || (!destinationFbo && !Stereo::getMultiview()))
+//## VR_PATCH END
                     {
                         resolveViewport->apply(state);
                     }
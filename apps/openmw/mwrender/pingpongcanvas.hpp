@@ -6,6 +6,7 @@
 #include <osg/FrameBufferObject>
 #include <osg/Geometry>
 #include <osg/Texture2D>
+#include <osg/Vec2i>
 
 #include <components/fx/technique.hpp>
 
@@ -29,6 +30,8 @@ namespace MWRender
 
             virtual void pingPongBegin(osg::State& state, const PingPongCanvas& canvas) = 0;
             virtual void pingPongEnd(osg::State& state, const PingPongCanvas& canvas) = 0;
+            //! Called right after the destination framebuffer has been bound for drawing.
+            virtual void destinationBound(osg::State& state, const PingPongCanvas& canvas) {}
         };
         
 
@@ -80,6 +83,12 @@ namespace MWRender
 
         void setPingPongCallback(std::unique_ptr<PingPongCallback> cb);
 
+        //! Reconstruct pixels skipped by Stereo::FoveationMask when no post processing passes are active
+        void setFoveation(bool enabled) { mFoveation = enabled; }
+
+        //! Region of the scene texture, starting at its origin, that the scene was rendered to
+        void setSceneResolution(const osg::Vec2i& resolution) { mSceneResolution = resolution; }
+
 //## VR_PATCH END
     private:
         bool mAvgLum = false;
@@ -108,6 +117,10 @@ namespace MWRender
 //## VR_PATCH BEGIN
         std::unique_ptr<PingPongCallback> mPingPongCallback;
         mutable osg::ref_ptr<osg::Viewport> mDestinationViewport;
+        bool mFoveation = false;
+        osg::Vec2i mSceneResolution;
+        osg::ref_ptr<osg::Program> mFoveationProgram;
+        osg::ref_ptr<osg::StateSet> mFoveationStateSet;
 //## VR_PATCH END
     };
 }
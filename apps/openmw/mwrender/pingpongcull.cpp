@@ -72,7 +72,10 @@ namespace MWRender
 
         if (mViewportStateset)
         {
-            mViewport->setViewport(0, 0, mPostProcessor->renderWidth(), mPostProcessor->renderHeight());
+//## VR_PATCH BEGIN
+            const osg::Vec2i resolution = mPostProcessor->sceneResolution();
+            mViewport->setViewport(0, 0, resolution.x(), resolution.y());
+//## VR_PATCH END
             renderStage->setViewport(mViewport);
             cv->pushStateSet(mViewportStateset.get());
             traverse(node, cv);
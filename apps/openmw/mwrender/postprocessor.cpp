@@ -21,6 +21,7 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
+#include <components/stereo/foveation.hpp>
 #include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
 #include <components/vfs/manager.hpp>
@@ -40,6 +41,8 @@
 #include "vismask.hpp"
 
 //## VR_PATCH BEGIN
+#include <components/vr/session.hpp>
+#include <components/vr/viewer.hpp>
 #include <components/vr/vr.hpp>
 #include "../mwvr/vrpingpongcallback.hpp"
 
@@ -233,6 +236,27 @@ namespace MWRender
             mCanvases[0]->setPingPongCallback(std::make_unique<MWVR::PingPongCallback>(this));
             mCanvases[1]->setPingPongCallback(std::make_unique<MWVR::PingPongCallback>(this));
         }
+
+        // Foveation masks the scene before anything else is drawn, reconstruction happens in the fallback canvas pass.
+        // Only colour is reconstructed, skipped pixels keep near plane depth, which mustn't reach the depth based
+        // reprojection of the runtime or space warp.
+        bool foveatedRendering = Stereo::getStereo() && Settings::stereo().mFoveatedRendering;
+        if (foveatedRendering && VR::getVR()
+            && (VR::Session::instance().appShouldShareDepthInfo()
+                || VR::Session::instance().appShouldSubmitMotionVectors()))
+        {
+            Log(Debug::Info) << "Foveated rendering is disabled while depth is submitted to the VR runtime";
+            foveatedRendering = false;
+        }
+        if (foveatedRendering)
+        {
+            mFoveationMask = new Stereo::FoveationMask(shaderManager);
+            mFoveationMask->setRadii(
+                Settings::stereo().mFoveationInnerRadius, Settings::stereo().mFoveationOuterRadius);
+            mFoveationMask->setNodeMask(mUsePostProcessing ? 0 : Mask_FoveationMask);
+            mFoveationMask->getOrCreateStateSet()->setRenderBinDetails(RenderBin_FoveationMask, "RenderBin");
+            rootNode->addChild(mFoveationMask);
+        }
         // ## VR_PATCH END
     }
 
@@ -315,6 +339,10 @@ namespace MWRender
         mCanvases[frameId]->setTextureScene(getTexture(Tex_Scene, frameId));
         mCanvases[frameId]->setTextureDepth(getTexture(Tex_OpaqueDepth, frameId));
         mCanvases[frameId]->setTextureDistortion(getTexture(Tex_Distortion, frameId));
+//## VR_PATCH BEGIN
+        mCanvases[frameId]->setFoveation(mFoveationMask && !mUsePostProcessing);
+        mCanvases[frameId]->setSceneResolution(sceneResolution());
+//## VR_PATCH END
 
 //## VR_PATCH BEGIN
 // VR-TODO: Why this change?
@@ -420,6 +448,16 @@ namespace MWRender
         mCanvases[frameId]->setNodeMask(~0u);
         mCanvases[!frameId]->setNodeMask(0);
 
+//## VR_PATCH BEGIN
+        // Skipped pixels are only reconstructed by the fallback pass, so post processing needs the full scene
+        if (mFoveationMask)
+            mFoveationMask->setNodeMask(mUsePostProcessing ? 0 : Mask_FoveationMask);
+
+        // Post processing passes work on the full render targets and can't make use of a lower render resolution
+        if (VR::getVR())
+            VR::Viewer::instance().setRequireFullResolution(mUsePostProcessing);
+//## VR_PATCH END
+
         if (mDirty && mDirtyFrameId == frameId)
         {
             createObjectsForFrame(frameId);
@@ -898,6 +936,15 @@ namespace MWRender
         return mHeight;
     }
 
+//## VR_PATCH BEGIN
+    osg::Vec2i PostProcessor::sceneResolution() const
+    {
+        if (VR::getVR() && !mUsePostProcessing)
+            return Stereo::Manager::instance().renderResolution();
+        return osg::Vec2i(renderWidth(), renderHeight());
+    }
+//## VR_PATCH END
+
     void PostProcessor::triggerShaderReload()
     {
         mTriggerShaderReload = true;
@@ -12,6 +12,7 @@
 #include <osg/FrameBufferObject>
 #include <osg/Group>
 #include <osg/Texture2D>
+#include <osg/Vec2i>
 
 #include <osgViewer/Viewer>
 
@@ -33,6 +34,7 @@ namespace osgViewer
 namespace Stereo
 {
     class MultiviewFramebuffer;
+    class FoveationMask;
 }
 
 namespace VFS
@@ -198,6 +200,12 @@ namespace MWRender
         int renderWidth() const;
         int renderHeight() const;
 
+//## VR_PATCH BEGIN
+        //! Region of the render targets, starting at their origin, that the scene is rendered to.
+        //! Smaller than the render targets while VR dynamic resolution lowers the resolution.
+        osg::Vec2i sceneResolution() const;
+//## VR_PATCH END
+
         void triggerShaderReload();
 
         bool mEnableLiveReload = false;
@@ -268,6 +276,9 @@ namespace MWRender
         std::array<osg::ref_ptr<PingPongCanvas>, 2> mCanvases;
         osg::ref_ptr<TransparentDepthBinCallback> mTransparentDepthPostPass;
         osg::ref_ptr<DistortionCallback> mDistortionCallback;
+//## VR_PATCH BEGIN
+        osg::ref_ptr<Stereo::FoveationMask> mFoveationMask;
+//## VR_PATCH END
 
         Fx::DispatchArray mTemplateData;
     };
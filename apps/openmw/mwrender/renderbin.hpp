@@ -7,6 +7,9 @@ namespace MWRender
     /// Defines the render bin numbers used in the OpenMW scene graph. The bin with the lowest number is rendered first.
     enum RenderBins
     {
+//## VR_PATCH BEGIN
+        RenderBin_FoveationMask = -2,
+//## VR_PATCH END
         RenderBin_Sky = -1,
         RenderBin_Default = 0, // osg::StateSet::OPAQUE_BIN
         RenderBin_Water = 9,
@@ -35,6 +35,7 @@
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/renderpass.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/stateupdater.hpp>
 #include <components/sceneutil/visitor.hpp>
@@ -86,6 +87,7 @@
 
 //## VR_PATCH BEGIN
 #include <osg/ViewportIndexed>
+#include <components/vr/motionvectors.hpp>
 #include <components/vr/vr.hpp>
 #include "../mwvr/vranimation.hpp"
 #include "../mwvr/vrgui.hpp"
@@ -1128,6 +1130,9 @@ namespace MWRender
             mPlayerNode->setNodeMask(Mask_Player);
             mPlayerNode->setName("Player Root");
             mSceneRoot->addChild(mPlayerNode);
+//## VR_PATCH BEGIN
+            VR::MotionVectors::track(mPlayerNode, ~(Mask_Effect | Mask_ParticleSystem | Mask_Pointer));
+//## VR_PATCH END
         }
 
         mPlayerNode->setUserDataContainer(new osg::DefaultUserDataContainer);
@@ -1367,6 +1372,7 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            SceneUtil::reportRenderPassStats(frameNumber, *stats);
         }
     }
 
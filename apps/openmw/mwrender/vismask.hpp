@@ -61,7 +61,10 @@ namespace MWRender
         // Vr masks
         Mask_3DGUI = (1 << 21),
         Mask_3DGUI_NonIntersectable = (1 << 22),
-        Mask_Pointer = (1 << 23)
+        Mask_Pointer = (1 << 23),
+
+        // Stereo foveation mask, drawn only by the main camera
+        Mask_FoveationMask = (1 << 24)
 //## VR_PATCH END
     };
 
@@ -277,8 +277,33 @@ namespace MWVR
             return nullptr;
         return it->second;
     }
+
+    const VR::PoseHistory& OpenXRInput::getPoseHistory(const std::string& id)
+    {
+        auto it = mPoseHistories.find(id);
+        if (it == mPoseHistories.end())
+            it = mPoseHistories.emplace(id, VR::PoseHistory()).first;
+        samplePoseHistory(id, it->second);
+        return it->second;
+    }
+
+    void OpenXRInput::samplePoseHistory(const std::string& id, VR::PoseHistory& history)
+    {
+        auto space = getSpace(id);
+        if (!space)
+            throw std::runtime_error("No such space " + id);
+        // Samples for a time already recorded replace the old one, so sampling twice per frame is harmless
+        history.push(space->locate(VR::ReferenceSpace::Local));
+    }
+
     void OpenXRInput::onFrameUpdate(VR::Frame&) 
     {
         mActionSets.at(MWActionSet::Pose).update();
     }
+
+    void OpenXRInput::onSpaceUpdate()
+    {
+        for (auto& [id, history] : mPoseHistories)
+            samplePoseHistory(id, history);
+    }
 }
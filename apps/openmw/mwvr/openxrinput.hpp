@@ -4,6 +4,7 @@
 #include "../mwinput/actions.hpp"
 
 #include "vrinput.hpp"
+#include <components/vr/posehistory.hpp>
 #include <components/vr/session.hpp>
 #include <components/xr/action.hpp>
 #include <components/xr/actionset.hpp>
@@ -85,10 +86,18 @@ namespace MWVR
 
         std::shared_ptr<VR::Space> getSpace(const std::string& id) const;
 
+        //! Recent poses of the given space in the local reference space. The space is sampled every frame from the
+        //! first call onwards, so consumers share a single history and can query it at their own timestamps.
+        const VR::PoseHistory& getPoseHistory(const std::string& id);
+
     protected:
         void onFrameUpdate(VR::Frame&) override;
+        void onSpaceUpdate() override;
+
+        void samplePoseHistory(const std::string& id, VR::PoseHistory& history);
 
         std::map<std::string, std::shared_ptr<VR::Space>> mSpaces{};
+        std::map<std::string, VR::PoseHistory> mPoseHistories{};
         std::map<std::string, std::string> mInteractionProfileLocalNames{};
         std::map<MWActionSet, XR::ActionSet> mActionSets{};
         std::map<XrPath, std::string> mInteractionProfileNames{};
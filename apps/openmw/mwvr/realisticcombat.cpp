@@ -91,7 +91,6 @@ namespace MWVR
             mMaxSwingVelocity = 0.f;
             mTimeSinceEnteredState = 0.f;
             mVelocity = 0.f;
-            mPreviousPosition = osg::Vec3(0.f, 0.f, 0.f);
             mState = SwingState_Ready;
         }
 
@@ -131,11 +130,13 @@ namespace MWVR
         {
             // Use the local reference space for swing state management to avoid the player character 
             // moving around the stage interfering with the calculated swing speed.
-            auto tp = OpenXRInput::instance().getSpace(mSpace)->locate(VR::ReferenceSpace::Local);
+            const VR::PoseHistory& history = OpenXRInput::instance().getPoseHistory(mSpace);
+            // Poses extrapolated past the last tracked sample are reported as stale
+            auto tp = history.locate(VR::getPredictedDisplayTime());
             auto weaponType = MWBase::Environment::get().getWorld()->getActiveWeaponType();
 
             enabled = enabled && isMeleeWeapon(weaponType);
-            enabled = enabled && !!tp.status && !!tp.status;
+            enabled = enabled && tp.status == VR::TrackingStatus::Good;
 
             if (mEnabled != enabled)
             {
@@ -169,17 +170,11 @@ namespace MWVR
 
             // Next determine current hand movement
 
-            // If tracking is lost, openxr will return a position of 0
-            // So i reset position when tracking is re-acquired to avoid a superspeed strike.
-            // Theoretically, the player's hand really could be at 0,0,0
-            // but that's a super rare case so whatever.
-            if (mPreviousPosition == osg::Vec3(0.f, 0.f, 0.f))
-                mPreviousPosition = tp.pose.position.asMeters();
-
-            osg::Vec3 movement = tp.pose.position.asMeters() - mPreviousPosition;
+            // The history discards samples without tracking, and fits the velocity to a short window of recent samples
+            // which is steadier than differencing the last two frames.
+            osg::Vec3 swingVector = history.linearVelocity(tp.time);
+            osg::Vec3 movement = swingVector * dt;
             mMovementSinceEnteredState += movement.length();
-            mPreviousPosition = tp.pose.position.asMeters();
-            osg::Vec3 swingVector = movement / dt;
             osg::Vec3 swingDirection = swingVector;
             swingDirection.normalize();
 
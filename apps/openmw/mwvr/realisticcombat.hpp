@@ -103,7 +103,6 @@ namespace MWVR
 
             bool mEnabled = false;
 
-            osg::Vec3 mPreviousPosition{ 0.f, 0.f, 0.f };
             std::string mSpace;
         };
 
@@ -32,8 +32,8 @@
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/visitor.hpp>
+#include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
-#include <components/vr/rendertoswapchain.hpp>
 #include <components/vr/session.hpp>
 #include <components/vr/trackingmanager.hpp>
 #include <components/vr/viewer.hpp>
@@ -315,6 +315,8 @@ namespace MWVR
             || mConfig->space != config.space;
         if (changed)
             mDirty = true;
+        if (!mConfig || mConfig->opacity != config.opacity || mConfig->myGUIViewSize != config.myGUIViewSize)
+            mNeedsRedraw = true;
         mConfig = config;
     }
 
@@ -326,11 +328,13 @@ namespace MWVR
     void VRGUILayer::addLuaElement(const LuaUi::Element* element)
     {
         mLuaElements.push_back(element);
+        mNeedsRedraw = true;
     }
 
     void VRGUILayer::removeLuaElement(const LuaUi::Element* element)
     {
         std::erase_if(mLuaElements, [element](const auto& lhs) { return lhs == element; });
+        mNeedsRedraw = true;
     }
 
     void VRGUILayer::clearLua()
@@ -388,6 +392,7 @@ namespace MWVR
             return;
 
         mVisible = visible;
+        mNeedsRedraw = true;
         if (mVisible)
             addToSceneGraph();
         else
@@ -399,6 +404,14 @@ namespace MWVR
         if (mVrLayer && mConfig)
         {
             auto* state = info.getState();
+
+            // The runtime keeps showing the last released swapchain image, so an unchanged layer needs no copy.
+            // The update of the next frame may already have run, hence also accepting a redraw one frame ahead.
+            const unsigned frameNumber = state->getFrameStamp()->getFrameNumber();
+            const unsigned lastRedrawFrame = mLastRedrawFrame;
+            if (frameNumber != lastRedrawFrame && frameNumber + 1 != lastRedrawFrame)
+                return;
+
             auto texture = colorTexture();
             mVrLayer->colorSwapchain->beginFrame(state->getGraphicsContext());
             auto glImage = mVrLayer->colorSwapchain->image()->glImage();
@@ -703,10 +716,23 @@ namespace MWVR
                 mTransform->setCullingActive(false);
             }
             mDirty = false;
+            mNeedsRedraw = true;
             if (mVisible)
                 addToSceneGraph();
         }
 
+        // Static layers keep their last rendered texture instead of rendering MyGUI again every frame. Update may
+        // run once per view, the decision made by the first view holds for the whole frame.
+        const unsigned frameNumber = nv->getFrameStamp()->getFrameNumber();
+        const bool redraw = !Settings::vr().mCacheGuiLayers || mNeedsRedraw || mLastRedrawFrame == frameNumber
+            || MyGUIPlatform::RenderManager::guiCameraNeedsRedraw(mMyGUICamera);
+        mGUIRTT->setNodeMask(redraw ? ~0u : 0u);
+        if (redraw)
+        {
+            mLastRedrawFrame = frameNumber;
+            mNeedsRedraw = false;
+        }
+
         if (!mVrLayer)
         {
             if (mTransform->getNumChildren() > 0)
@@ -761,6 +787,7 @@ namespace MWVR
             if (w == widget)
                 return;
         mWidgets.push_back(widget);
+        mNeedsRedraw = true;
     }
 
     void VRGUILayer::removeWidget(MWGui::Layout* widget)
@@ -770,6 +797,7 @@ namespace MWVR
             if (*it == widget)
             {
                 mWidgets.erase(it);
+                mNeedsRedraw = true;
                 return;
             }
         }
@@ -3,6 +3,7 @@
 
 #include <MyGUI_Widget.h>
 #include <array>
+#include <atomic>
 #include <map>
 #include <set>
 #include <mutex>
@@ -143,6 +144,9 @@ namespace MWVR
         osg::ref_ptr<osg::Camera> mMyGUICamera{ nullptr };
         bool mVisible = false;
         bool mDirty = false;
+        bool mNeedsRedraw = true;
+        //! Last frame the layer texture was rendered, read by the draw thread to skip unchanged swapchain copies
+        std::atomic<unsigned> mLastRedrawFrame{ 0 };
         bool mSpaceIsLost = false;
         bool mForceVisible = false;
         bool mPickable = false;
@@ -49,7 +49,8 @@ namespace MWVR
         else if (frameId == mLastFrameId)
             eye = Stereo::Eye::Right;
 
-        auto fbo = VR::Viewer::instance().getFboForView(eye);
+        mEye = eye;
+        auto fbo = VR::Viewer::instance().getFboForView(state, eye);
 
         fbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
         glClearColor(0.5, 0.5, 0.5, 1);
@@ -57,8 +58,8 @@ namespace MWVR
 
         canvas.setDestinationFbo(fbo);
 
-        auto& sm = Stereo::Manager::instance();
-        auto resolution = sm.eyeResolution();
+        // Dynamic resolution may render to part of the eye framebuffer
+        auto resolution = VR::Viewer::instance().drawResolution();
         mDestinationViewport->setViewport(0, 0, resolution.x(), resolution.y());
 
         canvas.setDestinationViewport(frameId, mDestinationViewport);
@@ -93,4 +94,9 @@ namespace MWVR
         VR::Viewer::instance().submitDepthForView(state, fbo, eye);
     }
 
+    void PingPongCallback::destinationBound(osg::State& state, const MWRender::PingPongCanvas& canvas)
+    {
+        VR::Viewer::instance().bindFboForView(state, mEye);
+    }
+
 }
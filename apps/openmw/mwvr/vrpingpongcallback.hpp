@@ -5,6 +5,7 @@
 #include "../mwrender/postprocessor.hpp"
 #include "../mwrender/renderingmanager.hpp"
 
+#include <components/stereo/types.hpp>
 #include <components/vr/trackinglistener.hpp>
 #include <osg/ref_ptr>
 
@@ -24,8 +25,10 @@ namespace MWVR
 
         void pingPongBegin(osg::State& state, const MWRender::PingPongCanvas& canvas) override;
         void pingPongEnd(osg::State& state, const MWRender::PingPongCanvas& canvas) override;
+        void destinationBound(osg::State& state, const MWRender::PingPongCanvas& canvas) override;
 
         size_t mLastFrameId = 0xffffffff;
+        Stereo::Eye mEye = Stereo::Eye::Left;
         MWRender::PostProcessor* mParent;
         osg::ref_ptr<osg::Viewport> mDestinationViewport;
     };
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <span>
 
 #include <osg/Stats>
@@ -32,6 +34,8 @@ namespace MWWorld
 {
     namespace
     {
+        constexpr std::size_t minMeshesPerThread = 16;
+
         bool contains(std::span<const PositionCellGrid> positions, const PositionCellGrid& contained, float tolerance)
         {
             const float squaredTolerance = tolerance * tolerance;
@@ -85,8 +89,14 @@ namespace MWWorld
 
             ListModelsVisitor visitor{ mMeshes };
             cell->forEachConst(visitor);
+
+            // Many objects share a model, loading it concurrently by multiple threads would only waste time
+            std::sort(mMeshes.begin(), mMeshes.end());
+            mMeshes.erase(std::unique(mMeshes.begin(), mMeshes.end()), mMeshes.end());
         }
 
+        std::size_t getMeshCount() const { return mMeshes.size(); }
+
         void abort() override { mAbort = true; }
 
         /// Preload work to be called from the worker thread.
@@ -97,7 +107,7 @@ namespace MWWorld
                 try
                 {
                     mTerrain->cacheCell(mTerrainView.get(), mCellLocation.mX, mCellLocation.mY);
-                    mPreloadedObjects.insert(mLandManager->getLand(mCellLocation));
+                    insert(mLandManager->getLand(mCellLocation));
                 }
                 catch (const std::exception& e)
                 {
@@ -106,13 +116,26 @@ namespace MWWorld
                 }
             }
 
+            preloadMeshes();
+
+            // Meshes taken by the helpers may still be loading, the cell is preloaded only when they are done
+            std::unique_lock lock(mMutex);
+            mHelpersDone.wait(lock, [&] { return mActiveHelpers == 0; });
+        }
+
+        /// Load meshes not taken by other threads yet, may be called by multiple worker threads at once.
+        void preloadMeshes()
+        {
             VFS::Path::Normalized mesh;
             VFS::Path::Normalized kfname;
-            for (std::string_view path : mMeshes)
+            while (!mAbort)
             {
-                if (mAbort)
+                const std::size_t index = mNextMesh.fetch_add(1);
+                if (index >= mMeshes.size())
                     break;
 
+                const std::string_view path = mMeshes[index];
+
                 try
                 {
                     const VFS::Manager& vfs = *mSceneManager->getVFS();
@@ -129,14 +152,14 @@ namespace MWWorld
                         constexpr VFS::Path::ExtensionView kf("kf");
                         kfname.changeExtension(kf);
                         if (vfs.exists(kfname))
-                            mPreloadedObjects.insert(mKeyframeManager->get(kfname));
+                            insert(mKeyframeManager->get(kfname));
                     }
 
-                    mPreloadedObjects.insert(mSceneManager->getTemplate(mesh));
+                    insert(mSceneManager->getTemplate(mesh));
                     if (mPreloadInstances)
-                        mPreloadedObjects.insert(mBulletShapeManager->cacheInstance(mesh));
+                        insert(mBulletShapeManager->cacheInstance(mesh));
                     else
-                        mPreloadedObjects.insert(mBulletShapeManager->getShape(mesh));
+                        insert(mBulletShapeManager->getShape(mesh));
                 }
                 catch (const std::exception& e)
                 {
@@ -146,6 +169,23 @@ namespace MWWorld
             }
         }
 
+        /// To be called by a helper from the worker thread before taking any mesh.
+        void beginHelper()
+        {
+            const std::lock_guard lock(mMutex);
+            ++mActiveHelpers;
+        }
+
+        /// To be called by a helper from the worker thread when there are no meshes left to take.
+        void endHelper()
+        {
+            {
+                const std::lock_guard lock(mMutex);
+                --mActiveHelpers;
+            }
+            mHelpersDone.notify_all();
+        }
+
     private:
         bool mIsExterior;
         ESM::ExteriorCellLocation mCellLocation;
@@ -159,11 +199,42 @@ namespace MWWorld
         bool mPreloadInstances;
 
         std::atomic<bool> mAbort;
+        std::atomic<std::size_t> mNextMesh{ 0 };
 
         osg::ref_ptr<Terrain::View> mTerrainView;
 
+        std::mutex mMutex;
+        std::condition_variable mHelpersDone;
+        std::size_t mActiveHelpers = 0;
+
         // keep a ref to the loaded objects to make sure it stays loaded as long as this cell is in the preloaded state
         std::set<osg::ref_ptr<const osg::Object>> mPreloadedObjects;
+
+        void insert(osg::ref_ptr<const osg::Object> object)
+        {
+            const std::lock_guard lock(mMutex);
+            mPreloadedObjects.insert(std::move(object));
+        }
+    };
+
+    /// Worker thread item: help to preload models of a cell with many of them using another worker thread.
+    class PreloadHelperItem : public SceneUtil::WorkItem
+    {
+    public:
+        explicit PreloadHelperItem(osg::ref_ptr<PreloadItem> item)
+            : mItem(std::move(item))
+        {
+        }
+
+        void doWork() override
+        {
+            mItem->beginHelper();
+            mItem->preloadMeshes();
+            mItem->endHelper();
+        }
+
+    private:
+        osg::ref_ptr<PreloadItem> mItem;
     };
 
     class TerrainPreloadItem : public SceneUtil::WorkItem
@@ -286,6 +357,16 @@ namespace MWWorld
             mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
         mWorkQueue->addWorkItem(item);
 
+        // Spread loading of a cell with many models over idle worker threads. When there are already more queued items
+        // than threads, the other threads have enough work to do with other cells.
+        const std::size_t threads = mWorkQueue->getNumThreads();
+        if (mWorkQueue->getNumItems() <= threads)
+        {
+            const std::size_t parallelism = std::min(threads, item->getMeshCount() / minMeshesPerThread);
+            for (std::size_t i = 1; i < parallelism; ++i)
+                mWorkQueue->addWorkItem(new PreloadHelperItem(item));
+        }
+
         mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
         ++mAdded;
     }
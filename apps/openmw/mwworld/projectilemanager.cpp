@@ -61,6 +61,7 @@
 #include "../mwphysics/projectile.hpp"
 
 //## VR_PATCH BEGIN
+#include <components/vr/motionvectors.hpp>
 #include <components/vr/vr.hpp>
 #include "../mwvr/vrutil.hpp"
 #include "../mwvr/openxrinput.hpp"
@@ -227,6 +228,9 @@ namespace MWWorld
         state.mNode->setNodeMask(MWRender::Mask_Effect);
         state.mNode->setPosition(pos);
         state.mNode->setAttitude(orient);
+//## VR_PATCH BEGIN
+        VR::MotionVectors::track(state.mNode, ~MWRender::Mask_ParticleSystem);
+//## VR_PATCH END
 
         osg::Group* attachTo = state.mNode;
 
@@ -435,6 +439,7 @@ namespace MWWorld
 
     void ProjectileManager::update(float dt)
     {
+        mValidTargets.clear();
         periodicCleanup(dt);
         moveProjectiles(dt);
         moveMagicBolts(dt);
@@ -511,12 +516,7 @@ namespace MWWorld
                 sound->setVelocity(direction * speed);
             }
 
-            // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit
-            // result.
-            std::vector<MWWorld::Ptr> targetActors;
-            if (!caster.isEmpty() && caster.getClass().isActor() && caster != MWMechanics::getPlayer())
-                caster.getClass().getCreatureStats(caster).getAiSequence().getCombatTargets(targetActors);
-            projectile->setValidTargets(targetActors);
+            projectile->setValidTargets(getValidTargets(caster));
         }
     }
 
@@ -543,15 +543,23 @@ namespace MWWorld
 
             MWWorld::Ptr caster = projectileState.getCaster();
 
-            // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit
-            // result.
-            std::vector<MWWorld::Ptr> targetActors;
-            if (!caster.isEmpty() && caster.getClass().isActor() && caster != MWMechanics::getPlayer())
-                caster.getClass().getCreatureStats(caster).getAiSequence().getCombatTargets(targetActors);
-            projectile->setValidTargets(targetActors);
+            projectile->setValidTargets(getValidTargets(caster));
         }
     }
 
+    const std::vector<MWWorld::Ptr>& ProjectileManager::getValidTargets(const MWWorld::Ptr& caster)
+    {
+        static const std::vector<MWWorld::Ptr> anyTarget;
+        // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit
+        // result.
+        if (caster.isEmpty() || !caster.getClass().isActor() || caster == MWMechanics::getPlayer())
+            return anyTarget;
+        const auto [it, inserted] = mValidTargets.try_emplace(caster.mRef);
+        if (inserted)
+            caster.getClass().getCreatureStats(caster).getAiSequence().getCombatTargets(it->second);
+        return it->second;
+    }
+
     void ProjectileManager::processHits()
     {
         for (auto& projectileState : mProjectiles)
@@ -684,6 +692,8 @@ namespace MWWorld
         for (auto& mMagicBolt : mMagicBolts)
             cleanupMagicBolt(mMagicBolt);
         mMagicBolts.clear();
+
+        mValidTargets.clear();
     }
 
     void ProjectileManager::write(ESM::ESMWriter& writer, Loading::Listener& progress) const
@@ -242,7 +242,7 @@ namespace MWWorld
     void World::init(Debug::Level maxRecastLogLevel, osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue, std::unique_ptr<MWRender::Camera> camera)
     {
-        mPhysics = std::make_unique<MWPhysics::PhysicsSystem>(mResourceSystem, rootNode);
+        mPhysics = std::make_unique<MWPhysics::PhysicsSystem>(mResourceSystem, rootNode, mUserDataPath);
 
         if (Settings::navigator().mEnable)
         {
@@ -2561,6 +2561,16 @@ namespace MWWorld
         return mPhysics->getLineOfSight(actor, targetActor);
     }
 
+    void World::requestLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor)
+    {
+        if (!targetActor.getRefData().isEnabled() || !actor.getRefData().isEnabled())
+            return;
+        if (!targetActor.getRefData().getBaseNode() || !actor.getRefData().getBaseNode())
+            return;
+
+        mPhysics->requestLineOfSight(actor, targetActor);
+    }
+
     float World::getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater)
     {
         osg::Vec3f to(dir);
@@ -505,6 +505,9 @@ namespace MWWorld
         bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        void requestLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
+        ///< compute Line of Sight in the background, for getLOS calls in the next frames
+
         float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false) override;
 
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "apps/openmw/mwphysics/regionbroadphase.hpp"
+
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <memory>
+#include <vector>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        constexpr float regionSize = 1000;
+
+        struct MWPhysicsRegionBroadphaseTest : public ::testing::Test
+        {
+            btDefaultCollisionConfiguration mCollisionConfiguration;
+            btCollisionDispatcher mDispatcher{ &mCollisionConfiguration };
+            RegionBroadphase mBroadphase{ regionSize };
+            btCollisionWorld mCollisionWorld{ &mDispatcher, &mBroadphase, &mCollisionConfiguration };
+            btBoxShape mShape{ btVector3(10, 10, 10) };
+            std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+
+            ~MWPhysicsRegionBroadphaseTest() override
+            {
+                for (const auto& object : mObjects)
+                    mCollisionWorld.removeCollisionObject(object.get());
+            }
+
+            btCollisionObject& addObject(const btVector3& position)
+            {
+                auto object = std::make_unique<btCollisionObject>();
+                object->setCollisionShape(&mShape);
+                object->setWorldTransform(btTransform(btMatrix3x3::getIdentity(), position));
+                mCollisionWorld.addCollisionObject(object.get());
+                mObjects.push_back(std::move(object));
+                return *mObjects.back();
+            }
+
+            void removeObject(btCollisionObject& object)
+            {
+                mCollisionWorld.removeCollisionObject(&object);
+                std::erase_if(mObjects, [&](const auto& v) { return v.get() == &object; });
+            }
+
+            const btCollisionObject* castRay(const btVector3& from, const btVector3& to)
+            {
+                btCollisionWorld::ClosestRayResultCallback callback(from, to);
+                mCollisionWorld.rayTest(from, to, callback);
+                return callback.m_collisionObject;
+            }
+        };
+
+        TEST_F(MWPhysicsRegionBroadphaseTest, shouldCreateRegionPerOccupiedArea)
+        {
+            addObject(btVector3(100, 100, 0));
+            addObject(btVector3(200, 200, 0));
+            addObject(btVector3(1500, 100, 0));
+            addObject(btVector3(-100, -100, 0));
+            EXPECT_EQ(mBroadphase.getRegionCount(), 3);
+        }
+
+        TEST_F(MWPhysicsRegionBroadphaseTest, rayTestShouldFindObjectsInAllRegions)
+        {
+            const btCollisionObject& first = addObject(btVector3(100, 100, 0));
+            const btCollisionObject& second = addObject(btVector3(2500, 100, 0));
+            EXPECT_EQ(castRay(btVector3(-500, 100, 0), btVector3(3000, 100, 0)), &first);
+            EXPECT_EQ(castRay(btVector3(3000, 100, 0), btVector3(-500, 100, 0)), &second);
+            EXPECT_EQ(castRay(btVector3(1500, 100, 0), btVector3(3000, 100, 0)), &second);
+            EXPECT_EQ(castRay(btVector3(100, 500, 0), btVector3(2500, 500, 0)), nullptr);
+        }
+
+        TEST_F(MWPhysicsRegionBroadphaseTest, objectMovedToOtherRegionShouldBeFound)
+        {
+            btCollisionObject& object = addObject(btVector3(100, 100, 0));
+            addObject(btVector3(200, 200, 0));
+            object.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), btVector3(3100, 100, 0)));
+            mCollisionWorld.updateSingleAabb(&object);
+            EXPECT_EQ(mBroadphase.getRegionCount(), 2);
+            EXPECT_EQ(castRay(btVector3(2500, 100, 0), btVector3(3500, 100, 0)), &object);
+            EXPECT_EQ(castRay(btVector3(-500, 100, 0), btVector3(500, 100, 0)), nullptr);
+        }
+
+        TEST_F(MWPhysicsRegionBroadphaseTest, objectMovedNearRegionBorderShouldStayInRegion)
+        {
+            btCollisionObject& object = addObject(btVector3(100, 100, 0));
+            object.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), btVector3(1100, 100, 0)));
+            mCollisionWorld.updateSingleAabb(&object);
+            EXPECT_EQ(mBroadphase.getRegionCount(), 1);
+            EXPECT_EQ(castRay(btVector3(500, 100, 0), btVector3(1500, 100, 0)), &object);
+        }
+
+        TEST_F(MWPhysicsRegionBroadphaseTest, removingLastObjectShouldDropRegion)
+        {
+            btCollisionObject& first = addObject(btVector3(100, 100, 0));
+            btCollisionObject& second = addObject(btVector3(2500, 100, 0));
+            removeObject(first);
+            EXPECT_EQ(mBroadphase.getRegionCount(), 1);
+            removeObject(second);
+            EXPECT_EQ(mBroadphase.getRegionCount(), 0);
+            btVector3 aabbMin;
+            btVector3 aabbMax;
+            mBroadphase.getBroadphaseAabb(aabbMin, aabbMax);
+            EXPECT_EQ(aabbMin, btVector3(0, 0, 0));
+            EXPECT_EQ(aabbMax, btVector3(0, 0, 0));
+        }
+
+        TEST_F(MWPhysicsRegionBroadphaseTest, aabbTestShouldFindObjectsInAllRegions)
+        {
+            struct Callback : btBroadphaseAabbCallback
+            {
+                int mCount = 0;
+
+                bool process(const btBroadphaseProxy* /*proxy*/) override
+                {
+                    ++mCount;
+                    return true;
+                }
+            };
+
+            addObject(btVector3(100, 100, 0));
+            addObject(btVector3(2500, 100, 0));
+            addObject(btVector3(5000, 100, 0));
+            Callback callback;
+            mBroadphase.aabbTest(btVector3(0, 0, -100), btVector3(3000, 200, 100), callback);
+            EXPECT_EQ(callback.mCount, 2);
+        }
+    }
+}
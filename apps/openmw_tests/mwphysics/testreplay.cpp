@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <components/testing/util.hpp>
+
+#include "apps/openmw/mwphysics/actor.hpp"
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/movementsolver.hpp"
+#include "apps/openmw/mwphysics/replay.hpp"
+
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        using namespace Replay;
+
+        Transform makeTranslation(const osg::Vec3f& position)
+        {
+            return { 1, 0, 0, 0, 1, 0, 0, 0, 1, position.x(), position.y(), position.z() };
+        }
+
+        Frame makeFrame()
+        {
+            Frame frame;
+            frame.mNumSteps = 2;
+            frame.mPhysicsDt = 1.f / 60.f;
+            frame.mNewShapes.push_back(Shape{ .mId = 1, .mDimensions = osg::Vec3f(1000, 1000, 10), .mMargin = 0.04f });
+            frame.mNewShapes.push_back(Shape{ .mId = 2, .mDimensions = osg::Vec3f(24, 24, 64), .mMargin = 0.04f });
+            frame.mNewShapes.push_back(Shape{ .mId = 3,
+                .mType = ShapeType::Compound,
+                .mChildren = { CompoundChild{ 2, makeTranslation(osg::Vec3f(0, 0, 100)) } } });
+            frame.mUpdatedObjects.push_back(CollisionObject{ .mId = 1,
+                .mShape = 1,
+                .mGroup = CollisionType_World,
+                .mMask = CollisionType_Actor,
+                .mTransform = makeTranslation(osg::Vec3f(0, 0, -10)) });
+            frame.mUpdatedObjects.push_back(CollisionObject{ .mId = 2,
+                .mShape = 2,
+                .mGroup = CollisionType_Actor,
+                .mMask = CollisionType_World | CollisionType_Actor,
+                .mTransform = makeTranslation(osg::Vec3f(0, 0, 64)) });
+            frame.mUpdatedObjects.push_back(CollisionObject{ .mId = 3,
+                .mShape = 3,
+                .mGroup = CollisionType_World,
+                .mMask = CollisionType_Actor,
+                .mTransform = makeTranslation(osg::Vec3f(500, 500, 0)) });
+
+            ActorInput actor;
+            actor.mCollisionObject = 2;
+            actor.mStandingOn = 1;
+            actor.mPosition = osg::Vec3f(0, 0, 0);
+            actor.mCollisionObjectOffset = osg::Vec3f(0, 0, 64);
+            actor.mMovement = osg::Vec3f(100, 0, 0);
+            actor.mWaterlevel = -1000;
+            actor.mSwimLevel = -1128;
+            actor.mHalfExtentsZ = 64;
+            actor.mIsOnGround = true;
+            actor.mWasOnGround = true;
+            frame.mActors.push_back(actor);
+            return frame;
+        }
+
+        TEST(MWPhysicsReplayTest, writtenFramesShouldBeReadInOrder)
+        {
+            const std::filesystem::path path = TestingOpenMW::outputFilePath("physics_replay.bin");
+            const Frame first = makeFrame();
+            Frame second;
+            second.mNumSteps = 1;
+            second.mRemovedObjects = { 3 };
+            {
+                Writer writer(path);
+                writer.write(first);
+                writer.write(second);
+            }
+
+            Reader reader(path);
+            Frame frame;
+            ASSERT_TRUE(reader.read(frame));
+            EXPECT_EQ(frame.mNumSteps, first.mNumSteps);
+            EXPECT_EQ(frame.mPhysicsDt, first.mPhysicsDt);
+            ASSERT_EQ(frame.mNewShapes.size(), 3);
+            EXPECT_EQ(frame.mNewShapes[1].mDimensions, first.mNewShapes[1].mDimensions);
+            ASSERT_EQ(frame.mNewShapes[2].mChildren.size(), 1);
+            EXPECT_EQ(frame.mNewShapes[2].mChildren[0].mTransform, first.mNewShapes[2].mChildren[0].mTransform);
+            EXPECT_EQ(frame.mUpdatedObjects, first.mUpdatedObjects);
+            ASSERT_EQ(frame.mActors.size(), 1);
+            EXPECT_EQ(frame.mActors[0].mMovement, first.mActors[0].mMovement);
+            EXPECT_TRUE(frame.mActors[0].mIsOnGround);
+
+            ASSERT_TRUE(reader.read(frame));
+            EXPECT_EQ(frame.mNumSteps, 1);
+            EXPECT_EQ(frame.mRemovedObjects, std::vector<std::uint32_t>{ 3 });
+            EXPECT_TRUE(frame.mNewShapes.empty());
+
+            EXPECT_FALSE(reader.read(frame));
+        }
+
+        TEST(MWPhysicsReplayTest, readerShouldRejectOtherFiles)
+        {
+            const std::filesystem::path path = TestingOpenMW::outputFilePath("not_a_physics_replay.bin");
+            std::ofstream(path) << "not a physics replay";
+            EXPECT_THROW(Reader{ path }, std::runtime_error);
+        }
+
+        TEST(MWPhysicsReplayTest, worldShouldFollowAddedAndRemovedObjects)
+        {
+            World world;
+            world.apply(makeFrame());
+            EXPECT_EQ(world.getCollisionWorld().getNumCollisionObjects(), 3);
+
+            Frame removal;
+            removal.mRemovedObjects = { 3 };
+            world.apply(removal);
+            EXPECT_EQ(world.getCollisionWorld().getNumCollisionObjects(), 2);
+        }
+
+        TEST(MWPhysicsReplayTest, replayedActorShouldWalkOnGround)
+        {
+            const Frame frame = makeFrame();
+            World world;
+            world.apply(frame);
+            std::vector<ActorFrameData> actors = world.makeActorFrameData(frame);
+            ASSERT_EQ(actors.size(), 1);
+            ASSERT_NE(actors[0].mCollisionObject, nullptr);
+            ASSERT_NE(actors[0].mStandingOn, nullptr);
+
+            const WorldFrameData worldData(false, osg::Vec3f());
+            for (unsigned step = 0; step < frame.mNumSteps; ++step)
+            {
+                MovementSolver::move(actors[0], frame.mPhysicsDt, &world.getCollisionWorld(), worldData);
+                world.updateActorPosition(actors[0], frame.mActors[0]);
+            }
+
+            EXPECT_GT(actors[0].mPosition.x(), 0);
+            EXPECT_NEAR(actors[0].mPosition.z(), 0, 1);
+            EXPECT_EQ(actors[0].mCollisionObject->getWorldTransform().getOrigin().x(), actors[0].mPosition.x());
+        }
+
+        TEST(MWPhysicsReplayTest, sleepingActorShouldNotMove)
+        {
+            const Frame frame = makeFrame();
+            World world;
+            world.apply(frame);
+            std::vector<ActorFrameData> actors = world.makeActorFrameData(frame);
+            ASSERT_EQ(actors.size(), 1);
+            actors[0].mSleeping = true;
+
+            MovementSolver::move(actors[0], frame.mPhysicsDt, &world.getCollisionWorld(), WorldFrameData(false, {}));
+
+            EXPECT_EQ(actors[0].mPosition, frame.mActors[0].mPosition);
+        }
+
+        void getAabb(const btCollisionObject& object, btVector3& aabbMin, btVector3& aabbMax)
+        {
+            object.getCollisionShape()->getAabb(object.getWorldTransform(), aabbMin, aabbMax);
+        }
+
+        TEST(MWPhysicsReplayTest, removedGroundShouldWakeUpSleepingActor)
+        {
+            const Frame frame = makeFrame();
+            World world;
+            world.apply(frame);
+            std::vector<ActorFrameData> actors = world.makeActorFrameData(frame);
+            ASSERT_EQ(actors.size(), 1);
+            ASSERT_NE(actors[0].mStandingOn, nullptr);
+            actors[0].mMovement = osg::Vec3f();
+            actors[0].mSleeping = true;
+
+            btVector3 actorMin;
+            btVector3 actorMax;
+            getAabb(*actors[0].mCollisionObject, actorMin, actorMax);
+            btVector3 groundMin;
+            btVector3 groundMax;
+            getAabb(*actors[0].mStandingOn, groundMin, groundMax);
+            EXPECT_TRUE(Actor::isDisturbedBy(actorMin, actorMax, groundMin, groundMax));
+
+            btBoxShape farShape(btVector3(24, 24, 64));
+            btCollisionObject farObject;
+            farObject.setCollisionShape(&farShape);
+            farObject.getWorldTransform().setOrigin(btVector3(500, 500, 100));
+            btVector3 farMin;
+            btVector3 farMax;
+            getAabb(farObject, farMin, farMax);
+            EXPECT_FALSE(Actor::isDisturbedBy(actorMin, actorMax, farMin, farMax));
+
+            Frame removal;
+            removal.mRemovedObjects = { 1 };
+            world.apply(removal);
+            actors[0].mStandingOn = nullptr;
+
+            const WorldFrameData worldData(false, osg::Vec3f());
+            MovementSolver::move(actors[0], frame.mPhysicsDt, &world.getCollisionWorld(), worldData);
+            EXPECT_TRUE(actors[0].mIsOnGround);
+
+            actors[0].mSleeping = false;
+            MovementSolver::move(actors[0], frame.mPhysicsDt, &world.getCollisionWorld(), worldData);
+            EXPECT_FALSE(actors[0].mIsOnGround);
+        }
+    }
+}
@@ -9,7 +9,7 @@
 #include <zlib.h>
 
 #include <components/esm/fourcc.hpp>
-#include <components/files/constrainedfilestream.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/vfs/pathutil.hpp>
 
@@ -621,7 +621,7 @@ namespace Bsa
         for (const auto& c : fileRecord.texturesChunks)
         {
             const uint32_t inputSize = c.packedSize != 0 ? c.packedSize : c.size;
-            Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+            Files::IStreamPtr streamPtr = openStream(c.offset, inputSize);
             if (c.packedSize != 0)
             {
                 streamPtr->read(inputBuffer.data(), c.packedSize);
@@ -8,7 +8,7 @@
 #include <zlib.h>
 
 #include <components/esm/fourcc.hpp>
-#include <components/files/constrainedfilestream.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/vfs/pathutil.hpp>
 
@@ -173,24 +173,19 @@ namespace Bsa
 
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
-        const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
+        if (!fileRecord.packedSize)
+            return openStream(fileRecord.offset, fileRecord.size);
+        const uint32_t inputSize = fileRecord.packedSize;
+        Files::IStreamPtr streamPtr = openStream(fileRecord.offset, inputSize);
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
-        if (fileRecord.packedSize)
-        {
-            std::vector<char> buffer(inputSize);
-            streamPtr->read(buffer.data(), inputSize);
-            uLongf destSize = static_cast<uLongf>(fileRecord.size);
-            int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
-
-            if (ec != Z_OK)
-                fail("zlib uncompress failed: " + std::string(::zError(ec)));
-        }
-        else
-        {
-            streamPtr->read(memoryStreamPtr->getRawData(), fileRecord.size);
-        }
+        std::vector<char> buffer(inputSize);
+        streamPtr->read(buffer.data(), inputSize);
+        uLongf destSize = static_cast<uLongf>(fileRecord.size);
+        int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
+            reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
+
+        if (ec != Z_OK)
+            fail("zlib uncompress failed: " + std::string(::zError(ec)));
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
 
@@ -33,10 +33,14 @@
 #include <istream>
 #include <system_error>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 
+#include "memorystream.hpp"
+
 using namespace Bsa;
 
 /// Error handling
@@ -268,6 +272,15 @@ void BSAFile::open(const std::filesystem::path& file)
         std::ifstream input(mFilepath, std::ios_base::binary);
         readHeader(input);
         mIsLoaded = true;
+
+        try
+        {
+            mMapping = std::make_shared<const Platform::File::MemoryMapping>(mFilepath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Files of archive " << mFilepath << " will be read from disk: " << e.what();
+        }
     }
     else
     {
@@ -287,12 +300,21 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMapping.reset();
     mIsLoaded = false;
 }
 
+Files::IStreamPtr Bsa::BSAFile::openStream(std::size_t offset, std::size_t size) const
+{
+    if (mMapping != nullptr && offset <= mMapping->size() && size <= mMapping->size() - offset)
+        return std::make_unique<Files::StreamWithBuffer<MappedInputStream>>(
+            std::make_unique<MappedInputStream>(mMapping, offset, size));
+    return Files::openConstrainedFileStream(mFilepath, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->mOffset, file->mFileSize);
+    return openStream(file->mOffset, file->mFileSize);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -300,6 +322,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // Data of the files is moved around, streams opened before keep reading the old mapping
+    mMapping.reset();
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
@@ -27,11 +27,13 @@
 #include <cstdint>
 #include <filesystem>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
@@ -92,6 +94,9 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Whole archive mapped into memory and shared with the streams of its files, null if files are read from disk
+        std::shared_ptr<const Platform::File::MemoryMapping> mMapping;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
@@ -99,6 +104,10 @@ namespace Bsa
         virtual void readHeader(std::istream& input);
         virtual void writeHeader();
 
+        /// Open a stream reading a part of the archive, it points into the archive mapping when there is one
+        /// @note Thread safe.
+        Files::IStreamPtr openStream(std::size_t offset, std::size_t size) const;
+
     public:
         /* -----------------------------------
          * BSA management methods
@@ -34,8 +34,8 @@
 #include <lz4frame.h>
 #include <zlib.h>
 
-#include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -266,8 +266,10 @@ namespace Bsa
     {
         size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
         size_t resultSize = size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.mOffset, size);
         bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+        if (!compressed && (mHeader.mFlags & ArchiveFlag_EmbeddedNames) == 0)
+            return openStream(fileRecord.mOffset, size);
+        Files::IStreamPtr streamPtr = openStream(fileRecord.mOffset, size);
         if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
             // Skip over the embedded file name
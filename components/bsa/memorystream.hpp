@@ -27,9 +27,11 @@
 #define OPENMW_COMPONENTS_BSA_MEMORYSTREAM_HPP
 
 #include <istream>
+#include <memory>
 #include <vector>
 
 #include <components/files/memorystream.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
@@ -54,5 +56,25 @@ namespace Bsa
         char* getRawData() { return this->data(); }
     };
 
+    /**
+        Allows to pass a part of an archive mapped into memory as Files::IStreamPtr without copying it.
+
+        The mapping is kept alive while the stream is in use.
+     */
+    class MappedInputStream : public Files::MemBuf, public std::istream
+    {
+    public:
+        explicit MappedInputStream(
+            std::shared_ptr<const Platform::File::MemoryMapping> mapping, std::size_t offset, std::size_t size)
+            : Files::MemBuf(mapping->data() + offset, size)
+            , std::istream(static_cast<std::streambuf*>(this))
+            , mMapping(std::move(mapping))
+        {
+        }
+
+    private:
+        std::shared_ptr<const Platform::File::MemoryMapping> mMapping;
+    };
+
 }
 #endif
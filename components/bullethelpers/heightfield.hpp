@@ -3,12 +3,62 @@
 
 #include <LinearMath/btVector3.h>
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
 namespace BulletHelpers
 {
     inline btVector3 getHeightfieldShift(int x, int y, int size, float minHeight, float maxHeight)
     {
         return btVector3((x + 0.5f) * size, (y + 0.5f) * size, (maxHeight + minHeight) * 0.5f);
     }
+
+    struct HeightfieldGrid
+    {
+        const float* mHeights = nullptr;
+        int mVerts = 0;
+        float mOriginX = 0;
+        float mOriginY = 0;
+        float mVertexSpacing = 1;
+    };
+
+    /// @brief Get heights of a heightfield at many positions at once
+    /// Heights are interpolated over the same triangles btHeightfieldTerrainShape with diamond subdivision collides
+    /// with, not bilinearly. Positions outside of the heightfield are clamped to its border.
+    inline void getHeightfieldHeights(
+        const HeightfieldGrid& grid, std::span<const float> x, std::span<const float> y, std::span<float> result)
+    {
+        assert(grid.mVerts >= 2);
+        assert(x.size() == y.size() && x.size() == result.size());
+        const int verts = grid.mVerts;
+        const float maxCoordinate = static_cast<float>(verts - 1);
+        const float inverseSpacing = 1.f / grid.mVertexSpacing;
+        for (std::size_t i = 0; i < result.size(); ++i)
+        {
+            const float gridX = std::clamp((x[i] - grid.mOriginX) * inverseSpacing, 0.f, maxCoordinate);
+            const float gridY = std::clamp((y[i] - grid.mOriginY) * inverseSpacing, 0.f, maxCoordinate);
+            const int cellX = std::min(static_cast<int>(gridX), verts - 2);
+            const int cellY = std::min(static_cast<int>(gridY), verts - 2);
+            const float fx = gridX - cellX;
+            const float fy = gridY - cellY;
+
+            const float* const cell = grid.mHeights + static_cast<std::ptrdiff_t>(cellY) * verts + cellX;
+            const float h00 = cell[0];
+            const float h10 = cell[1];
+            const float h01 = cell[verts];
+            const float h11 = cell[verts + 1];
+
+            // Diamond subdivision splits quads with even cellX + cellY from (0, 0) to (1, 1), others from (1, 0) to
+            // (0, 1)
+            const float evenHeight = fy >= fx ? h00 + fx * (h11 - h01) + fy * (h01 - h00)
+                                              : h00 + fx * (h10 - h00) + fy * (h11 - h10);
+            const float oddHeight = fx + fy <= 1 ? h00 + fx * (h10 - h00) + fy * (h01 - h00)
+                                                 : h11 + (1 - fx) * (h01 - h11) + (1 - fy) * (h10 - h11);
+            result[i] = ((cellX + cellY) & 1) == 0 ? evenHeight : oddHeight;
+        }
+    }
 }
 
 #endif
@@ -0,0 +1,123 @@
+#ifndef OPENMW_COMPONENTS_MISC_WORKSTEALINGRANGES_H
+#define OPENMW_COMPONENTS_MISC_WORKSTEALINGRANGES_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Distribute job indices between workers without a shared counter
+    /// Each worker takes batches from the front of its own range. A worker that runs out steals half of the jobs
+    /// left in another worker's range, so slow workers don't hold back the others.
+    class WorkStealingRanges
+    {
+    public:
+        struct Batch
+        {
+            std::uint32_t mBegin = 0;
+            std::uint32_t mEnd = 0;
+
+            bool empty() const { return mBegin >= mEnd; }
+            std::uint32_t size() const { return empty() ? 0 : mEnd - mBegin; }
+        };
+
+        explicit WorkStealingRanges(std::size_t workerCount)
+            : mRanges(std::max<std::size_t>(workerCount, 1))
+        {
+        }
+
+        std::size_t getWorkerCount() const { return mRanges.size(); }
+
+        /// @brief split jobs [0, jobCount) evenly between workers
+        /// Must not be called concurrently with take
+        void reset(std::uint32_t jobCount, std::uint32_t batchSize)
+        {
+            mBatchSize.store(std::max<std::uint32_t>(batchSize, 1), std::memory_order_relaxed);
+            const std::uint64_t count = mRanges.size();
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                const auto begin = static_cast<std::uint32_t>(jobCount * i / count);
+                const auto end = static_cast<std::uint32_t>(jobCount * (i + 1) / count);
+                mRanges[i].mValue.store(pack(Batch{ begin, end }), std::memory_order_relaxed);
+            }
+        }
+
+        /// @return next jobs to run for the worker, empty when no worker has any jobs left
+        Batch take(std::size_t worker)
+        {
+            Range& own = mRanges[worker % mRanges.size()];
+            if (const std::optional<Batch> batch = takeFront(own))
+                return *batch;
+            for (std::size_t i = 1; i < mRanges.size(); ++i)
+            {
+                const std::optional<Batch> stolen = stealBack(mRanges[(worker + i) % mRanges.size()]);
+                if (!stolen.has_value())
+                    continue;
+                // Keep the rest of the stolen jobs where others can steal them back, unless a reset refilled the
+                // own range meanwhile
+                const std::uint32_t split
+                    = stolen->mBegin + std::min(mBatchSize.load(std::memory_order_relaxed), stolen->size());
+                std::uint64_t expected = own.mValue.load(std::memory_order_acquire);
+                if (!unpack(expected).empty()
+                    || !own.mValue.compare_exchange_strong(expected, pack(Batch{ split, stolen->mEnd }),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                    return *stolen;
+                return Batch{ stolen->mBegin, split };
+            }
+            return Batch{};
+        }
+
+    private:
+        struct alignas(64) Range
+        {
+            std::atomic<std::uint64_t> mValue{ 0 };
+        };
+
+        static std::uint64_t pack(Batch batch) { return (std::uint64_t{ batch.mBegin } << 32) | batch.mEnd; }
+
+        static Batch unpack(std::uint64_t value)
+        {
+            return Batch{ static_cast<std::uint32_t>(value >> 32), static_cast<std::uint32_t>(value) };
+        }
+
+        std::optional<Batch> takeFront(Range& range) const
+        {
+            std::uint64_t value = range.mValue.load(std::memory_order_acquire);
+            while (true)
+            {
+                const Batch current = unpack(value);
+                if (current.empty())
+                    return std::nullopt;
+                const std::uint32_t split
+                    = current.mBegin + std::min(mBatchSize.load(std::memory_order_relaxed), current.size());
+                if (range.mValue.compare_exchange_weak(value, pack(Batch{ split, current.mEnd }),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                    return Batch{ current.mBegin, split };
+            }
+        }
+
+        static std::optional<Batch> stealBack(Range& range)
+        {
+            std::uint64_t value = range.mValue.load(std::memory_order_acquire);
+            while (true)
+            {
+                const Batch current = unpack(value);
+                if (current.empty())
+                    return std::nullopt;
+                const std::uint32_t split = current.mEnd - (current.size() + 1) / 2;
+                if (range.mValue.compare_exchange_weak(value, pack(Batch{ current.mBegin, split }),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                    return Batch{ split, current.mEnd };
+            }
+        }
+
+        std::vector<Range> mRanges;
+        std::atomic<std::uint32_t> mBatchSize{ 1 };
+    };
+}
+
+#endif
@@ -537,10 +537,13 @@ namespace MyGUIPlatform
 
         void update();
 
+        bool needsRedraw() const;
+
         RenderManager* mParent;
         osg::ref_ptr<Drawable> mDrawable;
         MyGUI::RenderTargetInfo mInfo;
         bool mUpdate;
+        bool mHasDynamicContent = false;
         std::string mFilter;
     };
 
@@ -555,6 +558,7 @@ namespace MyGUIPlatform
         mDrawable->clear();
         // variance will be recomputed based on textures being rendered in this frame
         mDrawable->setDataVariance(osg::Object::STATIC);
+        mHasDynamicContent = false;
     }
 
     void Drawable::CollectDrawCalls::operator()(osg::Node*, osg::NodeVisitor*)
@@ -676,6 +680,8 @@ namespace MyGUIPlatform
             batch.mTexture = osgtexture->getTexture();
             if (batch.mTexture->getDataVariance() == osg::Object::DYNAMIC)
                 mDrawable->setDataVariance(osg::Object::DYNAMIC); // only for this frame, reset in begin()
+            if (batch.mTexture->getDataVariance() == osg::Object::DYNAMIC || osgtexture->isExternal())
+                mHasDynamicContent = true;
             if (!mInjectState && osgtexture->getInjectState())
                 batch.mStateSet = osgtexture->getInjectState();
         }
@@ -772,6 +778,33 @@ namespace MyGUIPlatform
             setViewSize(viewSize);
     }
 
+    bool GUICamera::needsRedraw() const
+    {
+        if (mUpdate || mHasDynamicContent)
+            return true;
+
+        auto viewSize = mParent->getViewSize();
+        auto viewport = getViewport();
+        if (!viewport || viewport->width() != viewSize.width || viewport->height() != viewSize.height)
+            return true;
+
+        // MyGUI flags render items as out of date whenever a widget's geometry, skin state or text changes, and
+        // clears the flag once the items are rendered again. Layers also flag themselves when root widgets are
+        // created, destroyed or reordered, which no remaining node shows.
+        MyGUI::LayerManager* myGUILayers = MyGUI::LayerManager::getInstancePtr();
+        if (myGUILayers == nullptr)
+            return false;
+        for (unsigned i = 0; i < myGUILayers->getLayerCount(); i++)
+        {
+            auto layer = myGUILayers->getLayer(i);
+            if (!mFilter.empty() && mFilter.find(layer->getName()) == std::string::npos)
+                continue;
+            if (layer->isOutOfDate())
+                return true;
+        }
+        return false;
+    }
+
     void RenderManager::setViewSize(int width, int height)
     {
         if (width < 1)
@@ -786,6 +819,11 @@ namespace MyGUIPlatform
     osg::ref_ptr<osg::Camera> RenderManager::createGUICamera(int order, std::string layerFilter)
     {
         return new GUICamera(static_cast<osg::Camera::RenderOrder>(order), mGuiStateSet, this, layerFilter);
+    }
+
+    bool RenderManager::guiCameraNeedsRedraw(const osg::Camera* guiCamera)
+    {
+        return static_cast<const GUICamera*>(guiCamera)->needsRedraw();
 //## VR_PATCH END
     }
 
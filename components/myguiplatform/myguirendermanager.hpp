@@ -121,6 +121,11 @@ namespace MyGUIPlatform
             const std::string& fragmentProgramFile) override;
 
         osg::ref_ptr<osg::Camera> createGUICamera(int order, std::string layerFilter);
+
+        /// Whether a camera created by createGUICamera would draw anything different from what it drew last. True
+        /// if a widget on one of its layers changed, the view was resized or the last draw sampled a texture that may
+        /// change on its own, such as a video or a render target.
+        static bool guiCameraNeedsRedraw(const osg::Camera* guiCamera);
 //## VR_PATCH END
     };
 
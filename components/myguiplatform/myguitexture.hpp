@@ -75,6 +75,10 @@ namespace MyGUIPlatform
         /*internal:*/
 //## VR_PATCH BEGIN
         osg::Texture* getTexture() const { return mTexture.get(); }
+
+        /// True if this wraps a texture owned elsewhere, such as a render target, whose contents can change without
+        /// MyGUI noticing.
+        bool isExternal() const { return mImageManager == nullptr; }
 //## VR_PATCH END
     };
 
@@ -278,7 +278,7 @@ namespace Nif
         }
     }
 
-    std::unique_ptr<btCollisionShape> NiTriShape::getCollisionShape() const
+    std::unique_ptr<btCollisionShape> NiTriShape::getCollisionShape(bool buildBvh) const
     {
         if (mData.empty() || mData->mVertices.empty())
             return nullptr;
@@ -314,13 +314,13 @@ namespace Nif
         if (mesh->getNumTriangles() == 0)
             return nullptr;
 
-        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true);
+        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true, buildBvh);
         std::ignore = mesh.release();
 
         return shape;
     }
 
-    std::unique_ptr<btCollisionShape> NiTriStrips::getCollisionShape() const
+    std::unique_ptr<btCollisionShape> NiTriStrips::getCollisionShape(bool buildBvh) const
     {
         if (mData.empty() || mData->mVertices.empty())
             return nullptr;
@@ -355,18 +355,18 @@ namespace Nif
         if (mesh->getNumTriangles() == 0)
             return nullptr;
 
-        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true);
+        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true, buildBvh);
         std::ignore = mesh.release();
 
         return shape;
     }
 
-    std::unique_ptr<btCollisionShape> NiLines::getCollisionShape() const
+    std::unique_ptr<btCollisionShape> NiLines::getCollisionShape(bool /*buildBvh*/) const
     {
         return nullptr;
     }
 
-    std::unique_ptr<btCollisionShape> NiParticles::getCollisionShape() const
+    std::unique_ptr<btCollisionShape> NiParticles::getCollisionShape(bool /*buildBvh*/) const
     {
         return nullptr;
     }
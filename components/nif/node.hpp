@@ -149,7 +149,8 @@ namespace Nif
         void read(NIFStream* nif) override;
         void post(Reader& nif) override;
 
-        virtual std::unique_ptr<btCollisionShape> getCollisionShape() const
+        /// @param buildBvh build the BVH of triangle meshes, otherwise it has to be set before the shape is used
+        virtual std::unique_ptr<btCollisionShape> getCollisionShape(bool buildBvh) const
         {
             throw std::runtime_error("NiGeometry::getCollisionShape() called on base class");
         }
@@ -162,7 +163,7 @@ namespace Nif
 
     struct NiTriShape : NiTriBasedGeom
     {
-        std::unique_ptr<btCollisionShape> getCollisionShape() const override;
+        std::unique_ptr<btCollisionShape> getCollisionShape(bool buildBvh) const override;
     };
 
     struct BSSegmentedTriShape : NiTriShape
@@ -183,17 +184,17 @@ namespace Nif
 
     struct NiTriStrips : NiTriBasedGeom
     {
-        std::unique_ptr<btCollisionShape> getCollisionShape() const override;
+        std::unique_ptr<btCollisionShape> getCollisionShape(bool buildBvh) const override;
     };
 
     struct NiLines : NiTriBasedGeom
     {
-        std::unique_ptr<btCollisionShape> getCollisionShape() const override;
+        std::unique_ptr<btCollisionShape> getCollisionShape(bool buildBvh) const override;
     };
 
     struct NiParticles : NiGeometry
     {
-        std::unique_ptr<btCollisionShape> getCollisionShape() const override;
+        std::unique_ptr<btCollisionShape> getCollisionShape(bool buildBvh) const override;
     };
 
     struct BSLODTriShape : NiTriShape
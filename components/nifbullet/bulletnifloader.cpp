@@ -30,9 +30,10 @@ namespace
 namespace NifBullet
 {
 
-    osg::ref_ptr<Resource::BulletShape> BulletNifLoader::load(Nif::FileView nif)
+    osg::ref_ptr<Resource::BulletShape> BulletNifLoader::load(Nif::FileView nif, bool buildBvh)
     {
         mShape = new Resource::BulletShape;
+        mBuildBvh = buildBvh;
 
         mCompoundShape.reset();
         mAvoidCompoundShape.reset();
@@ -279,7 +280,7 @@ namespace NifBullet
         if (!niGeometry.mSkin.empty())
             args.mAnimated = false;
 
-        std::unique_ptr<btCollisionShape> childShape = niGeometry.getCollisionShape();
+        std::unique_ptr<btCollisionShape> childShape = niGeometry.getCollisionShape(mBuildBvh);
         if (childShape == nullptr)
             return;
 
@@ -45,7 +45,8 @@ namespace NifBullet
             abort();
         }
 
-        osg::ref_ptr<Resource::BulletShape> load(Nif::FileView file);
+        /// @param buildBvh see Nif::NiGeometry::getCollisionShape
+        osg::ref_ptr<Resource::BulletShape> load(Nif::FileView file, bool buildBvh = true);
 
     private:
         bool findBoundingBox(const Nif::NiAVObject& node);
@@ -68,6 +69,7 @@ namespace NifBullet
         std::unique_ptr<btCompoundShape, Resource::DeleteCollisionShape> mAvoidCompoundShape;
 
         osg::ref_ptr<Resource::BulletShape> mShape;
+        bool mBuildBvh = true;
     };
 
 }
@@ -63,6 +63,22 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    /// Read only mapping of a whole file into memory. The mapping stays valid when the file is closed.
+    class MemoryMapping
+    {
+        const char* mData = nullptr;
+        size_t mSize = 0;
+
+    public:
+        explicit MemoryMapping(const std::filesystem::path& filename);
+        MemoryMapping(const MemoryMapping& other) = delete;
+        MemoryMapping& operator=(const MemoryMapping& other) = delete;
+        ~MemoryMapping();
+
+        const char* data() const { return mData; }
+        size_t size() const { return mSize; }
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
@@ -93,4 +93,12 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    MemoryMapping::MemoryMapping(const std::filesystem::path& filename)
+    {
+        throw std::runtime_error(
+            "Failed to map '" + Files::pathToUnicodeString(filename) + "' into memory: not supported on this platform");
+    }
+
+    MemoryMapping::~MemoryMapping() = default;
+
 }
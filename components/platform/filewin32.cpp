@@ -99,4 +99,35 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    MemoryMapping::MemoryMapping(const std::filesystem::path& filename)
+    {
+        const ScopedHandle handle = open(filename);
+        const size_t fileSize = Platform::File::size(handle);
+        if (fileSize == 0)
+            return;
+        const HANDLE mapping = CreateFileMappingW(getNativeHandle(handle), nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "' into memory: " + std::to_string(GetLastError()));
+        }
+        // The view keeps the mapping object alive
+        const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        const DWORD errCode = GetLastError();
+        CloseHandle(mapping);
+        if (data == nullptr)
+        {
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "' into memory: " + std::to_string(errCode));
+        }
+        mData = static_cast<const char*>(data);
+        mSize = fileSize;
+    }
+
+    MemoryMapping::~MemoryMapping()
+    {
+        if (mData != nullptr)
+            UnmapViewOfFile(mData);
+    }
 }
@@ -1,12 +1,23 @@
 #include "bulletshape.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <BulletCollision/CollisionShapes/btBoxShape.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
 #include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 
 namespace Resource
 {
@@ -52,6 +63,16 @@ namespace Resource
                 return CollisionShapePtr(new btBoxShape(*boxshape));
             }
 
+            if (shape->getShapeType() == CONVEX_HULL_SHAPE_PROXYTYPE)
+            {
+                const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+                auto newShape = std::make_unique<btConvexHullShape>(
+                    &hull->getUnscaledPoints()->getX(), hull->getNumPoints(), static_cast<int>(sizeof(btVector3)));
+                newShape->setLocalScaling(hull->getLocalScaling());
+                newShape->setMargin(hull->getMargin());
+                return CollisionShapePtr(newShape.release());
+            }
+
             if (shape->getShapeType() == TERRAIN_SHAPE_PROXYTYPE)
                 return CollisionShapePtr(
                     new btHeightfieldTerrainShape(static_cast<const btHeightfieldTerrainShape&>(*shape)));
@@ -59,6 +80,107 @@ namespace Resource
             throw std::logic_error(std::string("Unhandled Bullet shape duplication: ") + shape->getName());
         }
 
+        using Triangle = std::array<btVector3, 3>;
+
+        struct CollectTriangles : btInternalTriangleIndexCallback
+        {
+            std::vector<Triangle> mTriangles;
+
+            void internalProcessTriangleIndex(btVector3* triangle, int /*partId*/, int /*triangleIndex*/) override
+            {
+                mTriangles.push_back({ triangle[0], triangle[1], triangle[2] });
+            }
+        };
+
+        CollisionShapePtr makeConvexHull(const std::vector<Triangle>& triangles, const btVector3& scale)
+        {
+            auto hull = std::make_unique<btConvexHullShape>();
+            for (const Triangle& triangle : triangles)
+                for (const btVector3& vertex : triangle)
+                    hull->addPoint(vertex, false);
+            // Keep only the points on the hull
+            hull->optimizeConvexHull();
+            hull->setLocalScaling(scale);
+            return CollisionShapePtr(hull.release());
+        }
+
+        // Vertex clustering: the vertices within each cell of a grid are merged into their average and the triangles
+        // collapsing in the process are dropped. Unlike a convex hull, openings wider than a cell such as doorways and
+        // the space under arches stay open for actors and line of sight.
+        std::vector<Triangle> decimate(const std::vector<Triangle>& triangles, const btVector3& scale)
+        {
+            // In world units, no vertex moves further than the diagonal of a cell
+            constexpr float cellSize = 8;
+
+            btVector3 cellScale;
+            for (int i = 0; i < 3; ++i)
+                cellScale[i] = std::abs(scale[i]) / cellSize;
+
+            std::map<std::array<int, 3>, std::size_t> cells;
+            std::vector<btVector3> sums;
+            std::vector<int> counts;
+            std::set<std::array<std::size_t, 3>> clusteredTriangles;
+            for (const Triangle& triangle : triangles)
+            {
+                std::array<std::size_t, 3> clusters;
+                for (std::size_t v = 0; v < 3; ++v)
+                {
+                    std::array<int, 3> cell;
+                    for (int i = 0; i < 3; ++i)
+                        cell[i] = static_cast<int>(std::floor(triangle[v][i] * cellScale[i]));
+                    const auto [it, inserted] = cells.emplace(cell, sums.size());
+                    if (inserted)
+                    {
+                        sums.emplace_back(0, 0, 0);
+                        counts.push_back(0);
+                    }
+                    sums[it->second] += triangle[v];
+                    ++counts[it->second];
+                    clusters[v] = it->second;
+                }
+                if (clusters[0] == clusters[1] || clusters[1] == clusters[2] || clusters[0] == clusters[2])
+                    continue;
+                // Both sides of a triangle collide, so the winding doesn't matter when looking for duplicates
+                std::sort(clusters.begin(), clusters.end());
+                clusteredTriangles.insert(clusters);
+            }
+
+            std::vector<Triangle> result;
+            result.reserve(clusteredTriangles.size());
+            for (const auto& clusters : clusteredTriangles)
+            {
+                Triangle& triangle = result.emplace_back();
+                for (std::size_t v = 0; v < 3; ++v)
+                    triangle[v] = sums[clusters[v]] / static_cast<btScalar>(counts[clusters[v]]);
+            }
+            return result;
+        }
+
+        CollisionShapePtr makeSimplifiedTriangleMesh(const btBvhTriangleMeshShape& shape, const btVector3& scale)
+        {
+            CollectTriangles collect;
+            const btVector3 infinity(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+            shape.getMeshInterface()->InternalProcessAllTriangles(&collect, -infinity, infinity);
+            if (collect.mTriangles.empty())
+                return nullptr;
+
+            const std::vector<Triangle> decimated = decimate(collect.mTriangles, scale);
+            // Every triangle is within a couple of cells, the mesh is too small to have openings to keep
+            if (decimated.empty())
+                return makeConvexHull(collect.mTriangles, scale);
+            // Not enough detail to be worth another shape
+            if (decimated.size() * 4 > collect.mTriangles.size() * 3)
+                return nullptr;
+
+            auto triangleMesh = std::make_unique<btTriangleMesh>();
+            for (const Triangle& triangle : decimated)
+                triangleMesh->addTriangle(triangle[0], triangle[1], triangle[2]);
+            auto mesh = std::make_unique<TriangleMeshShape>(triangleMesh.release(), true);
+            if (scale == btVector3(1, 1, 1))
+                return CollisionShapePtr(mesh.release());
+            return CollisionShapePtr(new ScaledTriangleMeshShape(mesh.release(), scale));
+        }
+
         void deleteShape(btCollisionShape* shape)
         {
             if (shape->isCompound())
@@ -82,6 +204,7 @@ namespace Resource
         : Object(other, copyOp)
         , mCollisionShape(duplicateCollisionShape(other.mCollisionShape.get()))
         , mAvoidCollisionShape(duplicateCollisionShape(other.mAvoidCollisionShape.get()))
+        , mSimplifiedCollisionShape(duplicateCollisionShape(other.mSimplifiedCollisionShape.get()))
         , mCollisionBox(other.mCollisionBox)
         , mAnimatedShapes(other.mAnimatedShapes)
         , mFileName(other.mFileName)
@@ -95,6 +218,8 @@ namespace Resource
         mCollisionShape->setLocalScaling(scale);
         if (mAvoidCollisionShape)
             mAvoidCollisionShape->setLocalScaling(scale);
+        if (mSimplifiedCollisionShape)
+            mSimplifiedCollisionShape->setLocalScaling(scale);
     }
 
     osg::ref_ptr<BulletShapeInstance> makeInstance(osg::ref_ptr<const BulletShape> source)
@@ -102,6 +227,58 @@ namespace Resource
         return { new BulletShapeInstance(std::move(source)) };
     }
 
+    CollisionShapePtr makeSimplifiedCollisionShape(const btCollisionShape& shape)
+    {
+        if (shape.isCompound())
+        {
+            const btCompoundShape& compound = static_cast<const btCompoundShape&>(shape);
+            std::unique_ptr<btCompoundShape, DeleteCollisionShape> newShape(new btCompoundShape);
+            bool simplified = false;
+            for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+            {
+                const btCollisionShape& child = *compound.getChildShape(i);
+                CollisionShapePtr newChild = makeSimplifiedCollisionShape(child);
+                if (newChild != nullptr)
+                    simplified = true;
+                else
+                    newChild = duplicateCollisionShape(&child);
+                newShape->addChildShape(compound.getChildTransform(i), newChild.release());
+            }
+            if (!simplified)
+                return nullptr;
+            return newShape;
+        }
+
+        if (shape.getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
+        {
+            const auto& scaled = static_cast<const btScaledBvhTriangleMeshShape&>(shape);
+            return makeSimplifiedTriangleMesh(*scaled.getChildShape(), scaled.getLocalScaling());
+        }
+
+        if (shape.getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+            return makeSimplifiedTriangleMesh(static_cast<const btBvhTriangleMeshShape&>(shape), btVector3(1, 1, 1));
+
+        return nullptr;
+    }
+
+    bool TriangleMeshShape::setSerializedBvh(std::span<const std::byte> data)
+    {
+        if (m_bvh != nullptr || data.empty())
+            return false;
+        // The BVH is deserialized in place and keeps pointing into the buffer
+        void* buffer = btAlignedAlloc(data.size(), 16);
+        std::memcpy(buffer, data.data(), data.size());
+        btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(buffer, static_cast<unsigned>(data.size()), false);
+        if (bvh == nullptr)
+        {
+            btAlignedFree(buffer);
+            return false;
+        }
+        setOptimizedBvh(bvh);
+        mBvhBuffer = buffer;
+        return true;
+    }
+
     BulletShapeInstance::BulletShapeInstance(osg::ref_ptr<const BulletShape> source)
         : BulletShape(*source)
         , mSource(std::move(source))
@@ -1,14 +1,17 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_BULLETSHAPE_H
 #define OPENMW_COMPONENTS_RESOURCE_BULLETSHAPE_H
 
+#include <cstddef>
 #include <map>
 #include <memory>
+#include <span>
 
 #include <osg/Object>
 #include <osg/Vec3f>
 #include <osg/ref_ptr>
 
 #include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
 #include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 
 #include <components/vfs/pathutil.hpp>
@@ -47,6 +50,11 @@ namespace Resource
         CollisionShapePtr mCollisionShape;
         CollisionShapePtr mAvoidCollisionShape;
 
+        // A cheaper approximation of mCollisionShape for objects far from the player, see
+        // makeSimplifiedCollisionShape. Not generated for animated shapes, shapes without detail to remove and
+        // unless requested from BulletShapeManager.
+        CollisionShapePtr mSimplifiedCollisionShape;
+
         // Used for actors and projectiles. mCollisionShape is used for actors only when we need to autogenerate
         // collision box for creatures. For now, use one file <-> one resource for simplicity.
         CollisionBox mCollisionBox;
@@ -89,6 +97,11 @@ namespace Resource
 
     osg::ref_ptr<BulletShapeInstance> makeInstance(osg::ref_ptr<const BulletShape> source);
 
+    /// Replace triangle meshes by decimated ones keeping their openings, or by their convex hulls when they are too
+    /// thin to have any. Recurses into compound shapes so separate parts stay separate, other shapes are copied.
+    /// @return nullptr if no part of the shape can be simplified
+    CollisionShapePtr makeSimplifiedCollisionShape(const btCollisionShape& shape);
+
     // Subclass btBhvTriangleMeshShape to auto-delete the meshInterface
     struct TriangleMeshShape : public btBvhTriangleMeshShape
     {
@@ -102,7 +115,19 @@ namespace Resource
         {
             delete getTriangleInfoMap();
             delete m_meshInterface;
+            if (mBvhBuffer != nullptr)
+            {
+                m_bvh->~btOptimizedBvh();
+                btAlignedFree(mBvhBuffer);
+            }
         }
+
+        /// Use a BVH written by btOptimizedBvh::serializeInPlace instead of building one. The data is copied.
+        /// @return false if the data can't be used, the shape has no BVH then
+        bool setSerializedBvh(std::span<const std::byte> data);
+
+    private:
+        void* mBvhBuffer = nullptr;
     };
 
     // btScaledBvhTriangleMeshShape that auto-deletes the child shape
@@ -0,0 +1,240 @@
+#include "bulletshapedb.hpp"
+
+#include "bulletshape.hpp"
+
+#include <components/misc/endianness.hpp>
+#include <components/sqlite3/request.hpp>
+
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <LinearMath/btScalar.h>
+
+#include <sqlite3.h>
+
+#include <cstring>
+#include <memory>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr const char schema[] = R"(
+            BEGIN TRANSACTION;
+
+            CREATE TABLE IF NOT EXISTS shapes (
+                name TEXT PRIMARY KEY,
+                hash BLOB NOT NULL,
+                version INTEGER NOT NULL,
+                data BLOB NOT NULL
+            );
+
+            COMMIT;
+        )";
+
+        constexpr std::string_view getShapeDataQuery = R"(
+            SELECT data
+              FROM shapes
+             WHERE name = :name
+               AND hash = :hash
+               AND version = :version
+        )";
+
+        constexpr std::string_view insertShapeQuery = R"(
+            INSERT OR REPLACE INTO shapes ( name,  hash,  version,  data)
+                               VALUES     (:name, :hash, :version, :data)
+        )";
+
+        // BVHs are stored in the in-memory layout of Bullet, so anything that affects it is a part of the version
+        constexpr std::int64_t formatVersion = 1;
+        constexpr std::int64_t bvhVersion = (formatVersion << 32) | (std::int64_t{ BT_BULLET_VERSION } << 16)
+            | (std::int64_t{ sizeof(btScalar) } << 8) | (std::int64_t{ sizeof(void*) } << 1)
+            | std::int64_t{ Misc::IS_LITTLE_ENDIAN };
+
+        template <class Function>
+        void forEachTriangleMeshShape(btCollisionShape* shape, Function&& function)
+        {
+            if (shape == nullptr)
+                return;
+
+            if (shape->isCompound())
+            {
+                btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+                for (int i = 0, n = compound->getNumChildShapes(); i < n; ++i)
+                    forEachTriangleMeshShape(compound->getChildShape(i), function);
+                return;
+            }
+
+            if (shape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                shape = static_cast<btScaledBvhTriangleMeshShape*>(shape)->getChildShape();
+
+            if (auto* mesh = dynamic_cast<TriangleMeshShape*>(shape))
+                function(*mesh);
+        }
+
+        template <class Function>
+        void forEachTriangleMeshShape(const BulletShape& shape, Function&& function)
+        {
+            forEachTriangleMeshShape(shape.mCollisionShape.get(), function);
+            forEachTriangleMeshShape(shape.mAvoidCollisionShape.get(), function);
+        }
+
+        std::uint32_t getNumTriangles(TriangleMeshShape& mesh)
+        {
+            std::uint32_t result = 0;
+            const btStridingMeshInterface& meshInterface = *mesh.getMeshInterface();
+            for (int i = 0, n = meshInterface.getNumSubParts(); i < n; ++i)
+            {
+                const unsigned char* vertexBase = nullptr;
+                int numVerts = 0;
+                PHY_ScalarType type = PHY_FLOAT;
+                int stride = 0;
+                const unsigned char* indexBase = nullptr;
+                int indexStride = 0;
+                int numFaces = 0;
+                PHY_ScalarType indicesType = PHY_INTEGER;
+                meshInterface.getLockedReadOnlyVertexIndexBase(
+                    &vertexBase, numVerts, type, stride, &indexBase, indexStride, numFaces, indicesType, i);
+                result += static_cast<std::uint32_t>(numFaces);
+                meshInterface.unLockReadOnlyVertexBase(i);
+            }
+            return result;
+        }
+
+        void write(std::vector<std::byte>& data, std::uint32_t value)
+        {
+            const std::size_t offset = data.size();
+            data.resize(offset + sizeof(value));
+            std::memcpy(data.data() + offset, &value, sizeof(value));
+        }
+
+        bool read(std::span<const std::byte>& data, std::uint32_t& value)
+        {
+            if (data.size() < sizeof(value))
+                return false;
+            std::memcpy(&value, data.data(), sizeof(value));
+            data = data.subspan(sizeof(value));
+            return true;
+        }
+
+        struct FreeAligned
+        {
+            void operator()(void* pointer) const { btAlignedFree(pointer); }
+        };
+    }
+
+    BulletShapeDb::BulletShapeDb(std::string_view path)
+        : mDb(Sqlite3::makeDb(path, schema))
+        , mGetShapeData(*mDb, BulletShapeDbQueries::GetShapeData{})
+        , mInsertShape(*mDb, BulletShapeDbQueries::InsertShape{})
+    {
+    }
+
+    std::optional<std::vector<std::byte>> BulletShapeDb::getShapeData(
+        std::string_view name, const Sqlite3::ConstBlob& hash)
+    {
+        std::vector<std::byte> data;
+        if (&data == request(*mDb, mGetShapeData, &data, 1, name, hash, bvhVersion))
+            return {};
+        return data;
+    }
+
+    int BulletShapeDb::insertShape(
+        std::string_view name, const Sqlite3::ConstBlob& hash, const std::vector<std::byte>& data)
+    {
+        return execute(*mDb, mInsertShape, name, hash, bvhVersion, data);
+    }
+
+    std::vector<std::byte> serializeBvhs(const BulletShape& shape)
+    {
+        std::vector<std::byte> result;
+        std::uint32_t count = 0;
+        bool complete = true;
+        write(result, count);
+        forEachTriangleMeshShape(shape, [&](TriangleMeshShape& mesh) {
+            const btOptimizedBvh* bvh = mesh.getOptimizedBvh();
+            if (!complete || bvh == nullptr)
+            {
+                complete = false;
+                return;
+            }
+            const unsigned size = bvh->calculateSerializeBufferSize();
+            const std::unique_ptr<void, FreeAligned> buffer(btAlignedAlloc(size, 16));
+            if (!bvh->serializeInPlace(buffer.get(), size, false))
+            {
+                complete = false;
+                return;
+            }
+            write(result, getNumTriangles(mesh));
+            write(result, size);
+            const std::byte* const begin = static_cast<const std::byte*>(buffer.get());
+            result.insert(result.end(), begin, begin + size);
+            ++count;
+        });
+        if (!complete || count == 0)
+            return {};
+        std::memcpy(result.data(), &count, sizeof(count));
+        return result;
+    }
+
+    bool deserializeBvhs(BulletShape& shape, std::span<const std::byte> data)
+    {
+        std::uint32_t count = 0;
+        if (!read(data, count))
+            return false;
+        bool result = true;
+        forEachTriangleMeshShape(shape, [&](TriangleMeshShape& mesh) {
+            std::uint32_t numTriangles = 0;
+            std::uint32_t size = 0;
+            if (!result || count == 0 || !read(data, numTriangles) || !read(data, size) || data.size() < size
+                || numTriangles != getNumTriangles(mesh))
+            {
+                result = false;
+                return;
+            }
+            --count;
+            if (mesh.getOptimizedBvh() == nullptr)
+                result = mesh.setSerializedBvh(data.first(size));
+            data = data.subspan(size);
+        });
+        return result && count == 0 && data.empty();
+    }
+
+    void buildMissingBvhs(BulletShape& shape)
+    {
+        forEachTriangleMeshShape(shape, [](TriangleMeshShape& mesh) {
+            if (mesh.getOptimizedBvh() == nullptr)
+                mesh.buildOptimizedBvh();
+        });
+    }
+
+    namespace BulletShapeDbQueries
+    {
+        std::string_view GetShapeData::text() noexcept
+        {
+            return getShapeDataQuery;
+        }
+
+        void GetShapeData::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view name,
+            const Sqlite3::ConstBlob& hash, std::int64_t version)
+        {
+            Sqlite3::bindParameter(db, statement, ":name", name);
+            Sqlite3::bindParameter(db, statement, ":hash", hash);
+            Sqlite3::bindParameter(db, statement, ":version", version);
+        }
+
+        std::string_view InsertShape::text() noexcept
+        {
+            return insertShapeQuery;
+        }
+
+        void InsertShape::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view name,
+            const Sqlite3::ConstBlob& hash, std::int64_t version, const std::vector<std::byte>& data)
+        {
+            Sqlite3::bindParameter(db, statement, ":name", name);
+            Sqlite3::bindParameter(db, statement, ":hash", hash);
+            Sqlite3::bindParameter(db, statement, ":version", version);
+            Sqlite3::bindParameter(db, statement, ":data", data);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_BULLETSHAPEDB_H
+#define OPENMW_COMPONENTS_RESOURCE_BULLETSHAPEDB_H
+
+#include <components/sqlite3/db.hpp>
+#include <components/sqlite3/statement.hpp>
+#include <components/sqlite3/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace Resource
+{
+    struct BulletShape;
+
+    namespace BulletShapeDbQueries
+    {
+        struct GetShapeData
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view name,
+                const Sqlite3::ConstBlob& hash, std::int64_t version);
+        };
+
+        struct InsertShape
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view name,
+                const Sqlite3::ConstBlob& hash, std::int64_t version, const std::vector<std::byte>& data);
+        };
+    }
+
+    /// Stores BVHs of triangle meshes built for collision shapes, so they don't have to be built again on next load.
+    /// Shapes are identified by the file name and hash, only the latest version of each file is kept.
+    /// @note Not thread safe.
+    class BulletShapeDb
+    {
+    public:
+        explicit BulletShapeDb(std::string_view path);
+
+        std::optional<std::vector<std::byte>> getShapeData(std::string_view name, const Sqlite3::ConstBlob& hash);
+
+        int insertShape(std::string_view name, const Sqlite3::ConstBlob& hash, const std::vector<std::byte>& data);
+
+    private:
+        Sqlite3::Db mDb;
+        Sqlite3::Statement<BulletShapeDbQueries::GetShapeData> mGetShapeData;
+        Sqlite3::Statement<BulletShapeDbQueries::InsertShape> mInsertShape;
+    };
+
+    /// @return BVHs of all triangle meshes of the shape, empty if there are none
+    std::vector<std::byte> serializeBvhs(const BulletShape& shape);
+
+    /// Use the BVHs written by serializeBvhs for triangle meshes without one
+    /// @return false if the data doesn't match the shape, some meshes may be left without a BVH then
+    bool deserializeBvhs(BulletShape& shape, std::span<const std::byte> data);
+
+    /// Build BVHs of triangle meshes without one
+    void buildMissingBvhs(BulletShape& shape);
+}
+
+#endif
@@ -9,6 +9,7 @@
 
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 
+#include <components/debug/debuglog.hpp>
 #include <components/misc/convert.hpp>
 #include <components/misc/osguservalues.hpp>
 #include <components/misc/pathhelpers.hpp>
@@ -19,6 +20,7 @@
 #include <components/nifbullet/bulletnifloader.hpp>
 
 #include "bulletshape.hpp"
+#include "bulletshapedb.hpp"
 #include "multiobjectcache.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
@@ -117,7 +119,9 @@ namespace Resource
         if (Misc::getFileExtension(name.value()) == "nif")
         {
             NifBullet::BulletNifLoader loader;
-            shape = loader.load(*mNifFileManager->get(name));
+            shape = loader.load(*mNifFileManager->get(name), mShapeDb == nullptr);
+            if (mShapeDb != nullptr)
+                loadBvhs(*shape);
         }
         else
         {
@@ -159,11 +163,57 @@ namespace Resource
             }
         }
 
+        if (mCreateSimplifiedShapes && shape != nullptr && shape->mCollisionShape != nullptr && !shape->isAnimated())
+            shape->mSimplifiedCollisionShape = makeSimplifiedCollisionShape(*shape->mCollisionShape);
+
         mCache->addEntryToObjectCache(name.value(), shape);
 
         return shape;
     }
 
+    void BulletShapeManager::setShapeDb(std::unique_ptr<BulletShapeDb>&& db, bool write)
+    {
+        mShapeDb = std::move(db);
+        mWriteToShapeDb = write;
+    }
+
+    void BulletShapeManager::loadBvhs(BulletShape& shape)
+    {
+        const Sqlite3::ConstBlob hash{ shape.mFileHash.data(), static_cast<int>(shape.mFileHash.size()) };
+        std::optional<std::vector<std::byte>> data;
+        try
+        {
+            const std::lock_guard lock(mShapeDbMutex);
+            data = mShapeDb->getShapeData(shape.mFileName.value(), hash);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read BVHs of \"" << shape.mFileName << "\" from shape db: " << e.what();
+        }
+
+        if (data.has_value() && deserializeBvhs(shape, *data))
+            return;
+
+        buildMissingBvhs(shape);
+
+        if (!mWriteToShapeDb)
+            return;
+
+        const std::vector<std::byte> serialized = serializeBvhs(shape);
+        if (serialized.empty())
+            return;
+
+        try
+        {
+            const std::lock_guard lock(mShapeDbMutex);
+            mShapeDb->insertShape(shape.mFileName.value(), hash, serialized);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write BVHs of \"" << shape.mFileName << "\" to shape db: " << e.what();
+        }
+    }
+
     osg::ref_ptr<BulletShapeInstance> BulletShapeManager::cacheInstance(VFS::Path::NormalizedView name)
     {
         osg::ref_ptr<BulletShapeInstance> instance = createInstance(name);
@@ -3,6 +3,9 @@
 
 #include <osg/ref_ptr>
 
+#include <memory>
+#include <mutex>
+
 #include <components/vfs/pathutil.hpp>
 
 #include "bulletshape.hpp"
@@ -17,6 +20,7 @@ namespace Resource
     class BulletShapeInstance;
 
     class MultiObjectCache;
+    class BulletShapeDb;
 
     /// Handles loading, caching and "instancing" of bullet shapes.
     /// A shape 'instance' is a clone of another shape, with the goal of setting a different scale on this instance.
@@ -28,6 +32,15 @@ namespace Resource
             const VFS::Manager* vfs, SceneManager* sceneMgr, NifFileManager* nifFileManager, double expiryDelay);
         ~BulletShapeManager();
 
+        /// Generate BulletShape::mSimplifiedCollisionShape for shapes loaded afterwards.
+        /// @note Not thread safe, call before loading any shapes.
+        void setCreateSimplifiedShapes(bool value) { mCreateSimplifiedShapes = value; }
+
+        /// Load BVHs of triangle meshes from the database instead of building them, store the ones that had to be
+        /// built when writes are enabled.
+        /// @note Not thread safe, call before loading any shapes.
+        void setShapeDb(std::unique_ptr<BulletShapeDb>&& db, bool write);
+
         /// @note May return a null pointer if the object has no shape.
         osg::ref_ptr<const BulletShape> getShape(VFS::Path::NormalizedView name);
 
@@ -50,9 +63,15 @@ namespace Resource
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(VFS::Path::NormalizedView name);
 
+        void loadBvhs(BulletShape& shape);
+
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
+        bool mCreateSimplifiedShapes = false;
+        std::unique_ptr<BulletShapeDb> mShapeDb;
+        bool mWriteToShapeDb = false;
+        std::mutex mShapeDbMutex;
     };
 
 }
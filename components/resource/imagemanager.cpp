@@ -1,15 +1,32 @@
 #include "imagemanager.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
 #include <osgDB/Registry>
 
 #include <components/debug/debuglog.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
+#include "texturetranscoder.hpp"
+#include "transcodedimagecache.hpp"
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
 
 #ifdef OSG_LIBRARY_STATIC
 // This list of plugins should match with the list in the top-level CMakelists.txt.
@@ -55,19 +72,133 @@ namespace
         return false;
     }
 
+    bool isS3TCSupported()
+    {
+        // hashtag yolo (CS might not have context when loading assets)
+        if (!SceneUtil::glExtensionsReady())
+            return true;
+
+        return SceneUtil::getGLExtensions().isTextureCompressionS3TCSupported;
+    }
+
     bool checkSupported(osg::Image* image)
     {
         // not bothering with checks for other compression formats right now
         if (!isS3TC(image))
             return true;
 
-        // hashtag yolo (CS might not have context when loading assets)
-        if (!SceneUtil::glExtensionsReady())
-            return true;
+        return isS3TCSupported();
+    }
 
-        return SceneUtil::getGLExtensions().isTextureCompressionS3TCSupported;
+    std::optional<Resource::S3TCFormat> getS3TCFormat(GLenum pixelFormat)
+    {
+        switch (pixelFormat)
+        {
+            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+                return Resource::S3TCFormat::Dxt1Rgb;
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+                return Resource::S3TCFormat::Dxt1Rgba;
+            case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+                return Resource::S3TCFormat::Dxt3;
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+                return Resource::S3TCFormat::Dxt5;
+        }
+        return std::nullopt;
+    }
+
+    GLenum getPixelFormat(Resource::Etc2Format format)
+    {
+        return format == Resource::Etc2Format::Rgb8 ? GL_COMPRESSED_RGB8_ETC2 : GL_COMPRESSED_RGBA8_ETC2_EAC;
+    }
+
+    std::optional<Resource::TranscodedImage> transcodeS3TCImage(const osg::Image& image)
+    {
+        const std::optional<Resource::S3TCFormat> format = getS3TCFormat(image.getPixelFormat());
+        if (!format.has_value() || image.r() != 1 || !image.isDataContiguous())
+            return std::nullopt;
+
+        Resource::TranscodedImage result;
+        result.mPixelFormat = getPixelFormat(Resource::getEtc2Format(*format));
+        result.mWidth = static_cast<std::uint32_t>(image.s());
+        result.mHeight = static_cast<std::uint32_t>(image.t());
+        for (unsigned level = 0; level < image.getNumMipmapLevels(); ++level)
+        {
+            if (level > 0)
+                result.mMipmapOffsets.push_back(static_cast<std::uint32_t>(result.mData.size()));
+            const std::size_t width = static_cast<std::size_t>(std::max(image.s() >> level, 1));
+            const std::size_t height = static_cast<std::size_t>(std::max(image.t() >> level, 1));
+            Resource::transcodeS3TCToEtc2(*format, reinterpret_cast<const std::byte*>(image.getMipmapData(level)),
+                width, height, result.mData);
+        }
+        return result;
+    }
+
+    osg::ref_ptr<osg::Image> makeImage(const Resource::TranscodedImage& transcoded)
+    {
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        unsigned char* data = new unsigned char[transcoded.mData.size()];
+        std::memcpy(data, transcoded.mData.data(), transcoded.mData.size());
+        image->setImage(static_cast<int>(transcoded.mWidth), static_cast<int>(transcoded.mHeight), 1,
+            static_cast<GLint>(transcoded.mPixelFormat), static_cast<GLenum>(transcoded.mPixelFormat), GL_UNSIGNED_BYTE,
+            data, osg::Image::USE_NEW_DELETE);
+        image->setMipmapLevels(
+            osg::Image::MipmapDataType(transcoded.mMipmapOffsets.begin(), transcoded.mMipmapOffsets.end()));
+        return image;
+    }
+
+    osg::ref_ptr<osg::Image> decompressS3TCImage(const osg::Image& image)
+    {
+        const std::optional<Resource::S3TCFormat> format = getS3TCFormat(image.getPixelFormat());
+        if (!format.has_value() || image.r() != 1 || !image.isDataContiguous())
+            return nullptr;
+
+        std::vector<std::byte> pixels;
+        osg::Image::MipmapDataType mipmapOffsets;
+        for (unsigned level = 0; level < image.getNumMipmapLevels(); ++level)
+        {
+            if (level > 0)
+                mipmapOffsets.push_back(static_cast<unsigned>(pixels.size()));
+            const std::size_t width = static_cast<std::size_t>(std::max(image.s() >> level, 1));
+            const std::size_t height = static_cast<std::size_t>(std::max(image.t() >> level, 1));
+            Resource::decompressS3TC(
+                *format, reinterpret_cast<const std::byte*>(image.getMipmapData(level)), width, height, pixels);
+        }
+
+        osg::ref_ptr<osg::Image> result = new osg::Image;
+        unsigned char* data = new unsigned char[pixels.size()];
+        std::memcpy(data, pixels.data(), pixels.size());
+        result->setImage(
+            image.s(), image.t(), 1, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, data, osg::Image::USE_NEW_DELETE);
+        result->setMipmapLevels(mipmapOffsets);
+        return result;
     }
 
+    class TranscodeImage final : public SceneUtil::WorkItem
+    {
+    public:
+        TranscodeImage(const Resource::TranscodedImageCache& cache, VFS::Path::NormalizedView path,
+            std::int64_t lastModified, osg::ref_ptr<const osg::Image> image)
+            : mCache(cache)
+            , mPath(path)
+            , mLastModified(lastModified)
+            , mImage(std::move(image))
+        {
+        }
+
+        void doWork() override
+        {
+            if (const std::optional<Resource::TranscodedImage> transcoded = transcodeS3TCImage(*mImage))
+                mCache.put(mPath, mLastModified, *transcoded);
+        }
+
+    private:
+        // A copy, so the work doesn't depend on the lifetime of the image manager
+        const Resource::TranscodedImageCache mCache;
+        const VFS::Path::Normalized mPath;
+        const std::int64_t mLastModified;
+        const osg::ref_ptr<const osg::Image> mImage;
+    };
+
 }
 
 namespace Resource
@@ -82,6 +213,38 @@ namespace Resource
 
     ImageManager::~ImageManager() {}
 
+    void ImageManager::setTranscodedImageCache(
+        std::unique_ptr<TranscodedImageCache> cache, SceneUtil::WorkQueue* workQueue)
+    {
+        mTranscodedImageCache = std::move(cache);
+        mTranscodeWorkQueue = workQueue;
+    }
+
+    bool ImageManager::writeTranscodedImage(VFS::Path::NormalizedView path)
+    {
+        if (mTranscodedImageCache == nullptr)
+            return false;
+        const std::int64_t lastModified = mVFS->getLastModified(path).time_since_epoch().count();
+        if (mTranscodedImageCache->get(path, lastModified).has_value())
+            return false;
+
+        osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension("dds");
+        if (!reader)
+            return false;
+        osgDB::ReaderWriter::ReadResult result = reader->readImage(*mVFS->get(path), mOptions);
+        if (!result.success())
+        {
+            Log(Debug::Error) << "Error loading " << path << ": " << result.message() << " code " << result.status();
+            return false;
+        }
+
+        const std::optional<TranscodedImage> transcoded = transcodeS3TCImage(*result.getImage());
+        if (!transcoded.has_value())
+            return false;
+        mTranscodedImageCache->put(path, lastModified, *transcoded);
+        return true;
+    }
+
     osg::ref_ptr<osg::Image> ImageManager::getImage(VFS::Path::NormalizedView path, bool disableFlip)
     {
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(path);
@@ -89,6 +252,24 @@ namespace Resource
             return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
         else
         {
+            const std::string ext(Misc::getFileExtension(path.value()));
+
+            // Transcoded DDS files are loaded without reading and decoding the source
+            const bool transcode = mTranscodedImageCache != nullptr && !isS3TCSupported();
+            std::optional<std::int64_t> lastModified;
+            if (transcode && ext == "dds" && mVFS->exists(path))
+            {
+                lastModified = mVFS->getLastModified(path).time_since_epoch().count();
+                if (const std::optional<TranscodedImage> transcoded = mTranscodedImageCache->get(path, *lastModified))
+                {
+                    osg::ref_ptr<osg::Image> image = makeImage(*transcoded);
+                    image->setFileName(std::string(path.value()));
+                    image->setOrigin(osg::Image::TOP_LEFT);
+                    mCache->addEntryToObjectCache(path.value(), image);
+                    return image;
+                }
+            }
+
             Files::IStreamPtr stream;
             try
             {
@@ -101,7 +282,6 @@ namespace Resource
                 return mWarningImage;
             }
 
-            const std::string ext(Misc::getFileExtension(path.value()));
             osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
             if (!reader)
             {
@@ -148,7 +328,33 @@ namespace Resource
             if (!checkSupported(image))
             {
                 static bool uncompress = (getenv("OPENMW_DECOMPRESS_TEXTURES") != nullptr);
-                if (!uncompress)
+                osg::ref_ptr<osg::Image> newImage;
+                if (transcode && mTranscodeWorkQueue != nullptr && lastModified.has_value())
+                {
+                    // Transcoding takes much longer than decompressing, so the image is transcoded in the background
+                    // and is shown decompressed until it is loaded from the cache next time
+                    newImage = decompressS3TCImage(*image);
+                    if (newImage != nullptr)
+                        mTranscodeWorkQueue->addWorkItem(
+                            new TranscodeImage(*mTranscodedImageCache, path, *lastModified, image));
+                }
+                else if (transcode)
+                {
+                    if (const std::optional<TranscodedImage> transcoded = transcodeS3TCImage(*image))
+                    {
+                        if (lastModified.has_value())
+                            mTranscodedImageCache->put(path, *lastModified, *transcoded);
+                        newImage = makeImage(*transcoded);
+                    }
+                }
+
+                if (newImage != nullptr)
+                {
+                    newImage->setFileName(image->getFileName());
+                    newImage->setOrigin(image->getOrigin());
+                    image = newImage;
+                }
+                else if (!uncompress)
                 {
                     Log(Debug::Error) << "Error loading " << path << ": no S3TC texture compression support installed";
                     mCache->addEntryToObjectCache(path.value(), mWarningImage);
@@ -158,7 +364,7 @@ namespace Resource
                 {
                     // decompress texture in software if not supported by GPU
                     // requires update to getColor() to be released with OSG 3.6
-                    osg::ref_ptr<osg::Image> newImage = new osg::Image;
+                    newImage = new osg::Image;
                     newImage->setFileName(image->getFileName());
                     newImage->setOrigin(image->getOrigin());
                     // Always RGBA: an NPOT-width GL_RGB image hits GL_UNPACK_ALIGNMENT row padding on
@@ -5,6 +5,8 @@
 #include <osg/Texture2D>
 #include <osg/ref_ptr>
 
+#include <memory>
+
 #include <components/vfs/pathutil.hpp>
 
 #include "resourcemanager.hpp"
@@ -14,8 +16,14 @@ namespace osgDB
     class Options;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
+    class TranscodedImageCache;
 
     /// @brief Handles loading/caching of Images.
     /// @note May be used from any thread.
@@ -31,11 +39,26 @@ namespace Resource
 
         osg::Image* getWarningImage();
 
+        /// Transcode S3TC images into ETC2 when S3TC is not supported by the GPU instead of showing the warning
+        /// image, and keep the results in the cache to not transcode them again.
+        /// @param workQueue if set, images missing from the cache are transcoded on it and shown decompressed until
+        /// they are loaded again, instead of stalling the loading thread. Has to outlive any image loading.
+        /// @note Not thread safe, has to be called before any image is loaded.
+        void setTranscodedImageCache(
+            std::unique_ptr<TranscodedImageCache> cache, SceneUtil::WorkQueue* workQueue = nullptr);
+
+        /// Transcode a DDS file into the transcoded image cache if it is S3TC compressed and not there yet,
+        /// regardless of what the GPU supports. Used to fill the cache ahead of time.
+        /// @return true if the image was transcoded
+        bool writeTranscodedImage(VFS::Path::NormalizedView path);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
     private:
         osg::ref_ptr<osg::Image> mWarningImage;
         osg::ref_ptr<osgDB::Options> mOptions;
+        std::unique_ptr<TranscodedImageCache> mTranscodedImageCache;
+        SceneUtil::WorkQueue* mTranscodeWorkQueue = nullptr;
 
         ImageManager(const ImageManager&);
         void operator=(const ImageManager&);
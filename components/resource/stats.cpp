@@ -127,6 +127,28 @@ namespace Resource
                 "NavMesh Recast Water",
             };
 
+            constexpr std::string_view vr[] = {
+                "VR Resolution Scale",
+                "VR Resolution Width",
+                "VR Resolution Height",
+                "VR Frame Cost",
+                "VR Frame Budget",
+            };
+
+            constexpr std::string_view renderPass[] = {
+                "RenderPass Resolves",
+                "RenderPass Copies",
+                "RenderPass Invalidations",
+            };
+
+            constexpr std::string_view physics[] = {
+                "Physics Active Actors",
+                "Physics Sleeping Actors",
+                "Physics Rate",
+                "Physics Render Rate",
+                "Physics Simplified Objects",
+            };
+
             std::vector<std::string> statNames;
 
             for (std::string_view name : firstPage)
@@ -148,6 +170,22 @@ namespace Resource
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : vr)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : renderPass)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : physics)
+                statNames.emplace_back(name);
+
             return statNames;
         }
 
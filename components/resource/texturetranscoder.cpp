@@ -0,0 +1,432 @@
+#include "texturetranscoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Resource
+{
+    namespace
+    {
+        using Color = std::array<int, 4>;
+
+        // Pixel (x, y) is at y * 4 + x
+        using Block = std::array<Color, 16>;
+
+        using Subblock = std::array<int, 8>;
+
+        // Subblocks of ETC block when flip bit is not set (2x4 side by side) and when set (4x2 on top of each other)
+        constexpr std::array<std::array<Subblock, 2>, 2> etcSubblocks = { {
+            { { { 0, 1, 4, 5, 8, 9, 12, 13 }, { 2, 3, 6, 7, 10, 11, 14, 15 } } },
+            { { { 0, 1, 2, 3, 4, 5, 6, 7 }, { 8, 9, 10, 11, 12, 13, 14, 15 } } },
+        } };
+
+        constexpr int etcModifiers[8][2] = {
+            { 2, 8 },
+            { 5, 17 },
+            { 9, 29 },
+            { 13, 42 },
+            { 18, 60 },
+            { 24, 80 },
+            { 33, 106 },
+            { 47, 183 },
+        };
+
+        constexpr int eacModifiers[16][8] = {
+            { -3, -6, -9, -15, 2, 5, 8, 14 },
+            { -3, -7, -10, -13, 2, 6, 9, 12 },
+            { -2, -5, -8, -13, 1, 4, 7, 12 },
+            { -2, -4, -6, -13, 1, 3, 5, 12 },
+            { -3, -6, -8, -12, 2, 5, 7, 11 },
+            { -3, -7, -9, -11, 2, 6, 8, 10 },
+            { -4, -7, -8, -11, 3, 6, 7, 10 },
+            { -3, -5, -8, -11, 2, 4, 7, 10 },
+            { -2, -6, -8, -10, 1, 5, 7, 9 },
+            { -2, -5, -8, -10, 1, 4, 7, 9 },
+            { -2, -4, -8, -10, 1, 3, 7, 9 },
+            { -2, -5, -7, -10, 1, 4, 6, 9 },
+            { -3, -4, -7, -10, 2, 3, 6, 9 },
+            { -1, -2, -3, -10, 0, 1, 2, 9 },
+            { -4, -6, -8, -9, 3, 5, 7, 8 },
+            { -3, -5, -7, -9, 2, 4, 6, 8 },
+        };
+
+        int clampByte(int value)
+        {
+            return std::clamp(value, 0, 255);
+        }
+
+        int square(int value)
+        {
+            return value * value;
+        }
+
+        std::uint32_t readUInt(const std::byte* data, std::size_t size)
+        {
+            std::uint32_t result = 0;
+            for (std::size_t i = 0; i < size; ++i)
+                result |= std::to_integer<std::uint32_t>(data[i]) << (8 * i);
+            return result;
+        }
+
+        void writeBigEndian(std::uint64_t value, std::vector<std::byte>& destination)
+        {
+            for (int shift = 56; shift >= 0; shift -= 8)
+                destination.push_back(static_cast<std::byte>((value >> shift) & 0xff));
+        }
+
+        Color expand565(std::uint32_t value)
+        {
+            const int r = static_cast<int>((value >> 11) & 0x1f);
+            const int g = static_cast<int>((value >> 5) & 0x3f);
+            const int b = static_cast<int>(value & 0x1f);
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255 };
+        }
+
+        void decodeColors(const std::byte* data, bool alwaysFourColors, Block& block)
+        {
+            const std::uint32_t color0 = readUInt(data, 2);
+            const std::uint32_t color1 = readUInt(data + 2, 2);
+            std::array<Color, 4> palette{ expand565(color0), expand565(color1) };
+            if (alwaysFourColors || color0 > color1)
+            {
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+                palette[2][3] = 255;
+                palette[3][3] = 255;
+            }
+            else
+            {
+                for (std::size_t c = 0; c < 3; ++c)
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                palette[2][3] = 255;
+                palette[3] = { 0, 0, 0, 0 };
+            }
+            const std::uint32_t indices = readUInt(data + 4, 4);
+            for (std::size_t i = 0; i < block.size(); ++i)
+                block[i] = palette[(indices >> (2 * i)) & 3];
+        }
+
+        void decodeExplicitAlpha(const std::byte* data, Block& block)
+        {
+            for (std::size_t i = 0; i < block.size(); ++i)
+            {
+                const std::uint32_t value = std::to_integer<std::uint32_t>(data[i / 2]) >> (4 * (i % 2));
+                block[i][3] = static_cast<int>(value & 0xf) * 17;
+            }
+        }
+
+        void decodeInterpolatedAlpha(const std::byte* data, Block& block)
+        {
+            const int alpha0 = std::to_integer<int>(data[0]);
+            const int alpha1 = std::to_integer<int>(data[1]);
+            std::array<int, 8> palette{ alpha0, alpha1 };
+            if (alpha0 > alpha1)
+            {
+                for (int i = 2; i < 8; ++i)
+                    palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+            }
+            else
+            {
+                for (int i = 2; i < 6; ++i)
+                    palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+            const std::uint64_t indices
+                = readUInt(data + 2, 3) | (static_cast<std::uint64_t>(readUInt(data + 5, 3)) << 24);
+            for (std::size_t i = 0; i < block.size(); ++i)
+                block[i][3] = palette[(indices >> (3 * i)) & 7];
+        }
+
+        Block decodeS3TCBlock(S3TCFormat format, const std::byte* data)
+        {
+            Block block;
+            switch (format)
+            {
+                case S3TCFormat::Dxt1Rgb:
+                    decodeColors(data, false, block);
+                    for (Color& color : block)
+                        color[3] = 255;
+                    break;
+                case S3TCFormat::Dxt1Rgba:
+                    decodeColors(data, false, block);
+                    break;
+                case S3TCFormat::Dxt3:
+                    decodeColors(data + 8, true, block);
+                    decodeExplicitAlpha(data, block);
+                    break;
+                case S3TCFormat::Dxt5:
+                    decodeColors(data + 8, true, block);
+                    decodeInterpolatedAlpha(data, block);
+                    break;
+            }
+            return block;
+        }
+
+        struct SubblockFit
+        {
+            int mError = std::numeric_limits<int>::max();
+            int mTable = 0;
+            std::array<int, 8> mIndices{};
+        };
+
+        // Pixel index 0 and 1 select positive modifiers, 2 and 3 the negative ones
+        int getEtcModifier(int table, int index)
+        {
+            const int value = etcModifiers[table][index & 1];
+            return (index & 2) != 0 ? -value : value;
+        }
+
+        SubblockFit fitSubblock(const Block& block, const Subblock& subblock, const Color& base)
+        {
+            SubblockFit result;
+            for (int table = 0; table < 8; ++table)
+            {
+                SubblockFit fit;
+                fit.mError = 0;
+                fit.mTable = table;
+                for (std::size_t i = 0; i < subblock.size(); ++i)
+                {
+                    const Color& color = block[subblock[i]];
+                    int bestError = std::numeric_limits<int>::max();
+                    for (int index = 0; index < 4; ++index)
+                    {
+                        const int modifier = getEtcModifier(table, index);
+                        int error = 0;
+                        for (std::size_t c = 0; c < 3; ++c)
+                            error += square(clampByte(base[c] + modifier) - color[c]);
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            fit.mIndices[i] = index;
+                        }
+                    }
+                    fit.mError += bestError;
+                }
+                if (fit.mError < result.mError)
+                    result = fit;
+            }
+            return result;
+        }
+
+        std::array<float, 3> getAverageColor(const Block& block, const Subblock& subblock)
+        {
+            std::array<float, 3> result{};
+            for (int pixel : subblock)
+                for (std::size_t c = 0; c < 3; ++c)
+                    result[c] += static_cast<float>(block[pixel][c]);
+            for (float& v : result)
+                v /= static_cast<float>(subblock.size());
+            return result;
+        }
+
+        std::uint64_t encodeEtcBlock(const Block& block)
+        {
+            // Only individual and differential modes of ETC2 are used, they are enough to represent a colour of
+            // S3TC block well. T, H and planar modes would add little for a lot of encoding time.
+            std::uint64_t result = 0;
+            int bestError = std::numeric_limits<int>::max();
+            for (std::uint64_t flip = 0; flip < 2; ++flip)
+            {
+                const std::array<Subblock, 2>& subblocks = etcSubblocks[flip];
+                const std::array<std::array<float, 3>, 2> averages
+                    = { getAverageColor(block, subblocks[0]), getAverageColor(block, subblocks[1]) };
+
+                for (bool differential : { false, true })
+                {
+                    std::array<std::array<int, 3>, 2> quantized;
+                    std::array<Color, 2> bases;
+                    for (std::size_t s = 0; s < 2; ++s)
+                    {
+                        for (std::size_t c = 0; c < 3; ++c)
+                        {
+                            if (differential)
+                            {
+                                const int value = std::clamp(
+                                    static_cast<int>(std::lround(averages[s][c] * 31 / 255)), 0, 31);
+                                quantized[s][c] = value;
+                                bases[s][c] = (value << 3) | (value >> 2);
+                            }
+                            else
+                            {
+                                const int value
+                                    = std::clamp(static_cast<int>(std::lround(averages[s][c] / 17)), 0, 15);
+                                quantized[s][c] = value;
+                                bases[s][c] = value * 17;
+                            }
+                        }
+                    }
+
+                    if (differential)
+                    {
+                        const auto isInRange = [&](std::size_t c) {
+                            const int delta = quantized[1][c] - quantized[0][c];
+                            return delta >= -4 && delta <= 3;
+                        };
+                        if (!isInRange(0) || !isInRange(1) || !isInRange(2))
+                            continue;
+                    }
+
+                    const std::array<SubblockFit, 2> fits
+                        = { fitSubblock(block, subblocks[0], bases[0]), fitSubblock(block, subblocks[1], bases[1]) };
+                    const int error = fits[0].mError + fits[1].mError;
+                    if (error >= bestError)
+                        continue;
+                    bestError = error;
+
+                    std::uint64_t bits = 0;
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        const std::uint64_t first = static_cast<std::uint64_t>(quantized[0][c]);
+                        const int shift = 56 - static_cast<int>(c) * 8;
+                        if (differential)
+                        {
+                            const std::uint64_t delta
+                                = static_cast<std::uint64_t>(quantized[1][c] - quantized[0][c]) & 7;
+                            bits |= (first << (shift + 3)) | (delta << shift);
+                        }
+                        else
+                        {
+                            const std::uint64_t second = static_cast<std::uint64_t>(quantized[1][c]);
+                            bits |= (first << (shift + 4)) | (second << shift);
+                        }
+                    }
+                    bits |= static_cast<std::uint64_t>(fits[0].mTable) << 37;
+                    bits |= static_cast<std::uint64_t>(fits[1].mTable) << 34;
+                    bits |= static_cast<std::uint64_t>(differential) << 33;
+                    bits |= flip << 32;
+
+                    // Pixel indices are stored in columns, most significant bits of all pixels go first
+                    for (std::size_t s = 0; s < 2; ++s)
+                    {
+                        for (std::size_t i = 0; i < subblocks[s].size(); ++i)
+                        {
+                            const int pixel = subblocks[s][i];
+                            const int position = (pixel % 4) * 4 + pixel / 4;
+                            const std::uint64_t index = static_cast<std::uint64_t>(fits[s].mIndices[i]);
+                            bits |= ((index >> 1) << (16 + position)) | ((index & 1) << position);
+                        }
+                    }
+                    result = bits;
+                }
+            }
+            return result;
+        }
+
+        std::uint64_t encodeEacBlock(const Block& block)
+        {
+            int minAlpha = 255;
+            int maxAlpha = 0;
+            for (const Color& color : block)
+            {
+                minAlpha = std::min(minAlpha, color[3]);
+                maxAlpha = std::max(maxAlpha, color[3]);
+            }
+
+            std::uint64_t result = 0;
+            int bestError = std::numeric_limits<int>::max();
+            for (int table = 0; table < 16; ++table)
+            {
+                // Stretch the table over the range of alpha values in the block
+                const int low = eacModifiers[table][3];
+                const int high = eacModifiers[table][7];
+                const int multiplier = std::clamp((maxAlpha - minAlpha + high - low - 1) / (high - low), 1, 15);
+                const int base = clampByte((minAlpha + maxAlpha - (low + high) * multiplier + 1) / 2);
+
+                int error = 0;
+                std::uint64_t indices = 0;
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    const int alpha = block[i][3];
+                    int bestPixelError = std::numeric_limits<int>::max();
+                    int bestIndex = 0;
+                    for (int index = 0; index < 8; ++index)
+                    {
+                        const int pixelError
+                            = square(clampByte(base + eacModifiers[table][index] * multiplier) - alpha);
+                        if (pixelError < bestPixelError)
+                        {
+                            bestPixelError = pixelError;
+                            bestIndex = index;
+                        }
+                    }
+                    error += bestPixelError;
+                    const std::size_t position = (i % 4) * 4 + i / 4;
+                    indices |= static_cast<std::uint64_t>(bestIndex) << (45 - 3 * position);
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    result = (static_cast<std::uint64_t>(base) << 56) | (static_cast<std::uint64_t>(multiplier) << 52)
+                        | (static_cast<std::uint64_t>(table) << 48) | indices;
+                }
+            }
+            return result;
+        }
+    }
+
+    Etc2Format getEtc2Format(S3TCFormat format)
+    {
+        return format == S3TCFormat::Dxt1Rgb ? Etc2Format::Rgb8 : Etc2Format::Rgba8Eac;
+    }
+
+    std::size_t getBlockSize(S3TCFormat format)
+    {
+        return format == S3TCFormat::Dxt1Rgb || format == S3TCFormat::Dxt1Rgba ? 8 : 16;
+    }
+
+    std::size_t getBlockSize(Etc2Format format)
+    {
+        return format == Etc2Format::Rgb8 ? 8 : 16;
+    }
+
+    void transcodeS3TCToEtc2(S3TCFormat format, const std::byte* source, std::size_t width, std::size_t height,
+        std::vector<std::byte>& destination)
+    {
+        const std::size_t blocks = ((width + 3) / 4) * ((height + 3) / 4);
+        const std::size_t sourceBlockSize = getBlockSize(format);
+        const Etc2Format destinationFormat = getEtc2Format(format);
+        destination.reserve(destination.size() + blocks * getBlockSize(destinationFormat));
+        for (std::size_t i = 0; i < blocks; ++i)
+        {
+            const Block block = decodeS3TCBlock(format, source + i * sourceBlockSize);
+            if (destinationFormat == Etc2Format::Rgba8Eac)
+                writeBigEndian(encodeEacBlock(block), destination);
+            writeBigEndian(encodeEtcBlock(block), destination);
+        }
+    }
+
+    void decompressS3TC(S3TCFormat format, const std::byte* source, std::size_t width, std::size_t height,
+        std::vector<std::byte>& destination)
+    {
+        const std::size_t blocksPerRow = (width + 3) / 4;
+        const std::size_t blocksPerColumn = (height + 3) / 4;
+        const std::size_t sourceBlockSize = getBlockSize(format);
+        const std::size_t offset = destination.size();
+        destination.resize(offset + width * height * 4);
+        std::byte* const pixels = destination.data() + offset;
+        for (std::size_t blockY = 0; blockY < blocksPerColumn; ++blockY)
+        {
+            for (std::size_t blockX = 0; blockX < blocksPerRow; ++blockX)
+            {
+                const std::size_t blockIndex = blockY * blocksPerRow + blockX;
+                const Block block = decodeS3TCBlock(format, source + blockIndex * sourceBlockSize);
+                // Partial blocks at the edges have pixels outside of the level
+                for (std::size_t y = 0; y < 4 && blockY * 4 + y < height; ++y)
+                    for (std::size_t x = 0; x < 4 && blockX * 4 + x < width; ++x)
+                    {
+                        std::byte* pixel = pixels + ((blockY * 4 + y) * width + blockX * 4 + x) * 4;
+                        for (std::size_t c = 0; c < 4; ++c)
+                            pixel[c] = static_cast<std::byte>(block[y * 4 + x][c]);
+                    }
+            }
+        }
+    }
+}
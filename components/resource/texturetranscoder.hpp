@@ -0,0 +1,45 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEXTURETRANSCODER_H
+#define OPENMW_COMPONENTS_RESOURCE_TEXTURETRANSCODER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Resource
+{
+    enum class S3TCFormat
+    {
+        Dxt1Rgb,
+        Dxt1Rgba,
+        Dxt3,
+        Dxt5,
+    };
+
+    enum class Etc2Format
+    {
+        Rgb8,
+        Rgba8Eac,
+    };
+
+    /// @return ETC2 format keeping the channels of the S3TC one
+    Etc2Format getEtc2Format(S3TCFormat format);
+
+    std::size_t getBlockSize(S3TCFormat format);
+
+    std::size_t getBlockSize(Etc2Format format);
+
+    /// Convert a single mipmap level of S3TC compressed texture into ETC2 compressed one. Unlike S3TC, ETC2 is
+    /// supported by all OpenGL ES 3.0 GPUs, so the texture doesn't need to be stored uncompressed.
+    /// @param source blocks of the level in S3TC format
+    /// @param destination blocks of the level in ETC2 format are appended to it
+    void transcodeS3TCToEtc2(S3TCFormat format, const std::byte* source, std::size_t width, std::size_t height,
+        std::vector<std::byte>& destination);
+
+    /// Decompress a single mipmap level of S3TC compressed texture. Much faster than transcoding, for when the texture
+    /// is needed before it can be transcoded.
+    /// @param source blocks of the level in S3TC format
+    /// @param destination rows of the level in RGBA8 format are appended to it
+    void decompressS3TC(S3TCFormat format, const std::byte* source, std::size_t width, std::size_t height,
+        std::vector<std::byte>& destination);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "transcodedimagecache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr char fileMagic[] = { 'O', 'M', 'W', 'T', 'X', 'C', 'A', 'C' };
+        constexpr std::uint32_t fileVersion = 1;
+
+        struct CacheFile
+        {
+            std::int64_t mLastModified = 0;
+            TranscodedImage mImage;
+        };
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, TranscodedImage>>
+            {
+                visitor(*this, value.mPixelFormat);
+                visitor(*this, value.mWidth);
+                visitor(*this, value.mHeight);
+                visitor(*this, value.mMipmapOffsets);
+                visitor(*this, value.mData);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CacheFile>>
+            {
+                visitor(*this, value.mLastModified);
+                visitor(*this, value.mImage);
+            }
+        };
+    }
+
+    TranscodedImageCache::TranscodedImageCache(const std::filesystem::path& directory)
+        : mDirectory(directory)
+    {
+    }
+
+    std::optional<TranscodedImage> TranscodedImageCache::get(
+        VFS::Path::NormalizedView path, std::int64_t lastModified) const
+    {
+        const std::filesystem::path filePath = getFilePath(path);
+        try
+        {
+            std::ifstream stream(filePath, std::ios::binary);
+            if (!stream)
+                return std::nullopt;
+            const std::vector<char> data{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+            std::uint32_t version = 0;
+            if (data.size() < sizeof(fileMagic) + sizeof(version)
+                || std::memcmp(data.data(), fileMagic, sizeof(fileMagic)) != 0)
+                throw std::runtime_error("not a transcoded image");
+            std::memcpy(&version, data.data() + sizeof(fileMagic), sizeof(version));
+            if (version != fileVersion)
+                return std::nullopt;
+
+            constexpr Format<Serialization::Mode::Read> format;
+            CacheFile file;
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(data.data());
+            Serialization::BinaryReader reader(begin + sizeof(fileMagic) + sizeof(version), begin + data.size());
+            format(reader, file);
+            if (file.mLastModified != lastModified)
+                return std::nullopt;
+            return std::move(file.mImage);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read transcoded image " << filePath << ": " << e.what();
+            return std::nullopt;
+        }
+    }
+
+    void TranscodedImageCache::put(
+        VFS::Path::NormalizedView path, std::int64_t lastModified, const TranscodedImage& image) const
+    {
+        const std::filesystem::path filePath = getFilePath(path);
+        try
+        {
+            const CacheFile file{ .mLastModified = lastModified, .mImage = image };
+            constexpr Format<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, file);
+            std::vector<std::byte> buffer(sizeAccumulator.value());
+            format(Serialization::BinaryWriter(buffer.data(), buffer.data() + buffer.size()), file);
+
+            std::filesystem::create_directories(filePath.parent_path());
+
+            // Other threads may load the same image at the same time, each one writes into its own file and replaces
+            // the cached one at once, so no one reads a partially written file
+            std::filesystem::path temporary = filePath;
+            temporary += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            {
+                std::ofstream stream(temporary, std::ios::binary);
+                stream.write(fileMagic, sizeof(fileMagic));
+                stream.write(reinterpret_cast<const char*>(&fileVersion), sizeof(fileVersion));
+                stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                if (!stream.flush())
+                    throw std::runtime_error("failed to write \"" + Files::pathToUnicodeString(temporary) + "\"");
+            }
+            std::filesystem::rename(temporary, filePath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write transcoded image " << filePath << ": " << e.what();
+        }
+    }
+
+    std::filesystem::path TranscodedImageCache::getFilePath(VFS::Path::NormalizedView path) const
+    {
+        std::filesystem::path result = mDirectory / Files::pathFromUnicodeString(path.value());
+        result += ".etc2";
+        return result;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TRANSCODEDIMAGECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_TRANSCODEDIMAGECACHE_H
+
+#include <components/vfs/pathutil.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace Resource
+{
+    struct TranscodedImage
+    {
+        std::uint32_t mPixelFormat = 0;
+        std::uint32_t mWidth = 0;
+        std::uint32_t mHeight = 0;
+        // Offsets of mipmap levels starting from the second one
+        std::vector<std::uint32_t> mMipmapOffsets;
+        std::vector<std::byte> mData;
+    };
+
+    /// Stores images transcoded into a format supported by the GPU in a directory, a file per image located by its VFS
+    /// path. A stored image is used only while the source file has the same modification time.
+    /// @note May be used from any thread.
+    class TranscodedImageCache
+    {
+    public:
+        explicit TranscodedImageCache(const std::filesystem::path& directory);
+
+        std::optional<TranscodedImage> get(VFS::Path::NormalizedView path, std::int64_t lastModified) const;
+
+        void put(VFS::Path::NormalizedView path, std::int64_t lastModified, const TranscodedImage& image) const;
+
+    private:
+        std::filesystem::path mDirectory;
+
+        std::filesystem::path getFilePath(VFS::Path::NormalizedView path) const;
+    };
+}
+
+#endif
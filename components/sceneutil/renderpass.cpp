@@ -0,0 +1,98 @@
+#include "renderpass.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Stats>
+
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+
+#ifndef GL_DEPTH_ATTACHMENT
+#define GL_DEPTH_ATTACHMENT 0x8D00
+#endif
+
+#ifndef GL_STENCIL_ATTACHMENT
+#define GL_STENCIL_ATTACHMENT 0x8D20
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using InvalidateFramebufferFunc = void(GL_APIENTRY*)(GLenum, GLsizei, const GLenum*);
+
+        std::atomic<unsigned int> sMultisampleResolves{ 0 };
+        std::atomic<unsigned int> sFramebufferCopies{ 0 };
+        std::atomic<unsigned int> sInvalidations{ 0 };
+
+        InvalidateFramebufferFunc getInvalidateFramebuffer(unsigned int contextID)
+        {
+            // Only the draw thread calls this, and all contexts share a driver, so resolving once is enough
+            static InvalidateFramebufferFunc func = [contextID] {
+                InvalidateFramebufferFunc result = nullptr;
+#if defined(OSG_GLES3_AVAILABLE)
+                constexpr float version = 3.0f;
+#else
+                constexpr float version = 4.3f;
+#endif
+                if (osg::isGLExtensionOrVersionSupported(contextID, "GL_ARB_invalidate_subdata", version))
+                    osg::setGLExtensionFuncPtr(result, "glInvalidateFramebuffer");
+                else if (osg::isGLExtensionSupported(contextID, "GL_EXT_discard_framebuffer"))
+                    osg::setGLExtensionFuncPtr(result, "glDiscardFramebufferEXT");
+                return result;
+            }();
+            return func;
+        }
+    }
+
+    void invalidateFramebuffer(osg::State& state, GLenum target, std::initializer_list<GLenum> attachments)
+    {
+        auto func = getInvalidateFramebuffer(state.getContextID());
+        if (!func || attachments.size() == 0)
+            return;
+
+        func(target, static_cast<GLsizei>(attachments.size()), attachments.begin());
+        sInvalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void invalidateFramebuffer(osg::State& state, GLenum target, GLbitfield mask)
+    {
+        auto func = getInvalidateFramebuffer(state.getContextID());
+        if (!func)
+            return;
+
+        std::vector<GLenum> attachments;
+        if (mask & GL_COLOR_BUFFER_BIT)
+            attachments.push_back(GL_COLOR_ATTACHMENT0);
+        if (mask & GL_DEPTH_BUFFER_BIT)
+            attachments.push_back(GL_DEPTH_ATTACHMENT);
+        if (mask & (GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT))
+            attachments.push_back(GL_STENCIL_ATTACHMENT);
+        if (attachments.empty())
+            return;
+
+        func(target, static_cast<GLsizei>(attachments.size()), attachments.data());
+        sInvalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void countMultisampleResolve()
+    {
+        sMultisampleResolves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void countFramebufferCopy()
+    {
+        sFramebufferCopies.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void reportRenderPassStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        stats.setAttribute(frameNumber, "RenderPass Resolves", sMultisampleResolves.exchange(0));
+        stats.setAttribute(frameNumber, "RenderPass Copies", sFramebufferCopies.exchange(0));
+        stats.setAttribute(frameNumber, "RenderPass Invalidations", sInvalidations.exchange(0));
+    }
+}
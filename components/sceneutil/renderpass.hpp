@@ -0,0 +1,35 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_RENDERPASS_H
+#define OPENMW_COMPONENTS_SCENEUTIL_RENDERPASS_H
+
+#include <initializer_list>
+
+#include <osg/GL>
+
+namespace osg
+{
+    class State;
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    // Helpers for keeping framebuffer traffic down on tile based GPUs, where every attachment that is not known to be
+    // disposable is written back to memory when a render pass ends, and loaded back when it is bound again.
+
+    // Tells the driver the listed attachments of the framebuffer bound to target do not need to be preserved.
+    // Does nothing when glInvalidateFramebuffer is unavailable.
+    void invalidateFramebuffer(osg::State& state, GLenum target, std::initializer_list<GLenum> attachments);
+
+    // Same as invalidateFramebuffer, for the attachments covered by a glBlitFramebuffer/glClear style mask.
+    void invalidateFramebuffer(osg::State& state, GLenum target, GLbitfield mask);
+
+    // Count work that stores a framebuffer to memory, for the stats overlay
+    void countMultisampleResolve();
+    void countFramebufferCopy();
+
+    // Reports and resets the counters. The counters are written by the draw thread, so a report may include work
+    // of a neighbouring frame.
+    void reportRenderPassStats(unsigned int frameNumber, osg::Stats& stats);
+}
+
+#endif
@@ -195,6 +195,12 @@ namespace SceneUtil
 
             setDefaults(camera);
 
+            // The union frustum is expressed in the main camera's clip space, so it only applies to cameras that
+            // inherit its projection
+            if (mStereoAwareness == StereoAwareness::Aware && Stereo::getMultiview()
+                && camera->getReferenceFrame() == osg::Camera::RELATIVE_RF)
+                vdd->mUnionFrustumCallback = Stereo::Manager::instance().createUnionFrustumCallback(camera);
+
             if (camera->getBufferAttachmentMap().count(osg::Camera::COLOR_BUFFER))
                 vdd->mColorTexture = camera->getBufferAttachmentMap()[osg::Camera::COLOR_BUFFER]._texture;
             if (camera->getBufferAttachmentMap().count(osg::Camera::PACKED_DEPTH_STENCIL_BUFFER))
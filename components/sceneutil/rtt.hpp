@@ -17,6 +17,11 @@ namespace osgUtil
     class CullVisitor;
 }
 
+namespace Stereo
+{
+    struct InitialFrustumCallback;
+}
+
 namespace SceneUtil
 {
     /// @brief Implements per-view RTT operations.
@@ -32,6 +37,8 @@ namespace SceneUtil
     /// @par When using the RTT texture in your statesets, it is recommended to use SceneUtil::StateSetUpdater as a cull
     /// callback to handle this as the appropriate
     ///     textures can be retrieved during SceneUtil::StateSetUpdater::Apply()
+    /// @par With multiview, a view dependent RTT is rendered by a single camera for both views, which culls once
+    /// against the union of the eyes' frustums.
     /// @par For any of COLOR_BUFFER or PACKED_DEPTH_STENCIL_BUFFER not added during setDefaults(), RTTNode will attach
     /// a default buffer. The default color buffer has an internal format of GL_RGB.
     ///     The default depth buffer has internal format GL_DEPTH_COMPONENT24, source format GL_DEPTH_COMPONENT, and
@@ -95,6 +102,7 @@ namespace SceneUtil
             osg::ref_ptr<osg::Camera> mCamera;
             osg::ref_ptr<osg::Texture> mColorTexture;
             osg::ref_ptr<osg::Texture> mDepthTexture;
+            std::unique_ptr<Stereo::InitialFrustumCallback> mUnionFrustumCallback;
             unsigned int mFrameNumber = 0;
         };
 
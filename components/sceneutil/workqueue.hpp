@@ -66,6 +66,8 @@ namespace SceneUtil
 
         size_t getNumActiveThreads() const;
 
+        size_t getNumThreads() const { return mThreads.size(); }
+
     private:
         bool mIsReleased;
         std::deque<osg::ref_ptr<WorkItem>> mQueue;
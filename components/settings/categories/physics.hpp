@@ -21,6 +21,16 @@ namespace Settings
         SettingValue<int> mAsyncNumThreads{ mIndex, "Physics", "async num threads", makeMaxSanitizerInt(0) };
         SettingValue<int> mLineofsightKeepInactiveCache{ mIndex, "Physics", "lineofsight keep inactive cache",
             makeMaxSanitizerInt(-1) };
+        SettingValue<float> mPhysicsFramerate{ mIndex, "Physics", "physics framerate",
+            makeClampSanitizerFloat(10, 240) };
+        SettingValue<bool> mFixedRate{ mIndex, "Physics", "fixed rate" };
+        SettingValue<float> mCollisionLodDistance{ mIndex, "Physics", "collision lod distance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mCollisionLodSmallObjectSize{ mIndex, "Physics", "collision lod small object size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mEnableShapeDiskCache{ mIndex, "Physics", "enable shape disk cache" };
+        SettingValue<bool> mWriteToShapeDb{ mIndex, "Physics", "write to shape db" };
+        SettingValue<std::string> mReplayRecordingPath{ mIndex, "Physics", "replay recording path" };
     };
 }
 
@@ -23,6 +23,11 @@ namespace Settings
         SettingValue<bool> mAllowDisplayListsForMultiview{ mIndex, "Stereo", "allow display lists for multiview" };
         SettingValue<bool> mUseCustomView{ mIndex, "Stereo", "use custom view" };
         SettingValue<bool> mUseCustomEyeResolution{ mIndex, "Stereo", "use custom eye resolution" };
+        SettingValue<bool> mFoveatedRendering{ mIndex, "Stereo", "foveated rendering" };
+        SettingValue<float> mFoveationInnerRadius{ mIndex, "Stereo", "foveation inner radius",
+            makeClampSanitizerFloat(0, 2) };
+        SettingValue<float> mFoveationOuterRadius{ mIndex, "Stereo", "foveation outer radius",
+            makeClampSanitizerFloat(0, 2) };
     };
 }
 
@@ -39,6 +39,15 @@ namespace Settings
         SettingValue<bool> mLeftHandedMode{ mIndex, "VR", "left handed mode" };
         SettingValue<bool> mShow3DCrosshairs{ mIndex, "VR", "show 3D crosshairs" };
         SettingValue<bool> mUseXrLayerForHuds{ mIndex, "VR", "use xr layer for huds" };
+        SettingValue<bool> mLateLatchHeadPose{ mIndex, "VR", "late latch head pose" };
+        SettingValue<bool> mDynamicResolution{ mIndex, "VR", "dynamic resolution" };
+        SettingValue<float> mDynamicResolutionMinScale{ mIndex, "VR", "dynamic resolution min scale",
+            makeClampSanitizerFloat(0.1f, 1) };
+        SettingValue<float> mDynamicResolutionTarget{ mIndex, "VR", "dynamic resolution target",
+            makeClampSanitizerFloat(0.1f, 1) };
+        SettingValue<bool> mSpaceWarp{ mIndex, "VR", "space warp" };
+        SettingValue<bool> mRenderToSwapchain{ mIndex, "VR", "render to swapchain" };
+        SettingValue<bool> mCacheGuiLayers{ mIndex, "VR", "cache gui layers" };
     };
     struct VRDebugCategory : WithIndex
     {
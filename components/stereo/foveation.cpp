@@ -0,0 +1,70 @@
+#include "foveation.hpp"
+
+#include <osg/ColorMask>
+#include <osg/Uniform>
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+#include <components/sceneutil/depth.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/stereo/stereomanager.hpp>
+
+#include <algorithm>
+
+namespace Stereo
+{
+    namespace
+    {
+        struct ComputeNoBound : public osg::Drawable::ComputeBoundingBoxCallback
+        {
+            osg::BoundingBox computeBound(const osg::Drawable&) const override { return osg::BoundingBox(); }
+        };
+    }
+
+    float getFoveationDepth()
+    {
+        return SceneUtil::AutoDepth::isReversed() ? 1.f : 0.f;
+    }
+
+    FoveationMask::FoveationMask(Shader::ShaderManager& shaderManager)
+        : mRadii(new osg::Uniform("foveationRadii", osg::Vec2f(0.f, 0.f)))
+    {
+        setUseDisplayList(false);
+        setUseVertexBufferObjects(true);
+        setCullingActive(false);
+        setComputeBoundingBoxCallback(new ComputeNoBound);
+
+        // Normalized device depth of the near plane, reversed depth maps it to 0 to 1 through glClipControl
+        const float depth = SceneUtil::AutoDepth::isReversed() ? 1.f : -1.f;
+
+        osg::ref_ptr<osg::Vec3Array> verts = new osg::Vec3Array;
+        verts->push_back(osg::Vec3f(-1, -1, depth));
+        verts->push_back(osg::Vec3f(-1, 3, depth));
+        verts->push_back(osg::Vec3f(3, -1, depth));
+
+        setVertexArray(verts);
+
+        addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::TRIANGLES, 0, 3));
+
+        Shader::ShaderManager::DefineMap defines;
+        Stereo::shaderStereoDefines(defines);
+
+        osg::StateSet* stateset = getOrCreateStateSet();
+        stateset->setAttributeAndModes(shaderManager.getProgram("foveation_mask", defines), osg::StateAttribute::ON);
+        stateset->setAttributeAndModes(new SceneUtil::AutoDepth(osg::Depth::ALWAYS), osg::StateAttribute::ON);
+        stateset->setAttributeAndModes(new osg::ColorMask(false, false, false, false), osg::StateAttribute::ON);
+        stateset->addUniform(mRadii);
+    }
+
+    void FoveationMask::setRadii(float inner, float outer)
+    {
+        mRadii->set(osg::Vec2f(inner, std::max(inner, outer)));
+    }
+
+    void addFoveationReconstructUniforms(osg::StateSet* stateset)
+    {
+        stateset->addUniform(new osg::Uniform("foveationDepth", getFoveationDepth()));
+        stateset->addUniform(new osg::Uniform("foveationTexelSize", osg::Vec2f(0.f, 0.f)));
+        stateset->addUniform(new osg::Uniform("foveationResolution", osg::Vec2f(0.f, 0.f)));
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef STEREO_FOVEATION_H
+#define STEREO_FOVEATION_H
+
+#include <osg/Geometry>
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class StateSet;
+    class Uniform;
+}
+
+namespace Shader
+{
+    class ShaderManager;
+}
+
+namespace Stereo
+{
+    //! Value written to the depth buffer for pixels skipped by the foveation mask.
+    //! Lets later passes tell skipped pixels apart from shaded ones.
+    float getFoveationDepth();
+
+    //! Fullscreen geometry that masks out 2x2 pixel quads away from the center of each eye's view.
+    //! Must be drawn before any other scene geometry. Skipped quads are not shaded by the rest of the scene,
+    //! as their depth is set to the near plane, and need to be filled in from their neighbours before presenting.
+    class FoveationMask : public osg::Geometry
+    {
+    public:
+        FoveationMask(Shader::ShaderManager& shaderManager);
+
+        //! Radii in normalized device coordinates. Quads within the inner radius are always shaded,
+        //! quads between inner and outer radius at half density, and quads beyond outer radius at quarter density.
+        void setRadii(float inner, float outer);
+
+    private:
+        osg::ref_ptr<osg::Uniform> mRadii;
+    };
+
+    //! Adds the uniforms needed by shaders that reconstruct pixels skipped by the foveation mask.
+    void addFoveationReconstructUniforms(osg::StateSet* stateset);
+}
+
+#endif
@@ -133,6 +133,11 @@ namespace Stereo
         customClipSpace = mBoundingBox;
     }
 
+    std::unique_ptr<InitialFrustumCallback> StereoFrustumManager::createUnionFrustumCallback(osg::Camera* camera)
+    {
+        return std::make_unique<MultiviewFrustumCallback>(this, camera);
+    }
+
     void StereoFrustumManager::update(std::array<osg::Matrix, 2> projections)
     {
         mBoundingBox.init();
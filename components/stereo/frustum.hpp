@@ -34,6 +34,7 @@ namespace SceneUtil
 
 namespace Stereo
 {
+    struct InitialFrustumCallback;
     struct MultiviewFrustumCallback;
     struct ShadowFrustumCallback;
 
@@ -50,6 +51,11 @@ namespace Stereo
 
         const osg::BoundingBoxd& boundingBox() const { return mBoundingBox; }
 
+        //! Makes camera cull against the union of both eyes' frustums, in the clip space of the main camera.
+        //! The camera must share the main camera's projection, i.e. use a relative reference frame with no
+        //! projection of its own. The callback is removed from the camera when the returned object is destroyed.
+        std::unique_ptr<InitialFrustumCallback> createUnionFrustumCallback(osg::Camera* camera);
+
         void setShadowTechnique(SceneUtil::MWShadowTechnique* shadowTechnique);
 
         void customFrustumCallback(
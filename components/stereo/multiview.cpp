@@ -14,6 +14,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/renderpass.hpp>
 #include <components/settings/settings.hpp>
 #include <components/stereo/stereomanager.hpp>
 
@@ -290,6 +291,10 @@ namespace Stereo
                 mMsaaLayers[i]->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
                 ext->glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight,
                     GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                // The multisampled contents are never read again, so they need not be stored
+                SceneUtil::invalidateFramebuffer(
+                    state, GL_READ_FRAMEBUFFER_EXT, GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+                SceneUtil::countMultisampleResolve();
             }
             msaaFbo->apply(state, osg::FrameBufferObject::READ_DRAW_FRAMEBUFFER);
         }
@@ -503,6 +508,23 @@ namespace Stereo
         return osg::FrameBufferAttachment();
     }
 
+    osg::FrameBufferAttachment createMultiviewAttachmentFromHandle(
+        osg::State* state, uint32_t handle, uint32_t width, uint32_t height)
+    {
+#ifdef OSG_HAS_MULTIVIEW
+        auto texture2DArray = new osg::Texture2DArray();
+        texture2DArray->setTextureSize(width, height, 2);
+        texture2DArray->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        texture2DArray->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+
+        auto textureObject = new osg::Texture::TextureObject(texture2DArray, handle, GL_TEXTURE_2D_ARRAY);
+        texture2DArray->setTextureObject(state->getContextID(), textureObject);
+        return osg::FrameBufferAttachment(texture2DArray, osg::Camera::FACE_CONTROLLED_BY_MULTIVIEW_SHADER, 0);
+#else
+        return osg::FrameBufferAttachment();
+#endif
+    }
+
 //## VR_PATCH END
     unsigned int osgFaceControlledByMultiviewShader()
     {
@@ -548,6 +570,12 @@ namespace Stereo
                 }
             }
 
+//## VR_PATCH BEGIN
+            // Dynamic resolution renders to part of the framebuffer
+            const osg::Vec2i resolution = Stereo::Manager::instance().renderResolution();
+            mViewport->setViewport(0, 0, resolution.x(), resolution.y());
+//## VR_PATCH END
+
             // OSG tries to do a horizontal split, but we want to render to separate framebuffers instead.
             renderStage->setViewport(mViewport);
             cv->pushStateSet(mViewportStateset.get());
@@ -801,6 +829,7 @@ namespace Stereo
             mResolveLayers[view]->apply(state, osg::FrameBufferObject::BindTarget::DRAW_FRAMEBUFFER);
             mMsaaLayers[view]->apply(state, osg::FrameBufferObject::BindTarget::READ_FRAMEBUFFER);
             ext->glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight, mBlitMask, GL_NEAREST);
+            SceneUtil::countFramebufferCopy();
         }
     }
     void MultiviewFramebufferResolve::setupLayers()
@@ -812,21 +841,31 @@ namespace Stereo
         if (mBlitMask & GL_COLOR_BUFFER_BIT)
             components.push_back(osg::FrameBufferObject::BufferComponent::COLOR_BUFFER);
 
+        // Either side may hold its depth without stencil
+        auto getComponent = [](osg::FrameBufferObject* fbo, osg::FrameBufferObject::BufferComponent component) {
+            if (component == osg::FrameBufferObject::BufferComponent::PACKED_DEPTH_STENCIL_BUFFER
+                && !fbo->hasAttachment(component))
+                return osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER;
+            return component;
+        };
+
         mMsaaLayers = { new osg::FrameBufferObject, new osg::FrameBufferObject };
         mResolveLayers = { new osg::FrameBufferObject, new osg::FrameBufferObject };
         for (auto component : components)
         {
-            const auto& msaaAttachment = mMsaaFbo->getAttachment(component);
+            const auto msaaComponent = getComponent(mMsaaFbo, component);
+            const auto& msaaAttachment = mMsaaFbo->getAttachment(msaaComponent);
             mMsaaLayers[0]->setAttachment(
-                component, makeSingleLayerAttachmentFromMultilayerAttachment(msaaAttachment, 0));
+                msaaComponent, makeSingleLayerAttachmentFromMultilayerAttachment(msaaAttachment, 0));
             mMsaaLayers[1]->setAttachment(
-                component, makeSingleLayerAttachmentFromMultilayerAttachment(msaaAttachment, 1));
+                msaaComponent, makeSingleLayerAttachmentFromMultilayerAttachment(msaaAttachment, 1));
 
-            const auto& resolveAttachment = mResolveFbo->getAttachment(component);
+            const auto resolveComponent = getComponent(mResolveFbo, component);
+            const auto& resolveAttachment = mResolveFbo->getAttachment(resolveComponent);
             mResolveLayers[0]->setAttachment(
-                component, makeSingleLayerAttachmentFromMultilayerAttachment(resolveAttachment, 0));
+                resolveComponent, makeSingleLayerAttachmentFromMultilayerAttachment(resolveAttachment, 0));
             mResolveLayers[1]->setAttachment(
-                component, makeSingleLayerAttachmentFromMultilayerAttachment(resolveAttachment, 1));
+                resolveComponent, makeSingleLayerAttachmentFromMultilayerAttachment(resolveAttachment, 1));
 
             mWidth = msaaAttachment.getTexture()->getTextureWidth();
             mHeight = msaaAttachment.getTexture()->getTextureHeight();
@@ -113,6 +113,11 @@ namespace Stereo
     osg::FrameBufferAttachment createLayerAttachmentFromHandle(
         osg::State* state, uint32_t handle, uint32_t target, uint32_t width, uint32_t height, uint32_t layer);
 
+    //! Create a multiview framebuffer attachment covering both layers of the specified GL_TEXTURE_2D_ARRAY handle.
+    //! Returns an empty attachment if OSG has no multiview.
+    osg::FrameBufferAttachment createMultiviewAttachmentFromHandle(
+        osg::State* state, uint32_t handle, uint32_t width, uint32_t height);
+
 //## VR_PATCH END
     //! If OSG has multiview, returns the magic number used to tell OSG to create a multiview attachment. Otherwise
     //! returns 0.
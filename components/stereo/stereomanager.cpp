@@ -71,6 +71,7 @@ namespace Stereo
             auto* uProjectionMatrix = stateset->getUniform("projectionMatrix");
             if (uProjectionMatrix)
                 uProjectionMatrix->set(mManager->computeEyeProjection(0, SceneUtil::AutoDepth::isReversed()));
+            mManager->recordLateLatchStateset(stateset, Eye::Left, nv);
         }
 
         void applyRight(osg::StateSet* stateset, osgUtil::CullVisitor* nv) override
@@ -78,6 +79,7 @@ namespace Stereo
             auto* uProjectionMatrix = stateset->getUniform("projectionMatrix");
             if (uProjectionMatrix)
                 uProjectionMatrix->set(mManager->computeEyeProjection(1, SceneUtil::AutoDepth::isReversed()));
+            mManager->recordLateLatchStateset(stateset, Eye::Right, nv);
         }
 
     private:
@@ -99,9 +101,10 @@ namespace Stereo
             stateset->addUniform(new osg::Uniform(osg::Uniform::FLOAT_MAT4, "invProjectionMatrixMultiView", 2));
         }
 
-        virtual void apply(osg::StateSet* stateset, osg::NodeVisitor* /*nv*/)
+        virtual void apply(osg::StateSet* stateset, osg::NodeVisitor* nv)
         {
             mManager->updateMultiviewStateset(stateset);
+            mManager->recordLateLatchStateset(stateset, Eye::Center, nv);
         }
 
     private:
@@ -202,6 +205,13 @@ namespace Stereo
         node->getOrCreateStateSet()->setAttribute(mMainCamera->getViewport());
     }
 
+    std::unique_ptr<InitialFrustumCallback> Manager::createUnionFrustumCallback(osg::Camera* camera)
+    {
+        if (!getMultiview() || !mFrustumManager)
+            return nullptr;
+        return mFrustumManager->createUnionFrustumCallback(camera);
+    }
+
     void Manager::setShadowTechnique(SceneUtil::MWShadowTechnique* shadowTechnique)
     {
         if (mFrustumManager)
@@ -391,6 +401,18 @@ namespace Stereo
     }
 
 //## VR_PATCH BEGIN
+    void Manager::setRenderResolution(const osg::Vec2i& renderResolution)
+    {
+        mRenderResolution = renderResolution;
+    }
+
+    osg::Vec2i Manager::renderResolution()
+    {
+        if (mRenderResolution)
+            return *mRenderResolution;
+        return eyeResolution();
+    }
+
     void Manager::setShouldAttachMultiviewFramebufferToMainCamera(bool attach)
     {
         mShouldAttachMultiviewFramebufferToMainCamera = attach;
@@ -406,6 +428,62 @@ namespace Stereo
         }
     }
 
+    void Manager::recordLateLatchStateset(osg::StateSet* stateset, Eye eye, const osg::NodeVisitor* nv)
+    {
+        const auto* frameStamp = nv->getFrameStamp();
+        if (!frameStamp)
+            return;
+
+        auto& state = mLateLatchStates[frameStamp->getFrameNumber() % 2];
+        if (state.mFrameNumber != frameStamp->getFrameNumber())
+        {
+            state = LateLatchState{};
+            state.mFrameNumber = frameStamp->getFrameNumber();
+            for (int view : { 0, 1 })
+            {
+                state.mViewOffset[view] = computeEyeViewOffset(view);
+                state.mProjection[view] = computeEyeProjection(view, SceneUtil::AutoDepth::isReversed());
+            }
+        }
+
+        if (eye == Eye::Center)
+            state.mMultiviewStateset = stateset;
+        else
+            state.mEyeStatesets[static_cast<int>(eye)] = stateset;
+    }
+
+    void Manager::lateLatchViews(osg::RenderInfo& info, const std::array<View, 2>& views)
+    {
+        const auto* frameStamp = info.getState()->getFrameStamp();
+        if (!frameStamp)
+            return;
+
+        auto& state = mLateLatchStates[frameStamp->getFrameNumber() % 2];
+        if (state.mFrameNumber != frameStamp->getFrameNumber())
+            return;
+
+        std::array<osg::Matrix, 2> projectionMatrices;
+        for (int view : { 0, 1 })
+        {
+            View latched = views[view];
+            projectionMatrices[view] = latched.viewMatrix(true) * state.mProjection[view];
+        }
+
+        if (state.mMultiviewStateset)
+            Stereo::setMultiviewMatrices(state.mMultiviewStateset, projectionMatrices, true);
+
+        // Without multiview the original view offset is already baked into the modelview matrices, so it has to be
+        // cancelled out of the projection.
+        for (int view : { 0, 1 })
+        {
+            if (!state.mEyeStatesets[view])
+                continue;
+            auto* uProjectionMatrix = state.mEyeStatesets[view]->getUniform("projectionMatrix");
+            if (uProjectionMatrix)
+                uProjectionMatrix->set(osg::Matrix::inverse(state.mViewOffset[view]) * projectionMatrices[view]);
+        }
+    }
+
     bool getStereo()
     {
         return sStereoEnabled;
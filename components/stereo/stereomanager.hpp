@@ -9,6 +9,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 
 #include <components/shader/shadermanager.hpp>
 
@@ -44,7 +45,9 @@ namespace Stereo
 {
     class MultiviewFramebuffer;
     class StereoFrustumManager;
+    struct InitialFrustumCallback;
     class MultiviewStereoStatesetUpdateCallback;
+    class BruteForceStereoStatesetUpdateCallback;
 
     bool getStereo();
 
@@ -138,14 +141,32 @@ namespace Stereo
         /// Determine which view the cull visitor belongs to
         Eye getEye(const osgUtil::CullVisitor* cv) const;
 
+        //! Lets a nested camera that renders both views at once with multiview cull once against the union of the
+        //! eyes' frustums. Returns nullptr when multiview is not in use.
+        std::unique_ptr<InitialFrustumCallback> createUnionFrustumCallback(osg::Camera* camera);
+
 //## VR_PATCH BEGIN
         void setShouldAttachMultiviewFramebufferToMainCamera(bool attach);
 
         void setSamples(int samples);
 
+        //! Re-targets the frame currently being drawn to the given eye views, without re-culling it.
+        //! The views must be relative to the head pose that the frame was culled with.
+        //! Must be called from the draw thread after cull, and before any stereo geometry is drawn.
+        void lateLatchViews(osg::RenderInfo& info, const std::array<View, 2>& views);
+
+        //! Sets the region of each eye's framebuffers, starting at their origin, that the scene is rendered to.
+        //! Lets the rendered resolution change without reallocating any framebuffer. Must be called during update.
+        void setRenderResolution(const osg::Vec2i& renderResolution);
+
+        //! Get the rendered region of each eye, which is the full eye resolution unless set otherwise
+        osg::Vec2i renderResolution();
+
     private:
         friend class MultiviewStereoStatesetUpdateCallback;
+        friend class BruteForceStereoStatesetUpdateCallback;
         void updateMultiviewStateset(osg::StateSet* stateset);
+        void recordLateLatchStateset(osg::StateSet* stateset, Eye eye, const osg::NodeVisitor* nv);
         void updateMultiviewFramebuffer();
         void setupBruteForceTechnique();
         void setupOVRMultiView2Technique();
@@ -158,6 +179,19 @@ namespace Stereo
         std::shared_ptr<MultiviewFramebuffer> mMultiviewFramebuffer;
         bool mShouldAttachMultiviewFramebufferToMainCamera = false;
         bool mMultiviewFramebufferIsAttached = false;
+
+        //! Matrices and statesets a frame was culled with, so they can be patched during draw.
+        //! Double buffered by frame number, as the cull of one frame may overlap the draw of the previous.
+        struct LateLatchState
+        {
+            unsigned int mFrameNumber = 0;
+            std::array<osg::Matrixd, 2> mViewOffset;
+            std::array<osg::Matrixd, 2> mProjection;
+            osg::ref_ptr<osg::StateSet> mMultiviewStateset;
+            std::array<osg::ref_ptr<osg::StateSet>, 2> mEyeStatesets;
+        };
+        std::array<LateLatchState, 2> mLateLatchStates;
+        std::optional<osg::Vec2i> mRenderResolution;
 //## VR_PATCH END
         bool mEyeResolutionOverriden;
         osg::Vec2i mEyeResolutionOverride;
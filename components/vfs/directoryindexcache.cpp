@@ -0,0 +1,194 @@
+#include "directoryindexcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+namespace VFS
+{
+    namespace
+    {
+        constexpr char snapshotMagic[] = { 'O', 'M', 'W', 'V', 'F', 'S', 'I', 'X' };
+        constexpr std::uint32_t snapshotVersion = 1;
+
+        struct SnapshotEntry
+        {
+            std::string mPath;
+            DirectoryListing mListing;
+        };
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<std::uint64_t>(value.size()));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint64_t size = 0;
+                    visitor(*this, size);
+                    value.resize(static_cast<std::size_t>(size));
+                }
+                visitor(*this, value.data(), value.size());
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, DirectoryListing>>
+            {
+                visitor(*this, value.mLastModified);
+                visitor(*this, value.mFiles);
+                visitor(*this, value.mDirectories);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, SnapshotEntry>>
+            {
+                visitor(*this, value.mPath);
+                visitor(*this, value.mListing);
+            }
+        };
+
+        std::int64_t getLastModified(const std::filesystem::path& directory)
+        {
+            return static_cast<std::int64_t>(std::filesystem::last_write_time(directory).time_since_epoch().count());
+        }
+
+        DirectoryListing listDirectory(const std::filesystem::path& directory, std::int64_t lastModified)
+        {
+            DirectoryListing result;
+            result.mLastModified = lastModified;
+            std::error_code ec;
+            std::filesystem::directory_iterator it(directory, ec);
+            for (const std::filesystem::directory_iterator end; ec == std::error_code() && it != end; it.increment(ec))
+            {
+                std::string name = Files::pathToUnicodeString(it->path().filename());
+                if (it->is_directory())
+                    result.mDirectories.push_back(std::move(name));
+                else
+                    result.mFiles.push_back(std::move(name));
+            }
+            if (ec != std::error_code())
+                throw std::runtime_error(
+                    "Failed to iterate over \"" + Files::pathToUnicodeString(directory) + "\": " + ec.message());
+            return result;
+        }
+
+        std::vector<SnapshotEntry> readSnapshot(const std::filesystem::path& path)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream)
+                return {};
+            const std::vector<char> data{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+            std::uint32_t version = 0;
+            if (data.size() < sizeof(snapshotMagic) + sizeof(version)
+                || std::memcmp(data.data(), snapshotMagic, sizeof(snapshotMagic)) != 0)
+                throw std::runtime_error("not a VFS index snapshot");
+            std::memcpy(&version, data.data() + sizeof(snapshotMagic), sizeof(version));
+            if (version != snapshotVersion)
+                return {};
+
+            constexpr Format<Serialization::Mode::Read> format;
+            std::vector<SnapshotEntry> result;
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(data.data());
+            Serialization::BinaryReader reader(begin + sizeof(snapshotMagic) + sizeof(version), begin + data.size());
+            format(reader, result);
+            return result;
+        }
+
+        void writeSnapshot(const std::filesystem::path& path, const std::vector<SnapshotEntry>& entries)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, entries);
+            std::vector<std::byte> buffer(sizeAccumulator.value());
+            format(Serialization::BinaryWriter(buffer.data(), buffer.data() + buffer.size()), entries);
+
+            // Replace the snapshot at once, so a crash while writing doesn't leave a truncated one
+            std::filesystem::path temporary = path;
+            temporary += ".tmp";
+            {
+                std::ofstream stream(temporary, std::ios::binary);
+                stream.write(snapshotMagic, sizeof(snapshotMagic));
+                stream.write(reinterpret_cast<const char*>(&snapshotVersion), sizeof(snapshotVersion));
+                stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                if (!stream.flush())
+                    throw std::runtime_error("failed to write \"" + Files::pathToUnicodeString(temporary) + "\"");
+            }
+            std::filesystem::rename(temporary, path);
+        }
+    }
+
+    DirectoryIndexCache::DirectoryIndexCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        try
+        {
+            for (SnapshotEntry& entry : readSnapshot(mPath))
+                mEntries.emplace(std::move(entry.mPath), Entry{ .mListing = std::move(entry.mListing) });
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load VFS index snapshot " << mPath << ": " << e.what();
+            mEntries.clear();
+        }
+    }
+
+    const DirectoryListing& DirectoryIndexCache::list(const std::filesystem::path& directory)
+    {
+        const std::int64_t lastModified = getLastModified(directory);
+        const auto [it, inserted] = mEntries.try_emplace(Files::pathToUnicodeString(directory));
+        Entry& entry = it->second;
+        entry.mUsed = true;
+        if (inserted || entry.mListing.mLastModified != lastModified)
+        {
+            entry.mListing = listDirectory(directory, lastModified);
+            ++mListedCount;
+            mChanged = true;
+        }
+        return entry.mListing;
+    }
+
+    void DirectoryIndexCache::save()
+    {
+        const bool hasUnused
+            = std::any_of(mEntries.begin(), mEntries.end(), [](const auto& v) { return !v.second.mUsed; });
+        if (!mChanged && !hasUnused)
+            return;
+
+        std::vector<SnapshotEntry> entries;
+        entries.reserve(mEntries.size());
+        for (const auto& [path, entry] : mEntries)
+            if (entry.mUsed)
+                entries.push_back(SnapshotEntry{ .mPath = path, .mListing = entry.mListing });
+
+        try
+        {
+            writeSnapshot(mPath, entries);
+            mChanged = false;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save VFS index snapshot " << mPath << ": " << e.what();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef OPENMW_COMPONENTS_VFS_DIRECTORYINDEXCACHE_H
+#define OPENMW_COMPONENTS_VFS_DIRECTORYINDEXCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    struct DirectoryListing
+    {
+        std::int64_t mLastModified = 0;
+        std::vector<std::string> mFiles;
+        std::vector<std::string> mDirectories;
+    };
+
+    /// Snapshot of data directories contents stored in a single file. A directory is listed from the file system only
+    /// when its modification time differs from the stored one, so indexing unchanged directories takes a stat call per
+    /// directory instead of a walk over all their files.
+    /// @note Not thread safe.
+    class DirectoryIndexCache
+    {
+    public:
+        /// Load the snapshot from the file if it's valid, start from an empty one otherwise
+        explicit DirectoryIndexCache(const std::filesystem::path& path);
+
+        /// @return names of files and subdirectories of the directory, the reference is valid until the cache is
+        /// destroyed
+        const DirectoryListing& list(const std::filesystem::path& directory);
+
+        /// @return number of directories listed from the file system since loading
+        std::size_t getListedCount() const { return mListedCount; }
+
+        /// Write the snapshot to the file if anything has changed. Only directories requested since loading are kept.
+        void save();
+
+    private:
+        struct Entry
+        {
+            DirectoryListing mListing;
+            bool mUsed = false;
+        };
+
+        std::filesystem::path mPath;
+        std::map<std::string, Entry, std::less<>> mEntries;
+        std::size_t mListedCount = 0;
+        bool mChanged = false;
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "fileindex.hpp"
+
+#include <bit>
+#include <cassert>
+
+#include "pathutil.hpp"
+
+namespace VFS
+{
+    void FileIndex::build(const FileMap& files)
+    {
+        clear();
+
+        if (files.empty())
+            return;
+
+        // Keep load factor at or below 1/2 so chains stay short on failed lookups too
+        mSlots.resize(std::bit_ceil(files.size() * 2));
+        const std::size_t mask = mSlots.size() - 1;
+
+        for (const auto& [path, file] : files)
+        {
+            assert(path.view().data() != nullptr);
+            const std::size_t hash = Path::Hash{}(path.view());
+            std::size_t index = hash & mask;
+            while (mSlots[index].mPath.data() != nullptr)
+                index = (index + 1) & mask;
+            mSlots[index] = Slot{ .mHash = hash, .mPath = path.view(), .mFile = file };
+        }
+
+        mSize = files.size();
+    }
+
+    void FileIndex::clear()
+    {
+        mSlots.clear();
+        mSize = 0;
+    }
+
+    File* FileIndex::find(std::string_view normalizedPath) const
+    {
+        const Slot* const slot = findSlot(normalizedPath);
+        if (slot == nullptr)
+            return nullptr;
+        return slot->mFile;
+    }
+
+    const FileIndex::Slot* FileIndex::findSlot(std::string_view normalizedPath) const
+    {
+        if (mSlots.empty())
+            return nullptr;
+
+        const std::size_t mask = mSlots.size() - 1;
+        const std::size_t hash = Path::Hash{}(normalizedPath);
+        for (std::size_t index = hash & mask;; index = (index + 1) & mask)
+        {
+            const Slot& slot = mSlots[index];
+            if (slot.mPath.data() == nullptr)
+                return nullptr;
+            if (slot.mHash == hash && slot.mPath == normalizedPath)
+                return &slot;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef OPENMW_COMPONENTS_VFS_FILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_FILEINDEX_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "filemap.hpp"
+
+namespace VFS
+{
+    /// Open addressing hash table mapping normalized paths to files. Hashes of the paths are stored with them, so
+    /// probing compares paths only when hashes are equal.
+    /// @note Paths are referenced, not copied: the FileMap used to build the index must outlive it.
+    class FileIndex
+    {
+    public:
+        void build(const FileMap& files);
+
+        void clear();
+
+        std::size_t size() const { return mSize; }
+
+        bool contains(std::string_view normalizedPath) const { return findSlot(normalizedPath) != nullptr; }
+
+        /// @return nullptr if there is no such file
+        File* find(std::string_view normalizedPath) const;
+
+    private:
+        struct Slot
+        {
+            std::size_t mHash = 0;
+            // Null data for empty slots
+            std::string_view mPath;
+            File* mFile = nullptr;
+        };
+
+        std::vector<Slot> mSlots;
+        std::size_t mSize = 0;
+
+        const Slot* findSlot(std::string_view normalizedPath) const;
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 
+#include "directoryindexcache.hpp"
 #include "pathutil.hpp"
 
 #include <components/debug/debuglog.hpp>
@@ -11,9 +12,16 @@
 namespace VFS
 {
 
-    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path)
+    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path, DirectoryIndexCache* cache)
         : mPath(path)
     {
+        if (cache != nullptr)
+        {
+            std::string prefix;
+            addDirectory(*cache, mPath, prefix);
+            return;
+        }
+
         const auto str = mPath.u8string();
         std::size_t prefix = str.size();
 
@@ -31,14 +39,7 @@ namespace VFS
             {
                 const std::filesystem::path& filePath = entry.path();
                 const std::string proper = Files::pathToUnicodeString(filePath);
-                VFS::Path::Normalized searchable(std::string_view{ proper }.substr(prefix));
-                FileSystemArchiveFile file(filePath);
-
-                const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
-                if (!inserted.second)
-                    Log(Debug::Warning)
-                        << "Found duplicate file for '" << proper
-                        << "', please check your file system for two files with the same name in different cases.";
+                addFile(filePath, std::string_view{ proper }.substr(prefix));
             }
 
             // Exception thrown by the operator++ may not contain the context of the error like what exact path caused
@@ -54,6 +55,37 @@ namespace VFS
         }
     }
 
+    void FileSystemArchive::addFile(const std::filesystem::path& filePath, std::string_view relativePath)
+    {
+        const auto inserted = mIndex.emplace(VFS::Path::Normalized(relativePath), FileSystemArchiveFile(filePath));
+        if (!inserted.second)
+            Log(Debug::Warning)
+                << "Found duplicate file for '" << Files::pathToUnicodeString(filePath)
+                << "', please check your file system for two files with the same name in different cases.";
+    }
+
+    void FileSystemArchive::addDirectory(
+        DirectoryIndexCache& cache, const std::filesystem::path& directory, std::string& prefix)
+    {
+        const DirectoryListing& listing = cache.list(directory);
+        const std::size_t prefixSize = prefix.size();
+
+        for (const std::string& name : listing.mFiles)
+        {
+            prefix += name;
+            addFile(directory / Files::pathFromUnicodeString(name), prefix);
+            prefix.resize(prefixSize);
+        }
+
+        for (const std::string& name : listing.mDirectories)
+        {
+            prefix += name;
+            prefix += '/';
+            addDirectory(cache, directory / Files::pathFromUnicodeString(name), prefix);
+            prefix.resize(prefixSize);
+        }
+    }
+
     void FileSystemArchive::listResources(FileMap& out)
     {
         for (auto& [k, v] : mIndex)
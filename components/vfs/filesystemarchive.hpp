@@ -9,6 +9,7 @@
 
 namespace VFS
 {
+    class DirectoryIndexCache;
 
     class FileSystemArchiveFile : public File
     {
@@ -28,7 +29,8 @@ namespace VFS
     class FileSystemArchive : public Archive
     {
     public:
-        FileSystemArchive(const std::filesystem::path& path);
+        /// @param cache used to list directories instead of walking them when given
+        FileSystemArchive(const std::filesystem::path& path, DirectoryIndexCache* cache = nullptr);
 
         void listResources(FileMap& out) override;
 
@@ -39,6 +41,10 @@ namespace VFS
     private:
         std::map<VFS::Path::Normalized, FileSystemArchiveFile, std::less<>> mIndex;
         std::filesystem::path mPath;
+
+        void addFile(const std::filesystem::path& filePath, std::string_view relativePath);
+
+        void addDirectory(DirectoryIndexCache& cache, const std::filesystem::path& directory, std::string& prefix);
     };
 
 }
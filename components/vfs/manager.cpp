@@ -20,6 +20,7 @@ namespace VFS
 
     void Manager::reset()
     {
+        mLookupIndex.clear();
         mIndex.clear();
         mArchives.clear();
     }
@@ -31,10 +32,13 @@ namespace VFS
 
     void Manager::buildIndex()
     {
+        mLookupIndex.clear();
         mIndex.clear();
 
         for (const auto& archive : mArchives)
             archive->listResources(mIndex);
+
+        mLookupIndex.build(mIndex);
     }
 
     Files::IStreamPtr Manager::find(Path::NormalizedView name) const
@@ -63,12 +67,12 @@ namespace VFS
 
     bool Manager::exists(const Path::Normalized& name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mLookupIndex.contains(name.view());
     }
 
     bool Manager::exists(Path::NormalizedView name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mLookupIndex.contains(name.value());
     }
 
     std::string Manager::getArchive(const Path::Normalized& name) const
@@ -83,18 +87,18 @@ namespace VFS
 
     std::filesystem::file_time_type Manager::getLastModified(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        File* const file = mLookupIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getLastModified();
+        return file->getLastModified();
     }
 
     std::string Manager::getStem(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        File* const file = mLookupIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getStem();
+        return file->getStem();
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
@@ -129,9 +133,9 @@ namespace VFS
     Files::IStreamPtr Manager::findNormalized(std::string_view normalizedPath) const
     {
         assert(Path::isNormalized(normalizedPath));
-        const auto it = mIndex.find(normalizedPath);
-        if (it == mIndex.end())
+        File* const file = mLookupIndex.find(normalizedPath);
+        if (file == nullptr)
             return nullptr;
-        return it->second->open();
+        return file->open();
     }
 }
@@ -9,6 +9,7 @@
 #include <string_view>
 #include <vector>
 
+#include "fileindex.hpp"
 #include "filemap.hpp"
 #include "pathutil.hpp"
 
@@ -74,8 +75,12 @@ namespace VFS
     private:
         std::vector<std::unique_ptr<Archive>> mArchives;
 
+        // Sorted to iterate over directories
         FileMap mIndex;
 
+        // Refers to the paths of mIndex, used for lookups by name
+        FileIndex mLookupIndex;
+
         inline Files::IStreamPtr findNormalized(std::string_view normalizedPath) const;
 
         /// Retrieve a file by name (name is already normalized).
@@ -1,12 +1,14 @@
 #include "registerarchives.hpp"
 
 #include <filesystem>
+#include <optional>
 #include <set>
 #include <stdexcept>
 
 #include <components/debug/debuglog.hpp>
 
 #include <components/vfs/bsaarchive.hpp>
+#include <components/vfs/directoryindexcache.hpp>
 #include <components/vfs/filesystemarchive.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -14,7 +16,8 @@ namespace VFS
 {
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder)
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        const std::filesystem::path& indexSnapshotPath)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -35,6 +38,10 @@ namespace VFS
 
         if (useLooseFiles)
         {
+            std::optional<DirectoryIndexCache> indexCache;
+            if (!indexSnapshotPath.empty())
+                indexCache.emplace(indexSnapshotPath);
+
             std::set<std::filesystem::path> seen;
             for (const auto& dataDir : dataDirs)
             {
@@ -42,11 +49,19 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << dataDir;
                     // Last data dir has the highest priority
-                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                    vfs->addArchive(
+                        std::make_unique<FileSystemArchive>(dataDir, indexCache ? &*indexCache : nullptr));
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << dataDir;
             }
+
+            if (indexCache)
+            {
+                Log(Debug::Info) << indexCache->getListedCount()
+                                 << " data directories were changed since the last VFS index snapshot";
+                indexCache->save();
+            }
         }
 
         vfs->buildIndex();
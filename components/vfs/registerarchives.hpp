@@ -3,6 +3,10 @@
 
 #include <components/files/collections.hpp>
 
+#include <filesystem>
+#include <string>
+#include <vector>
+
 namespace ToUTF8
 {
     class StatelessUtf8Encoder;
@@ -13,8 +17,10 @@ namespace VFS
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param indexSnapshotPath file storing contents of data directories between runs, they are walked when empty
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder);
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        const std::filesystem::path& indexSnapshotPath = {});
 }
 
 #endif
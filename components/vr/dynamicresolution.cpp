@@ -0,0 +1,68 @@
+#include "dynamicresolution.hpp"
+
+#include <algorithm>
+
+#include <osg/Stats>
+
+namespace VR
+{
+    DynamicResolution::DynamicResolution(const Config& config)
+        : mConfig(config)
+        , mScale(config.mMaxScale)
+    {
+        mConfig.mMinScale = std::min(mConfig.mMinScale, mConfig.mMaxScale);
+    }
+
+    bool DynamicResolution::update(double frameCost, double displayPeriod)
+    {
+        mLastFrameCost = frameCost;
+        mLastDisplayPeriod = displayPeriod;
+
+        if (displayPeriod <= 0)
+            return false;
+
+        if (mCooldown > 0)
+        {
+            mCooldown--;
+            return false;
+        }
+
+        if (frameCost > displayPeriod * mConfig.mTargetBudget)
+        {
+            mFramesOverBudget++;
+            mFramesUnderHeadroom = 0;
+        }
+        else if (frameCost < displayPeriod * mConfig.mHeadroomBudget)
+        {
+            mFramesUnderHeadroom++;
+            mFramesOverBudget = 0;
+        }
+        else
+        {
+            mFramesOverBudget = 0;
+            mFramesUnderHeadroom = 0;
+        }
+
+        float scale = mScale;
+        if (mFramesOverBudget >= mConfig.mFramesToScaleDown)
+            scale = std::max(mConfig.mMinScale, mScale - mConfig.mStep);
+        else if (mFramesUnderHeadroom >= mConfig.mFramesToScaleUp)
+            scale = std::min(mConfig.mMaxScale, mScale + mConfig.mStep);
+
+        if (scale == mScale)
+            return false;
+
+        mScale = scale;
+        mFramesOverBudget = 0;
+        mFramesUnderHeadroom = 0;
+        mCooldown = mConfig.mCooldownFrames;
+        return true;
+    }
+
+    void DynamicResolution::reportStats(unsigned frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "VR Resolution Scale", mScale);
+        stats.setAttribute(frameNumber, "VR Frame Cost", mLastFrameCost * 1000.0);
+        stats.setAttribute(frameNumber, "VR Frame Budget", mLastDisplayPeriod * mConfig.mTargetBudget * 1000.0);
+    }
+}
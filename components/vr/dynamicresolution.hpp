@@ -0,0 +1,58 @@
+#ifndef VR_DYNAMICRESOLUTION_H
+#define VR_DYNAMICRESOLUTION_H
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace VR
+{
+    /// \brief Chooses an eye render resolution scale that keeps the frame cost within the display period.
+    ///
+    /// Frame costs are expected to be the slowest stage of a pipelined frame (cull, draw or GPU), so a single
+    /// stage exceeding the budget is enough to step the resolution down. Stepping back up requires a longer streak
+    /// of cheap frames, so the scale does not oscillate around the budget.
+    class DynamicResolution
+    {
+    public:
+        struct Config
+        {
+            float mMinScale = 0.5f;
+            float mMaxScale = 1.f;
+            //! Amount the scale changes by in each step.
+            float mStep = 0.05f;
+            //! Fraction of the display period the frame cost should stay under.
+            float mTargetBudget = 0.9f;
+            //! Fraction of the display period the frame cost must stay under before scaling up.
+            float mHeadroomBudget = 0.7f;
+            //! Consecutive frames over budget before scaling down.
+            unsigned mFramesToScaleDown = 5;
+            //! Consecutive frames under the headroom budget before scaling up.
+            unsigned mFramesToScaleUp = 45;
+            //! Frames to ignore after a change, so stale measurements taken at the old scale are not acted on.
+            unsigned mCooldownFrames = 10;
+        };
+
+        explicit DynamicResolution(const Config& config);
+
+        /// Feed the cost and the display period of a frame, both in seconds.
+        /// @return true if the scale changed.
+        bool update(double frameCost, double displayPeriod);
+
+        float getScale() const { return mScale; }
+
+        void reportStats(unsigned frameNumber, osg::Stats& stats) const;
+
+    private:
+        Config mConfig;
+        float mScale;
+        unsigned mFramesOverBudget = 0;
+        unsigned mFramesUnderHeadroom = 0;
+        unsigned mCooldown = 0;
+        double mLastFrameCost = 0;
+        double mLastDisplayPeriod = 0;
+    };
+}
+
+#endif
@@ -3,8 +3,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include <components/stereo/types.hpp>
+
 namespace VR
 {
     struct Layer;
@@ -22,6 +25,14 @@ namespace VR
         uint64_t predictedDisplayPeriod = 0;
         uint64_t frameNumber = 0;
 
+        //! Head pose, relative to the local reference space, that the frame was updated and culled with.
+        //! Only recorded when late latching is enabled.
+        std::optional<Stereo::Pose> headPose;
+
+        //! Size of the region of the eye framebuffers, starting at their origin, that the frame is rendered to.
+        int renderWidth = 0;
+        int renderHeight = 0;
+
         std::vector<std::shared_ptr<Layer>> layers;
     };
 }
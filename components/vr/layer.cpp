@@ -9,6 +9,9 @@ namespace VR
         , depthSwapchain()
         , subImage()
         , view()
+        , motionVectorSwapchain()
+        , motionVectorDepthSwapchain()
+        , motionVectorSubImage()
     {
     }
 
@@ -54,6 +54,12 @@ namespace VR
         std::shared_ptr<Swapchain> depthSwapchain;
         SubImage subImage;
         Stereo::View view;
+
+        //! Optional motion vector and matching depth swapchains, only set when space warp is active.
+        //! These are typically smaller than the color swapchain and described by their own subimage.
+        std::shared_ptr<Swapchain> motionVectorSwapchain;
+        std::shared_ptr<Swapchain> motionVectorDepthSwapchain;
+        SubImage motionVectorSubImage;
     };
 
     struct ProjectionLayer : public Layer
@@ -0,0 +1,256 @@
+#include "motionvectors.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include <osg/Camera>
+#include <osg/ComputeBoundsVisitor>
+#include <osg/Depth>
+#include <osg/RenderInfo>
+#include <osg/Texture>
+#include <osgUtil/CullVisitor>
+
+#include <components/misc/constants.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/nodecallback.hpp>
+#include <components/settings/values.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/stereo/stereomanager.hpp>
+#include <components/vr/vr.hpp>
+
+namespace VR
+{
+    namespace
+    {
+        MotionVectors* sInstance = nullptr;
+
+        // Records the view of every frame the scene is culled with
+        class CameraCullCallback
+            : public SceneUtil::NodeCallback<CameraCullCallback, osg::Camera*, osgUtil::CullVisitor*>
+        {
+        public:
+            explicit CameraCullCallback(MotionVectors& motionVectors)
+                : mMotionVectors(motionVectors)
+            {
+            }
+
+            void operator()(osg::Camera* camera, osgUtil::CullVisitor* cv)
+            {
+                auto& frameState = mMotionVectors.cullFrameState(cv->getFrameStamp()->getFrameNumber());
+                frameState.mViewMatrix = camera->getViewMatrix();
+                for (int view : { 0, 1 })
+                {
+                    frameState.mViewOffset[view] = Stereo::Manager::instance().computeEyeViewOffset(view);
+                    frameState.mProjection[view]
+                        = Stereo::Manager::instance().computeEyeProjection(view, SceneUtil::AutoDepth::isReversed());
+                }
+                traverse(camera, cv);
+            }
+
+        private:
+            MotionVectors& mMotionVectors;
+        };
+
+        // Records the movement of an object through the world since the previous frame
+        class TrackingCallback : public SceneUtil::NodeCallback<TrackingCallback, osg::Node*, osgUtil::CullVisitor*>
+        {
+        public:
+            explicit TrackingCallback(osg::Node::NodeMask boundsMask)
+                : mBoundsMask(boundsMask)
+            {
+            }
+
+            void operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+            {
+                traverse(node, cv);
+
+                // Shadow maps and reflections cull the object too, and brute force stereo culls it once per eye
+                const unsigned int frameNumber = cv->getFrameStamp()->getFrameNumber();
+                if (!sInstance || cv->getCurrentCamera()->getName() != Constants::SceneCamera
+                    || (mHasWorld && frameNumber == mFrameNumber))
+                    return;
+
+                const osg::Matrixd world = osg::computeLocalToWorld(cv->getNodePath());
+                // Whatever happened while the object was out of view did not happen within a single frame
+                const osg::Matrixd previousWorld = mHasWorld && frameNumber == mFrameNumber + 1 ? mWorld : world;
+                mHasWorld = true;
+                mFrameNumber = frameNumber;
+                mWorld = world;
+                if (previousWorld == world)
+                    return;
+
+                osg::ComputeBoundsVisitor computeBounds;
+                computeBounds.setTraversalMask(cv->getTraversalMask() & mBoundsMask);
+                node->traverse(computeBounds);
+                if (!computeBounds.getBoundingBox().valid())
+                    return;
+
+                sInstance->cullFrameState(frameNumber)
+                    .mObjects.push_back({ world, previousWorld, computeBounds.getBoundingBox() });
+            }
+
+        private:
+            osg::Node::NodeMask mBoundsMask;
+            bool mHasWorld = false;
+            unsigned int mFrameNumber = 0;
+            osg::Matrixd mWorld;
+        };
+    }
+
+    MotionVectors::MotionVectors(Shader::ShaderManager& shaderManager, osg::Camera* camera)
+        : mCamera(camera)
+        , mCullCallback(new CameraCullCallback(*this))
+        , mGeometry(new osg::Geometry)
+        , mStateSet(new osg::StateSet)
+        , mViewport(new osg::Viewport)
+        , mScaling(new osg::Uniform("scaling", osg::Vec2f(1, 1)))
+        , mReprojection(new osg::Uniform("reprojection", osg::Matrixf()))
+        , mObjectCount(new osg::Uniform("objectCount", 0))
+        , mObjectBoxes(new osg::Uniform(osg::Uniform::FLOAT_MAT4, "objectBoxes", sMaxObjects))
+        , mObjectReprojections(new osg::Uniform(osg::Uniform::FLOAT_MAT4, "objectReprojections", sMaxObjects))
+    {
+        assert(!sInstance);
+        sInstance = this;
+
+        mGeometry->setUseDisplayList(false);
+        mGeometry->setUseVertexBufferObjects(true);
+        osg::ref_ptr<osg::Vec3Array> verts = new osg::Vec3Array;
+        verts->push_back(osg::Vec3f(-1, -1, 0));
+        verts->push_back(osg::Vec3f(-1, 3, 0));
+        verts->push_back(osg::Vec3f(3, -1, 0));
+        mGeometry->setVertexArray(verts);
+        mGeometry->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::TRIANGLES, 0, 3));
+
+        Shader::ShaderManager::DefineMap defines;
+        defines["maxObjects"] = std::to_string(sMaxObjects);
+        mStateSet->setAttributeAndModes(shaderManager.getProgram("motionvectors", defines));
+        // The depth of every pixel is copied along with its motion vector
+        mStateSet->setAttributeAndModes(new osg::Depth(osg::Depth::ALWAYS, 0.0, 1.0, true));
+        mStateSet->setMode(GL_BLEND, osg::StateAttribute::OFF);
+        mStateSet->setMode(GL_CULL_FACE, osg::StateAttribute::OFF);
+        mStateSet->addUniform(new osg::Uniform("depthTex", 0));
+        mStateSet->addUniform(mScaling);
+        mStateSet->addUniform(mReprojection);
+        mStateSet->addUniform(mObjectCount);
+        mStateSet->addUniform(mObjectBoxes);
+        mStateSet->addUniform(mObjectReprojections);
+
+        mCamera->addCullCallback(mCullCallback);
+    }
+
+    MotionVectors::~MotionVectors()
+    {
+        mCamera->removeCullCallback(mCullCallback);
+        sInstance = nullptr;
+    }
+
+    void MotionVectors::track(osg::Node* node, osg::Node::NodeMask boundsMask)
+    {
+        if (!VR::getVR() || !Settings::vr().mSpaceWarp)
+            return;
+        node->addCullCallback(new TrackingCallback(boundsMask));
+    }
+
+    MotionVectors::FrameState& MotionVectors::cullFrameState(unsigned int frameNumber)
+    {
+        FrameState& frameState = mFrameStates[frameNumber % 2];
+        if (frameState.mFrameNumber != frameNumber)
+        {
+            frameState.mFrameNumber = frameNumber;
+            frameState.mObjects.clear();
+        }
+        return frameState;
+    }
+
+    void MotionVectors::lateLatchViews(unsigned int frameNumber, const std::array<Stereo::View, 2>& views)
+    {
+        FrameState& frameState = mFrameStates[frameNumber % 2];
+        if (frameState.mFrameNumber != frameNumber)
+            return;
+
+        for (int view : { 0, 1 })
+        {
+            Stereo::View latched = views[view];
+            frameState.mViewOffset[view] = latched.viewMatrix(true);
+        }
+    }
+
+    void MotionVectors::draw(osg::RenderInfo& info, int view, osg::Texture* depth, const osg::Vec2i& depthRegion,
+        const osg::Vec2i& region, const std::array<Stereo::View, 2>& trackingViews)
+    {
+        osg::State& state = *info.getState();
+
+        updateUniforms(state.getFrameStamp()->getFrameNumber(), view, trackingViews);
+        mScaling->set(osg::Vec2f(static_cast<float>(depthRegion.x()) / depth->getTextureWidth(),
+            static_cast<float>(depthRegion.y()) / depth->getTextureHeight()));
+
+        state.pushStateSet(mStateSet);
+        state.apply();
+        state.applyTextureAttribute(0, depth);
+        mViewport->setViewport(0, 0, region.x(), region.y());
+        mViewport->apply(state);
+        mGeometry->draw(info);
+        state.popStateSet();
+    }
+
+    void MotionVectors::updateUniforms(
+        unsigned int frameNumber, int view, const std::array<Stereo::View, 2>& trackingViews)
+    {
+        const FrameState& frameState = mFrameStates[frameNumber % 2];
+        if (frameState.mFrameNumber != frameNumber)
+        {
+            // Nothing was recorded for the frame, leave everything where it is
+            mReprojection->set(osg::Matrixf());
+            mObjectCount->set(0);
+            return;
+        }
+
+        if (!mHasWorldToTracking || mDrawFrameNumber != frameNumber)
+        {
+            // The tracking views are relative to the tracking space, the views the frame was culled with to the world
+            Stereo::View trackingView = trackingViews[0];
+            const osg::Matrixd worldToTracking = frameState.mViewMatrix * frameState.mViewOffset[0]
+                * osg::Matrixd::inverse(trackingView.viewMatrix(false));
+            mPreviousWorldToTracking = mHasWorldToTracking ? mWorldToTracking : worldToTracking;
+            mWorldToTracking = worldToTracking;
+            mHasWorldToTracking = true;
+            mDrawFrameNumber = frameNumber;
+        }
+
+        // Everything is reprojected from the normalized device coordinates of the current frame into the clip space
+        // of the current view placed where the tracking space was in the previous frame
+        const osg::Matrixd viewProjection
+            = frameState.mViewMatrix * frameState.mViewOffset[view] * frameState.mProjection[view];
+        const osg::Matrixd fromNdc = osg::Matrixd::inverse(viewProjection);
+        const osg::Matrixd toPrevious
+            = mPreviousWorldToTracking * osg::Matrixd::inverse(mWorldToTracking) * viewProjection;
+        mReprojection->set(osg::Matrixf(fromNdc * toPrevious));
+
+        // Pixels are matched with the closest objects first
+        const osg::Vec3d eye = osg::Matrixd::inverse(frameState.mViewMatrix).getTrans();
+        std::vector<const TrackedObject*> objects;
+        objects.reserve(frameState.mObjects.size());
+        for (const TrackedObject& object : frameState.mObjects)
+            objects.push_back(&object);
+        const auto distance = [&](const TrackedObject* object) {
+            return (osg::Vec3d(object->mBounds.center()) * object->mWorld - eye).length2();
+        };
+        const std::size_t count = std::min<std::size_t>(objects.size(), sMaxObjects);
+        std::partial_sort(objects.begin(), objects.begin() + count, objects.end(),
+            [&](const TrackedObject* lhs, const TrackedObject* rhs) { return distance(lhs) < distance(rhs); });
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const TrackedObject& object = *objects[i];
+            const osg::Vec3d halfSize = (object.mBounds._max - object.mBounds._min) * 0.5;
+            const osg::Matrixd toBox = osg::Matrixd::translate(-object.mBounds.center())
+                * osg::Matrixd::scale(1.0 / std::max(halfSize.x(), 1e-3), 1.0 / std::max(halfSize.y(), 1e-3),
+                    1.0 / std::max(halfSize.z(), 1e-3));
+            const osg::Matrixd toLocal = fromNdc * osg::Matrixd::inverse(object.mWorld);
+            mObjectBoxes->setElement(i, osg::Matrixf(toLocal * toBox));
+            mObjectReprojections->setElement(i, osg::Matrixf(toLocal * object.mPreviousWorld * toPrevious));
+        }
+        mObjectCount->set(static_cast<int>(count));
+    }
+}
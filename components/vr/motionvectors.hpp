@@ -0,0 +1,112 @@
+#ifndef VR_MOTIONVECTORS_H
+#define VR_MOTIONVECTORS_H
+
+#include <array>
+#include <vector>
+
+#include <osg/BoundingBox>
+#include <osg/Callback>
+#include <osg/Geometry>
+#include <osg/Matrixd>
+#include <osg/Node>
+#include <osg/StateSet>
+#include <osg/Uniform>
+#include <osg/Viewport>
+#include <osg/ref_ptr>
+
+#include <components/stereo/types.hpp>
+
+namespace osg
+{
+    class Camera;
+    class RenderInfo;
+    class Texture;
+}
+
+namespace Shader
+{
+    class ShaderManager;
+}
+
+namespace VR
+{
+    /// \brief Renders the motion vectors space warp extrapolates frames with.
+    ///
+    /// Every pixel holds its movement in normalized device coordinates since the previous frame. The runtime accounts
+    /// for head movement on its own, so the movement is measured relative to the tracking space: anything static moves
+    /// by the locomotion of the tracking space through the world, and objects registered with track() additionally
+    /// move by their own transform. Pixels are matched to objects by their bounding boxes, so the animation of an
+    /// object relative to its root is not part of the motion vectors.
+    class MotionVectors
+    {
+    public:
+        //! Number of moving objects closest to the viewer that are distinguished from static geometry.
+        static constexpr int sMaxObjects = 8;
+
+        MotionVectors(Shader::ShaderManager& shaderManager, osg::Camera* camera);
+        ~MotionVectors();
+
+        //! Makes the movement of the node part of the motion vectors, meant for the roots of objects that move through
+        //! the world such as actors and projectiles. Only children matching boundsMask count towards its bounds.
+        //! Has no effect while no motion vectors are rendered.
+        static void track(osg::Node* node, osg::Node::NodeMask boundsMask = ~0u);
+
+        //! Draws the motion vectors of the view into the currently bound framebuffer, along with the depth of each
+        //! pixel sampled from the depth buffer of the view.
+        //! \param depthRegion Size of the rendered region of the depth texture, starting at its origin.
+        //! \param region Size of the region of the framebuffer to draw to, starting at its origin.
+        //! \param trackingViews The views of the frame relative to the tracking space.
+        void draw(osg::RenderInfo& info, int view, osg::Texture* depth, const osg::Vec2i& depthRegion,
+            const osg::Vec2i& region, const std::array<Stereo::View, 2>& trackingViews);
+
+        //! Replaces the view offsets of the frame with late latched views, relative to the head pose it was culled
+        //! with. Must be called from the draw thread.
+        void lateLatchViews(unsigned int frameNumber, const std::array<Stereo::View, 2>& views);
+
+        struct TrackedObject
+        {
+            osg::Matrixd mWorld;
+            osg::Matrixd mPreviousWorld;
+            osg::BoundingBox mBounds;
+        };
+
+        //! Matrices and objects a frame was culled with.
+        //! Double buffered by frame number, as the cull of one frame may overlap the draw of the previous.
+        struct FrameState
+        {
+            unsigned int mFrameNumber = 0;
+            osg::Matrixd mViewMatrix;
+            std::array<osg::Matrixd, 2> mViewOffset;
+            std::array<osg::Matrixd, 2> mProjection;
+            std::vector<TrackedObject> mObjects;
+        };
+
+        //! State of the frame being culled. Must be called during cull.
+        FrameState& cullFrameState(unsigned int frameNumber);
+
+    private:
+        void updateUniforms(unsigned int frameNumber, int view, const std::array<Stereo::View, 2>& trackingViews);
+
+        osg::ref_ptr<osg::Camera> mCamera;
+        osg::ref_ptr<osg::Callback> mCullCallback;
+        osg::ref_ptr<osg::Geometry> mGeometry;
+        osg::ref_ptr<osg::StateSet> mStateSet;
+        osg::ref_ptr<osg::Viewport> mViewport;
+        osg::ref_ptr<osg::Uniform> mScaling;
+        osg::ref_ptr<osg::Uniform> mReprojection;
+        osg::ref_ptr<osg::Uniform> mObjectCount;
+        osg::ref_ptr<osg::Uniform> mObjectBoxes;
+        osg::ref_ptr<osg::Uniform> mObjectReprojections;
+
+        std::array<FrameState, 2> mFrameStates;
+
+        //! World to tracking space transforms of the frame being drawn and the one drawn before it.
+        //! Only accessed by the draw thread.
+        unsigned int mDrawFrameNumber = 0;
+        bool mHasWorldToTracking = false;
+        osg::Matrixd mWorldToTracking;
+        osg::Matrixd mPreviousWorldToTracking;
+    };
+}
+
+#endif
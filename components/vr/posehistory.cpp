@@ -0,0 +1,217 @@
+#include "posehistory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace VR
+{
+    namespace
+    {
+        constexpr double nanosecondsPerSecond = 1e9;
+
+        double toSeconds(DisplayTime time)
+        {
+            return static_cast<double>(time) / nanosecondsPerSecond;
+        }
+
+
+        //! Orientation after rotating for dt seconds at the given angular velocity
+        osg::Quat integrateRotation(const osg::Quat& orientation, const osg::Vec3f& angularVelocity, double dt)
+        {
+            const float speed = angularVelocity.length();
+            if (speed <= 0.f)
+                return orientation;
+            return orientation * osg::Quat(speed * dt, angularVelocity / speed);
+        }
+    }
+
+    PoseHistory::PoseHistory()
+        : PoseHistory(Config{})
+    {
+    }
+
+    PoseHistory::PoseHistory(const Config& config)
+        : mConfig(config)
+        , mSamples(std::max<std::size_t>(config.mCapacity, 2))
+    {
+    }
+
+    const TrackingPose& PoseHistory::sample(std::size_t index) const
+    {
+        // index 0 is the oldest sample
+        return mSamples[(mNext + mSamples.size() - mCount + index) % mSamples.size()];
+    }
+
+    void PoseHistory::push(const TrackingPose& pose)
+    {
+        if (!pose.status)
+            return;
+
+        if (mCount > 0)
+        {
+            const TrackingPose& newest = sample(mCount - 1);
+            if (pose.time < newest.time)
+                return;
+            if (pose.time == newest.time)
+            {
+                mSamples[(mNext + mSamples.size() - 1) % mSamples.size()] = pose;
+                estimate();
+                return;
+            }
+        }
+
+        mSamples[mNext] = pose;
+        mNext = (mNext + 1) % mSamples.size();
+        mCount = std::min(mCount + 1, mSamples.size());
+        estimate();
+    }
+
+    void PoseHistory::clear()
+    {
+        mNext = 0;
+        mCount = 0;
+        mLinearVelocity = osg::Vec3f();
+        mLinearAcceleration = osg::Vec3f();
+        mAngularVelocity = osg::Vec3f();
+    }
+
+    float PoseHistory::decay(DisplayTime time) const
+    {
+        if (mCount == 0)
+            return 0.f;
+        const DisplayTime newest = sample(mCount - 1).time;
+        if (time <= newest)
+            return 1.f;
+        if (mConfig.mMaxExtrapolation <= 0)
+            return 0.f;
+        return static_cast<float>(std::max(0.0, 1.0 - toSeconds(time - newest) / mConfig.mMaxExtrapolation));
+    }
+
+    TrackingPose PoseHistory::latest() const
+    {
+        if (mCount == 0)
+            return {};
+        return sample(mCount - 1);
+    }
+
+    TrackingPose PoseHistory::locate(DisplayTime time) const
+    {
+        if (mCount == 0)
+            return {};
+
+        const TrackingPose& oldest = sample(0);
+        if (time < oldest.time)
+        {
+            TrackingPose result = oldest;
+            result.status = TrackingStatus::Stale;
+            result.time = time;
+            return result;
+        }
+
+        const TrackingPose& newest = sample(mCount - 1);
+        if (time <= newest.time)
+        {
+            // Find the first sample at or after the requested time, its predecessor brackets the time from below
+            std::size_t after = 0;
+            while (sample(after).time < time)
+                after++;
+            const TrackingPose& to = sample(after);
+            if (to.time == time || after == 0)
+                return to;
+
+            const TrackingPose& from = sample(after - 1);
+            const float t = static_cast<float>(
+                static_cast<double>(time - from.time) / static_cast<double>(to.time - from.time));
+
+            TrackingPose result;
+            result.status = from.status == TrackingStatus::Good && to.status == TrackingStatus::Good
+                ? TrackingStatus::Good
+                : TrackingStatus::Stale;
+            result.time = time;
+            result.pose.position = from.pose.position + (to.pose.position - from.pose.position) * t;
+            result.pose.orientation.slerp(t, from.pose.orientation, to.pose.orientation);
+            return result;
+        }
+
+        // Extrapolated poses are a guess, only recorded samples are tracking
+        const double dt = std::min(toSeconds(time - newest.time), mConfig.mMaxExtrapolation);
+        TrackingPose result = newest;
+        result.time = time;
+        result.status = TrackingStatus::Stale;
+
+        const osg::Vec3f offset
+            = mLinearVelocity * static_cast<float>(dt) + mLinearAcceleration * static_cast<float>(0.5 * dt * dt);
+        result.pose.position += Stereo::Position::fromMeters(offset);
+        result.pose.orientation = integrateRotation(newest.pose.orientation, mAngularVelocity, dt);
+        return result;
+    }
+
+    void PoseHistory::estimate()
+    {
+        mLinearVelocity = osg::Vec3f();
+        mLinearAcceleration = osg::Vec3f();
+        mAngularVelocity = osg::Vec3f();
+
+        // Fit all samples within the estimation window instead of differencing two of them, which amplifies the
+        // jitter of single samples
+        const TrackingPose& newest = sample(mCount - 1);
+        const auto window = static_cast<DisplayTime>(mConfig.mEstimationWindow * nanosecondsPerSecond);
+        std::size_t first = mCount - 1;
+        while (first > 0 && newest.time - sample(first - 1).time <= window)
+            first--;
+
+        const std::size_t last = mCount - 1;
+        if (first == last)
+            return;
+
+        // Least squares over times relative to the newest sample: sums of t^k, and of the positions times t^k
+        std::array<double, 5> timeSums{};
+        std::array<osg::Vec3d, 3> positionSums{};
+        for (std::size_t i = first; i <= last; ++i)
+        {
+            const double t = -toSeconds(newest.time - sample(i).time);
+            const osg::Vec3d position = sample(i).pose.position.asMeters();
+            double power = 1;
+            for (std::size_t k = 0; k < timeSums.size(); ++k)
+            {
+                timeSums[k] += power;
+                if (k < positionSums.size())
+                    positionSums[k] += position * power;
+                power *= t;
+            }
+        }
+
+        // Straight line fit, its slope is the velocity
+        const double linearDeterminant = timeSums[0] * timeSums[2] - timeSums[1] * timeSums[1];
+        mLinearVelocity = (positionSums[1] * timeSums[0] - positionSums[0] * timeSums[1]) / linearDeterminant;
+
+        const TrackingPose& oldest = sample(first);
+        const osg::Quat delta = oldest.pose.orientation.inverse() * newest.pose.orientation;
+        double angle = 0;
+        osg::Vec3d axis;
+        delta.getRotate(angle, axis);
+        // Take the short way around
+        if (angle > osg::PI)
+        {
+            angle -= 2 * osg::PI;
+        }
+        mAngularVelocity = axis * (angle / toSeconds(newest.time - oldest.time));
+
+        // Acceleration is twice the quadratic coefficient of a parabola fit, which needs three samples
+        if (last - first < 2)
+            return;
+
+        // Cramer's rule on the normal equations, the quadratic coefficient replaces the third column
+        const auto& s = timeSums;
+        const double determinant = s[0] * (s[2] * s[4] - s[3] * s[3]) - s[1] * (s[1] * s[4] - s[2] * s[3])
+            + s[2] * (s[1] * s[3] - s[2] * s[2]);
+        if (determinant <= 0)
+            return;
+        const osg::Vec3d quadratic = (positionSums[0] * (s[1] * s[3] - s[2] * s[2])
+                                         - positionSums[1] * (s[0] * s[3] - s[1] * s[2])
+                                         + positionSums[2] * (s[0] * s[2] - s[1] * s[1]))
+            / determinant;
+        mLinearAcceleration = quadratic * 2.0;
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef VR_POSEHISTORY_H
+#define VR_POSEHISTORY_H
+
+#include <cstddef>
+#include <vector>
+
+#include <osg/Vec3f>
+
+#include <components/vr/vr.hpp>
+
+namespace VR
+{
+    /// \brief Ring buffer of recent poses of a single space, with velocity and acceleration estimates.
+    ///
+    /// Lets consumers running at different rates query the pose at their own timestamps without locating the space
+    /// again. Times are display times in nanoseconds, as provided by the runtime.
+    class PoseHistory
+    {
+    public:
+        struct Config
+        {
+            //! Number of samples kept.
+            std::size_t mCapacity = 16;
+            //! Only samples this much older than the newest sample are used to estimate derivatives, in seconds.
+            double mEstimationWindow = 0.05;
+            //! Furthest a pose is extrapolated past the newest sample, in seconds. Velocities fade out over the same
+            //! time once samples stop arriving.
+            double mMaxExtrapolation = 0.1;
+        };
+
+        PoseHistory();
+        explicit PoseHistory(const Config& config);
+
+        /// Record a pose. Poses without valid tracking, or older than the newest sample, are ignored. A pose with
+        /// the same time as the newest sample replaces it.
+        void push(const TrackingPose& pose);
+
+        void clear();
+
+        bool empty() const { return mCount == 0; }
+        std::size_t size() const { return mCount; }
+
+        /// Newest recorded pose, with status Unknown if the history is empty.
+        TrackingPose latest() const;
+
+        /// Pose at an arbitrary time. Interpolated between samples, and extrapolated using the estimated velocity
+        /// and acceleration past the newest sample. The status is Stale if the time lies before the oldest sample
+        /// or past the newest sample, as only the recorded samples are actual tracking. Past the extrapolation limit
+        /// the pose stops moving.
+        TrackingPose locate(DisplayTime time) const;
+
+        /// Linear velocity in meters per second, as of the newest sample. Least squares fit over the estimation
+        /// window, so it is steady under jitter but lags by about half the window.
+        const osg::Vec3f& linearVelocity() const { return mLinearVelocity; }
+
+        /// Linear velocity at the given time, fading out to zero over the extrapolation limit past the newest
+        /// sample so a space that stopped being tracked does not keep moving.
+        osg::Vec3f linearVelocity(DisplayTime time) const { return mLinearVelocity * decay(time); }
+
+        /// Linear acceleration in meters per second squared, as of the newest sample.
+        const osg::Vec3f& linearAcceleration() const { return mLinearAcceleration; }
+
+        /// Rotation axis scaled by the angular speed, in radians per second, as of the newest sample.
+        const osg::Vec3f& angularVelocity() const { return mAngularVelocity; }
+
+        /// Angular velocity at the given time, fading out like linearVelocity(DisplayTime).
+        osg::Vec3f angularVelocity(DisplayTime time) const { return mAngularVelocity * decay(time); }
+
+    private:
+        const TrackingPose& sample(std::size_t index) const;
+        float decay(DisplayTime time) const;
+        void estimate();
+
+        Config mConfig;
+        std::vector<TrackingPose> mSamples;
+        std::size_t mNext = 0;
+        std::size_t mCount = 0;
+        osg::Vec3f mLinearVelocity;
+        osg::Vec3f mLinearAcceleration;
+        osg::Vec3f mAngularVelocity;
+    };
+}
+
+#endif
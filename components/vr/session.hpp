@@ -22,6 +22,7 @@
 #include <components/vr/swapchain.hpp>
 #include <components/vr/vr.hpp>
 
+#include <osg/Vec2i>
 #include <osg/Vec3>
 
 #include <openxr/openxr.h>
@@ -77,6 +78,12 @@ namespace VR
 
         bool appShouldShareDepthInfo() const { return mAppShouldShareDepthBuffer; }
 
+        //! True if the runtime accepts per-view motion vectors (space warp) and the user enabled them.
+        bool appShouldSubmitMotionVectors() const { return mAppShouldSubmitMotionVectors; }
+
+        //! Size of the motion vector and motion vector depth swapchains recommended by the runtime.
+        const osg::Vec2i& motionVectorResolution() const { return mMotionVectorResolution; }
+
         virtual std::shared_ptr<VR::Swapchain> createSwapchain(uint32_t width, uint32_t height, uint32_t samples,
             uint32_t arraySize, Swapchain::Attachment attachment, const std::string& name)
             = 0;
@@ -89,6 +96,8 @@ namespace VR
 
         void setAppShouldShareDepthBuffer(bool arg) { mAppShouldShareDepthBuffer = arg; }
 
+        void setAppShouldSubmitMotionVectors(bool arg) { mAppShouldSubmitMotionVectors = arg; }
+
         void requestRecenter() { mRecenter = true; }
 
         void instantTransition();
@@ -141,6 +150,8 @@ namespace VR
 
     protected:
         bool mAppShouldShareDepthBuffer = false;
+        bool mAppShouldSubmitMotionVectors = false;
+        osg::Vec2i mMotionVectorResolution;
         bool mRecenter = true;
 
         float mPlayerScale = 1.f;
@@ -55,7 +55,9 @@ namespace VR
         enum class Attachment
         {
             Color,
-            DepthStencil
+            DepthStencil,
+            //! Per pixel motion vectors, as consumed by space warp style reprojection
+            MotionVector
         };
 
         Swapchain(uint32_t width, uint32_t height, uint32_t samples, uint32_t arraySize, Attachment attachment,
@@ -1,7 +1,9 @@
 #include "viewer.hpp"
 
 #include <osg/BufferObject>
+#include <osg/Stats>
 #include <osg/StateAttribute>
+#include <osg/Texture2D>
 #include <osg/Texture2DArray>
 #include <osg/VertexArrayState>
 #include <osgViewer/Renderer>
@@ -17,6 +19,7 @@
 #include <components/stereo/stereomanager.hpp>
 
 #include <components/vr/layer.hpp>
+#include <components/vr/motionvectors.hpp>
 #include <components/vr/session.hpp>
 #include <components/vr/swapchain.hpp>
 #include <components/vr/trackingmanager.hpp>
@@ -24,9 +27,12 @@
 
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/renderpass.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
+#include <components/settings/values.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -61,6 +67,16 @@ namespace VR
         }
     };
 
+    constexpr unsigned kDrawFramebuffer = 0x8CA9; // GL_DRAW_FRAMEBUFFER
+    constexpr unsigned kColorAttachment0 = 0x8CE0; // GL_COLOR_ATTACHMENT0
+    constexpr unsigned kDepthAttachment = 0x8D00; // GL_DEPTH_ATTACHMENT
+    constexpr unsigned kDepthStencilAttachment = 0x821A; // GL_DEPTH_STENCIL_ATTACHMENT
+    constexpr unsigned kTexture2D = 0x0DE1; // GL_TEXTURE_2D
+    constexpr unsigned kColorBufferBit = 0x4000; // GL_COLOR_BUFFER_BIT
+    constexpr unsigned kDepthBufferBit = 0x0100; // GL_DEPTH_BUFFER_BIT
+    constexpr unsigned kNearest = 0x2600; // GL_NEAREST
+    constexpr unsigned kFramebufferSrgbExt = 0x8DB9; // GL_FRAMEBUFFER_SRGB_EXT (EXT_sRGB_write_control)
+
     static const NativeGLES& nativeGLES()
     {
         static NativeGLES n = [] {
@@ -119,6 +135,15 @@ namespace VR
         return recommended;
     }
 
+    //! Returns the pose that undoes the given pose, such that inverse(pose) + pose is the identity.
+    static Stereo::Pose inversePose(const Stereo::Pose& pose)
+    {
+        Stereo::Pose inverse;
+        inverse.orientation = pose.orientation.inverse();
+        inverse.position = -(inverse.orientation * pose.position);
+        return inverse;
+    }
+
     struct UpdateViewCallback : public Stereo::Manager::UpdateViewCallback
     {
         UpdateViewCallback(Viewer* viewer)
@@ -242,6 +267,20 @@ namespace VR
             osg::FrameBufferAttachment(new osg::RenderBuffer(
                 mFramebufferWidth, mFramebufferHeight, SceneUtil::Color::colorInternalFormat(), 0)));
 
+        mLateLatchHeadPose = Settings::vr().mLateLatchHeadPose;
+        mRenderResolution = osg::Vec2i(mFramebufferWidth, mFramebufferHeight);
+
+        // Dynamic resolution is the only reason to query GPU timings every frame, so it stays off entirely unless
+        // it can actually lower the resolution
+        if (Settings::vr().mDynamicResolution && Settings::vr().mDynamicResolutionMinScale < 1.f)
+        {
+            DynamicResolution::Config config;
+            config.mMinScale = Settings::vr().mDynamicResolutionMinScale;
+            config.mTargetBudget = Settings::vr().mDynamicResolutionTarget;
+            config.mHeadroomBudget = config.mTargetBudget * 0.8f;
+            mDynamicResolution = std::make_unique<DynamicResolution>(config);
+        }
+
         mViewer->setReleaseContextAtEndOfFrameHint(false);
         mViewer->getCamera()->getGraphicsContext()->setSwapCallback(mSwapBuffersCallback);
         mViewer->getCamera()->setViewport(0, 0, mFramebufferWidth, mFramebufferHeight);
@@ -249,11 +288,13 @@ namespace VR
 
         setupMirrorTexture();
         setupSwapchains();
+        setupRenderToSwapchain();
 
         mProjectionLayer = std::make_shared<VR::ProjectionLayer>();
         for (uint32_t i = 0; i < 2; i++)
         {
-            mProjectionLayer->views[i].subImage.index = 0;
+            // With multiview both eyes share one array swapchain, each in its own layer
+            mProjectionLayer->views[i].subImage.index = mColorSwapchain[i]->arraySize() > 1 ? i : 0;
             mProjectionLayer->views[i].subImage.width = mFramebufferWidth;
             mProjectionLayer->views[i].subImage.height = mFramebufferHeight;
             mProjectionLayer->views[i].subImage.x = 0;
@@ -261,7 +302,17 @@ namespace VR
             mProjectionLayer->views[i].colorSwapchain = mColorSwapchain[i];
             if (mSession->appShouldShareDepthInfo())
                 mProjectionLayer->views[i].depthSwapchain = mDepthSwapchain[i];
+            if (mSession->appShouldSubmitMotionVectors())
+            {
+                mProjectionLayer->views[i].motionVectorSwapchain = mMotionVectorSwapchain[i];
+                mProjectionLayer->views[i].motionVectorDepthSwapchain = mMotionVectorDepthSwapchain[i];
+                mProjectionLayer->views[i].motionVectorSubImage.width = mMotionVectorSwapchain[i]->width();
+                mProjectionLayer->views[i].motionVectorSubImage.height = mMotionVectorSwapchain[i]->height();
+            }
         }
+
+        if (mSession->appShouldSubmitMotionVectors())
+            setupMotionVectorFramebuffer();
     }
 
     Viewer::~Viewer(void)
@@ -269,6 +320,13 @@ namespace VR
         sViewer = nullptr;
     }
 
+    void Viewer::setupMotionVectors(Shader::ShaderManager& shaderManager)
+    {
+        if (!mSession->appShouldSubmitMotionVectors() || mMotionVectors)
+            return;
+        mMotionVectors = std::make_unique<MotionVectors>(shaderManager, mViewer->getCamera());
+    }
+
     static Viewer::MirrorTextureEye mirrorTextureEyeFromString(const std::string& str)
     {
         if (Misc::StringUtils::ciEqual(str, "left"))
@@ -325,6 +383,10 @@ namespace VR
             {
                 mirrorTextureChanged = true;
             }
+            if (it->first == "VR" && it->second == "late latch head pose")
+            {
+                mLateLatchHeadPose = Settings::vr().mLateLatchHeadPose;
+            }
         }
 
         if (mirrorTextureChanged)
@@ -350,8 +412,23 @@ namespace VR
         Log(Debug::Warning) << "VR::Viewer::removeLayer() called, but no such layer existed";
     }
 
-    osg::ref_ptr<osg::FrameBufferObject> Viewer::getFboForView(Stereo::Eye view)
+    osg::ref_ptr<osg::FrameBufferObject> Viewer::getFboForView(osg::State& state, Stereo::Eye view)
     {
+        if (mRenderToSwapchain)
+        {
+            // Acquire early so the final pass can write straight into the swapchain image, blit() releases it
+            int i = view == Stereo::Eye::Right ? 1 : 0;
+            mColorSwapchain[i]->beginFrame(state.getGraphicsContext());
+            if (mSession->appShouldShareDepthInfo())
+                mDepthSwapchain[i]->beginFrame(state.getGraphicsContext());
+            // The final pass binds the eye framebuffer as usual, see bindFboForView()
+            if (mRenderToSwapchainNatively)
+                return Stereo::Manager::instance().multiviewFramebuffer()->layerFbo(i);
+            if (view == Stereo::Eye::Center)
+                return getXrMultiviewFramebuffer(&state);
+            return getXrFramebuffer(i, &state);
+        }
+
         osg::ref_ptr<osg::FrameBufferObject> fbo = nullptr;
         auto stereoFbo = Stereo::Manager::instance().multiviewFramebuffer();
         if (Stereo::getMultiview())
@@ -367,6 +444,26 @@ namespace VR
         return fbo;
     }
 
+    void Viewer::bindFboForView(osg::State& state, Stereo::Eye view)
+    {
+#ifdef __ANDROID__
+        if (!mRenderToSwapchainNatively)
+            return;
+
+        // gl4es bound the eye framebuffer for real, only the draw binding is replaced by the swapchain image,
+        // see blitXrFramebuffer()
+        const auto& ngl = nativeGLES();
+        int i = view == Stereo::Eye::Right ? 1 : 0;
+        static unsigned sDrawFbo = 0;
+        if (!sDrawFbo)
+            ngl.genFramebuffers(1, &sDrawFbo);
+        ngl.bindFramebuffer(kDrawFramebuffer, sDrawFbo);
+        ngl.framebufferTexture2D(
+            kDrawFramebuffer, kColorAttachment0, kTexture2D, mColorSwapchain[i]->image()->glImage(), 0);
+        ngl.disable(kFramebufferSrgbExt);
+#endif
+    }
+
     void Viewer::submitDepthForView(osg::State& state, osg::FrameBufferObject* depthFbo, Stereo::Eye view)
     {
         if (!mSession->appShouldShareDepthInfo())
@@ -377,19 +474,45 @@ namespace VR
         if (Stereo::getMultiview())
         {
             // TODO: Should cache this, but the pp keeps remaking the depth fbo so i need a dirty/cleanup step too.
-            auto foo = std::make_unique<Stereo::MultiviewFramebufferResolve>(
-                depthFbo, stereoFbo->multiviewFbo(), GL_DEPTH_BUFFER_BIT);
+            auto foo = std::make_unique<Stereo::MultiviewFramebufferResolve>(depthFbo,
+                mRenderToSwapchain ? getXrMultiviewFramebuffer(&state) : stereoFbo->multiviewFbo(),
+                GL_DEPTH_BUFFER_BIT);
             foo->resolveImplementation(state);
+            return;
         }
-        else
-        {
-            stereoFbo->layerFbo(view == Stereo::Eye::Left ? 0 : 1)
-                ->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
-            depthFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
-            osg::GLExtensions* ext = state.get<osg::GLExtensions>();
-            ext->glBlitFramebuffer(0, 0, mFramebufferWidth, mFramebufferHeight, 0, 0, mFramebufferWidth,
-                mFramebufferHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-        }
+
+        int i = view == Stereo::Eye::Right ? 1 : 0;
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        const int width = mDrawFrame.renderWidth;
+        const int height = mDrawFrame.renderHeight;
+        // bindFboForView() left a draw framebuffer bound behind the back of gl4es
+        if (mRenderToSwapchainNatively)
+            ext->glBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
+
+        // The eye framebuffer keeps the depth even when rendering natively, the motion vectors sample it
+        outputFbo(state, i)->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+        depthFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        ext->glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        SceneUtil::countFramebufferCopy();
+
+#ifdef __ANDROID__
+        if (!mRenderToSwapchainNatively)
+            return;
+
+        const auto& ngl = nativeGLES();
+        bool depthStencil = SceneUtil::isDepthStencilFormat(mDepthSwapchain[i]->format());
+        depthFbo->apply(state);
+        static unsigned sDrawFbo = 0;
+        if (!sDrawFbo)
+            ngl.genFramebuffers(1, &sDrawFbo);
+        ngl.bindFramebuffer(kDrawFramebuffer, sDrawFbo);
+        ngl.framebufferTexture2D(kDrawFramebuffer, depthStencil ? kDepthStencilAttachment : kDepthAttachment,
+            kTexture2D, mDepthSwapchain[i]->image()->glImage(), 0);
+        ngl.blitFramebuffer(0, 0, width, height, 0, 0, width, height, kDepthBufferBit, kNearest);
+        ngl.bindFramebuffer(kDrawFramebuffer, 0);
+        SceneUtil::countFramebufferCopy();
+        ext->glBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
+#endif
     }
 
     const VR::Frame& Viewer::currentUpdateFrame()
@@ -403,38 +526,116 @@ namespace VR
     {
         uint32_t colorImage = mColorSwapchain[view]->image()->glImage();
         uint32_t depthImage = 0;
-        uint32_t textureTarget = mColorSwapchain[view]->textureTarget();
 
         if (mSession->appShouldShareDepthInfo())
             depthImage = mDepthSwapchain[view]->image()->glImage();
 
-        auto it = mSwapchainFramebuffers.find(std::pair{ colorImage, depthImage });
+        // Array swapchains are shared by both eyes, each eye gets its own framebuffer for its layer
+        auto key = std::tuple{ colorImage, depthImage, view };
+        auto it = mSwapchainFramebuffers.find(key);
         if (it == mSwapchainFramebuffers.end())
         {
             osg::ref_ptr<osg::FrameBufferObject> fbo = new osg::FrameBufferObject();
 
-            auto colorAttachment = Stereo::createLayerAttachmentFromHandle(
-                state, colorImage, textureTarget, mFramebufferWidth, mFramebufferHeight, view);
+            auto colorAttachment = Stereo::createLayerAttachmentFromHandle(state, colorImage,
+                mColorSwapchain[view]->textureTarget(), mFramebufferWidth, mFramebufferHeight, view);
             fbo->setAttachment(osg::FrameBufferObject::BufferComponent::COLOR_BUFFER, colorAttachment);
 
             if (depthImage != 0)
             {
-                auto depthAttachment = Stereo::createLayerAttachmentFromHandle(
-                    state, depthImage, textureTarget, mFramebufferWidth, mFramebufferHeight, view);
-                fbo->setAttachment(osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER, depthAttachment);
+                auto depthAttachment = Stereo::createLayerAttachmentFromHandle(state, depthImage,
+                    mDepthSwapchain[view]->textureTarget(), mFramebufferWidth, mFramebufferHeight, view);
+                fbo->setAttachment(SceneUtil::isDepthStencilFormat(mDepthSwapchain[view]->format())
+                        ? osg::FrameBufferObject::BufferComponent::PACKED_DEPTH_STENCIL_BUFFER
+                        : osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER,
+                    depthAttachment);
             }
 
-            it = mSwapchainFramebuffers.emplace(std::pair{ colorImage, depthImage }, fbo).first;
+            it = mSwapchainFramebuffers.emplace(key, fbo).first;
         }
         return it->second;
     }
 
+    osg::ref_ptr<osg::FrameBufferObject> Viewer::getXrMultiviewFramebuffer(osg::State* state)
+    {
+        uint32_t colorImage = mColorSwapchain[0]->image()->glImage();
+        uint32_t depthImage = 0;
+
+        if (mSession->appShouldShareDepthInfo())
+            depthImage = mDepthSwapchain[0]->image()->glImage();
+
+        auto it = mSwapchainMultiviewFramebuffers.find(std::pair{ colorImage, depthImage });
+        if (it == mSwapchainMultiviewFramebuffers.end())
+        {
+            osg::ref_ptr<osg::FrameBufferObject> fbo = new osg::FrameBufferObject();
+            fbo->setAttachment(osg::FrameBufferObject::BufferComponent::COLOR_BUFFER,
+                Stereo::createMultiviewAttachmentFromHandle(state, colorImage, mFramebufferWidth, mFramebufferHeight));
+
+            if (depthImage != 0)
+            {
+                fbo->setAttachment(SceneUtil::isDepthStencilFormat(mDepthSwapchain[0]->format())
+                        ? osg::FrameBufferObject::BufferComponent::PACKED_DEPTH_STENCIL_BUFFER
+                        : osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER,
+                    Stereo::createMultiviewAttachmentFromHandle(
+                        state, depthImage, mFramebufferWidth, mFramebufferHeight));
+            }
+
+            it = mSwapchainMultiviewFramebuffers.emplace(std::pair{ colorImage, depthImage }, fbo).first;
+        }
+        return it->second;
+    }
+
+    osg::FrameBufferObject* Viewer::outputFbo(osg::State& state, int i)
+    {
+        // The native path renders through the eye framebuffer, which is all gl4es knows about
+        if (mRenderToSwapchain && !mRenderToSwapchainNatively)
+            return getXrFramebuffer(i, &state);
+        return Stereo::Manager::instance().multiviewFramebuffer()->layerFbo(i);
+    }
+
+    void Viewer::setupRenderToSwapchain()
+    {
+        mRenderToSwapchain = false;
+        if (!Settings::vr().mRenderToSwapchain)
+            return;
+
+        // A multiview framebuffer needs both eyes in the layers of a single array swapchain, see setupSwapchains().
+        // On Android the swapchain textures have to be kept away from gl4es, so the final pass binds them through
+        // the native driver instead, see bindFboForView(). D3D interop swapchains are upside down and keep copying.
+        const char* reason = nullptr;
+        mRenderToSwapchainNatively = false;
+        if (Stereo::getMultiview() && mColorSwapchain[0]->arraySize() < 2)
+            reason = "not supported with multiview by the swapchains";
+#ifdef __ANDROID__
+        if (Stereo::getMultiview())
+            reason = "not supported with multiview on Android";
+        else if (!nativeGLES().ok())
+            reason = "not supported without the native GLES functions";
+        mRenderToSwapchainNatively = true;
+#endif
+        for (auto& swapchain : mColorSwapchain)
+            if (swapchain->mustFlipVertical())
+                reason = "the swapchains must be flipped vertically";
+
+        if (reason)
+        {
+            Log(Debug::Warning) << "Rendering directly to the swapchain is " << reason
+                                << ", falling back to copying";
+            mRenderToSwapchainNatively = false;
+            return;
+        }
+
+        Log(Debug::Verbose) << "Rendering directly to the swapchain";
+        mRenderToSwapchain = true;
+    }
+
     void Viewer::blitXrFramebuffer(osg::State* state, int i)
     {
         auto* gl = osg::GLExtensions::Get(state->getContextID(), false);
 
-        auto width = mSubImages[i].width;
-        auto height = mSubImages[i].height;
+        // Only the rendered region is copied, the projection layer tells the compositor to upscale it.
+        auto width = static_cast<uint32_t>(mDrawFrame.renderWidth);
+        auto height = static_cast<uint32_t>(mDrawFrame.renderHeight);
         bool flip = mColorSwapchain[i]->mustFlipVertical();
 
         uint32_t srcX0 = 0;
@@ -457,6 +658,7 @@ namespace VR
             gl->glBlitFramebuffer(
                 srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
         }
+        SceneUtil::countFramebufferCopy();
 #else
         // Present with a GPU blit, keeping the swapchain texture entirely out of gl4es (gl4es shadows
         // foreign handles -- see NativeGLES note). Trick: gl4es binds GL_FRAMEBUFFER/GL_DRAW_FRAMEBUFFER
@@ -465,13 +667,6 @@ namespace VR
         // the real GL_READ_FRAMEBUFFER the eye FBO -- then natively bind a DRAW FBO holding the real
         // swapchain texture and blit. The native blit reads the live eye FBO and writes the swapchain; the
         // only thing touching the swapchain id is the native driver, so gl4es never shadows it.
-        constexpr unsigned kDrawFramebuffer = 0x8CA9; // GL_DRAW_FRAMEBUFFER
-        constexpr unsigned kColorAttachment0 = 0x8CE0; // GL_COLOR_ATTACHMENT0
-        constexpr unsigned kTexture2D = 0x0DE1; // GL_TEXTURE_2D
-        constexpr unsigned kColorBufferBit = 0x4000; // GL_COLOR_BUFFER_BIT
-        constexpr unsigned kNearest = 0x2600; // GL_NEAREST
-        constexpr unsigned kFramebufferSrgbExt = 0x8DB9; // GL_FRAMEBUFFER_SRGB_EXT (EXT_sRGB_write_control)
-
         // Default apply target is GL_FRAMEBUFFER -> gl4es eagerly binds it as the real read+draw FBO.
         Stereo::Manager::instance().multiviewFramebuffer()->layerFbo(i)->apply(*state);
 
@@ -500,6 +695,161 @@ namespace VR
         gl->glBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
     }
 
+    void Viewer::setupMotionVectorFramebuffer()
+    {
+        const int width = mMotionVectorSwapchain[0]->width();
+        const int height = mMotionVectorSwapchain[0]->height();
+
+        osg::ref_ptr<osg::Texture2D> colorTexture = new osg::Texture2D;
+        colorTexture->setTextureSize(width, height);
+        colorTexture->setInternalFormat(mMotionVectorSwapchain[0]->format());
+        colorTexture->setSourceFormat(GL_RGBA);
+        colorTexture->setSourceType(GL_HALF_FLOAT);
+        colorTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+        colorTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+
+        // Matches the swapchain so both can be copied in a single blit
+        GLenum depthFormat = mMotionVectorDepthSwapchain[0]->format();
+        GLenum depthSourceFormat = 0;
+        GLenum depthSourceType = 0;
+        SceneUtil::getDepthFormatSourceFormatAndType(depthFormat, depthSourceFormat, depthSourceType);
+        osg::ref_ptr<osg::Texture2D> depthTexture = new osg::Texture2D;
+        depthTexture->setTextureSize(width, height);
+        depthTexture->setInternalFormat(depthFormat);
+        depthTexture->setSourceFormat(depthSourceFormat);
+        depthTexture->setSourceType(depthSourceType);
+        depthTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+        depthTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+
+        mMotionVectorFramebuffer = new osg::FrameBufferObject;
+        mMotionVectorFramebuffer->setAttachment(osg::Camera::COLOR_BUFFER, osg::FrameBufferAttachment(colorTexture));
+        mMotionVectorFramebuffer->setAttachment(SceneUtil::isDepthStencilFormat(depthFormat)
+                ? osg::Camera::PACKED_DEPTH_STENCIL_BUFFER
+                : osg::Camera::DEPTH_BUFFER,
+            osg::FrameBufferAttachment(depthTexture));
+
+        if (!mRenderToSwapchain || mRenderToSwapchainNatively)
+            return;
+
+        // The eye depth is then only in the depth swapchain, which is copied to a texture that can be sampled
+        GLenum eyeDepthFormat = mDepthSwapchain[0]->format();
+        SceneUtil::getDepthFormatSourceFormatAndType(eyeDepthFormat, depthSourceFormat, depthSourceType);
+        mEyeDepthTexture = new osg::Texture2D;
+        mEyeDepthTexture->setTextureSize(mFramebufferWidth, mFramebufferHeight);
+        mEyeDepthTexture->setInternalFormat(eyeDepthFormat);
+        mEyeDepthTexture->setSourceFormat(depthSourceFormat);
+        mEyeDepthTexture->setSourceType(depthSourceType);
+        mEyeDepthTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+        mEyeDepthTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+
+        mEyeDepthFramebuffer = new osg::FrameBufferObject;
+        mEyeDepthFramebuffer->setAttachment(SceneUtil::isDepthStencilFormat(eyeDepthFormat)
+                ? osg::Camera::PACKED_DEPTH_STENCIL_BUFFER
+                : osg::Camera::DEPTH_BUFFER,
+            osg::FrameBufferAttachment(mEyeDepthTexture));
+    }
+
+    void Viewer::blitMotionVectors(osg::RenderInfo& info, int i)
+    {
+        auto* state = info.getState();
+        auto* gl = osg::GLExtensions::Get(state->getContextID(), false);
+
+        uint32_t width = mMotionVectorSwapchain[i]->width();
+        uint32_t height = mMotionVectorSwapchain[i]->height();
+
+        // Only the region matching the rendered part of the eye is submitted, see updateView()
+        const osg::Vec2i eyeRegion(mDrawFrame.renderWidth, mDrawFrame.renderHeight);
+        const osg::Vec2i region(static_cast<int>(width * eyeRegion.x() / mFramebufferWidth),
+            static_cast<int>(height * eyeRegion.y() / mFramebufferHeight));
+
+        osg::Texture* eyeDepth = nullptr;
+        if (mRenderToSwapchain && !mRenderToSwapchainNatively)
+        {
+            mEyeDepthFramebuffer->apply(*state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+            outputFbo(*state, i)->apply(*state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+            gl->glBlitFramebuffer(0, 0, eyeRegion.x(), eyeRegion.y(), 0, 0, eyeRegion.x(), eyeRegion.y(),
+                GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+            SceneUtil::countFramebufferCopy();
+            eyeDepth = mEyeDepthTexture;
+        }
+        else
+            eyeDepth = Stereo::Manager::instance().multiviewFramebuffer()->layerDepthBuffer(i);
+
+        mMotionVectorFramebuffer->apply(*state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+        if (mMotionVectors)
+        {
+            std::array<Stereo::View, 2> trackingViews;
+            for (auto& layer : mDrawFrame.layers)
+            {
+                if (layer->getType() != Layer::Type::ProjectionLayer)
+                    continue;
+                auto* projectionLayer = static_cast<VR::ProjectionLayer*>(layer.get());
+                trackingViews = { projectionLayer->views[0].view, projectionLayer->views[1].view };
+            }
+            mMotionVectors->draw(info, i, eyeDepth, eyeRegion, region, trackingViews);
+        }
+        else
+        {
+            // Nothing moves until the scene is set up, and nothing is in front of the far plane
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            glDepthMask(GL_TRUE);
+            glClearColor(0.f, 0.f, 0.f, 0.f);
+            glClearDepth(SceneUtil::AutoDepth::isReversed() ? 0.0 : 1.0);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            state->haveAppliedAttribute(osg::StateAttribute::COLORMASK);
+            state->haveAppliedAttribute(osg::StateAttribute::DEPTH);
+        }
+
+        bool flip = mMotionVectorSwapchain[i]->mustFlipVertical();
+        uint32_t srcY0 = flip ? region.y() : 0;
+        uint32_t srcY1 = flip ? 0 : region.y();
+        uint32_t motionVectorImage = mMotionVectorSwapchain[i]->image()->glImage();
+        uint32_t depthImage = mMotionVectorDepthSwapchain[i]->image()->glImage();
+        bool depthStencil = SceneUtil::isDepthStencilFormat(mMotionVectorDepthSwapchain[i]->format());
+
+#ifndef __ANDROID__
+        auto key = std::tuple{ motionVectorImage, depthImage, 0u };
+        auto it = mSwapchainFramebuffers.find(key);
+        if (it == mSwapchainFramebuffers.end())
+        {
+            osg::ref_ptr<osg::FrameBufferObject> fbo = new osg::FrameBufferObject();
+            fbo->setAttachment(osg::FrameBufferObject::BufferComponent::COLOR_BUFFER,
+                Stereo::createLayerAttachmentFromHandle(
+                    state, motionVectorImage, mMotionVectorSwapchain[i]->textureTarget(), width, height, i));
+            fbo->setAttachment(depthStencil ? osg::FrameBufferObject::BufferComponent::PACKED_DEPTH_STENCIL_BUFFER
+                                            : osg::FrameBufferObject::BufferComponent::DEPTH_BUFFER,
+                Stereo::createLayerAttachmentFromHandle(
+                    state, depthImage, mMotionVectorDepthSwapchain[i]->textureTarget(), width, height, i));
+            it = mSwapchainFramebuffers.emplace(key, fbo).first;
+        }
+
+        it->second->apply(*state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+        mMotionVectorFramebuffer->apply(*state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        gl->glBlitFramebuffer(0, srcY0, region.x(), srcY1, 0, 0, region.x(), region.y(),
+            GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        SceneUtil::countFramebufferCopy();
+#else
+        // Same as the eye in blitXrFramebuffer(): the own framebuffer becomes the real read framebuffer through
+        // gl4es, the swapchain textures are only touched by the native driver.
+        mMotionVectorFramebuffer->apply(*state);
+
+        const auto& ngl = nativeGLES();
+        if (ngl.ok())
+        {
+            static unsigned sDrawFbo = 0;
+            if (!sDrawFbo)
+                ngl.genFramebuffers(1, &sDrawFbo);
+            ngl.bindFramebuffer(kDrawFramebuffer, sDrawFbo);
+            ngl.framebufferTexture2D(kDrawFramebuffer, kColorAttachment0, kTexture2D, motionVectorImage, 0);
+            ngl.framebufferTexture2D(kDrawFramebuffer, depthStencil ? kDepthStencilAttachment : kDepthAttachment,
+                kTexture2D, depthImage, 0);
+            ngl.blitFramebuffer(0, srcY0, region.x(), srcY1, 0, 0, region.x(), region.y(),
+                kColorBufferBit | kDepthBufferBit, kNearest);
+            ngl.bindFramebuffer(kDrawFramebuffer, 0);
+        }
+#endif
+    }
+
     void Viewer::blitMirrorTexture(osg::State* state, int i)
     {
         auto* gl = osg::GLExtensions::Get(state->getContextID(), false);
@@ -515,30 +865,45 @@ namespace VR
         // Which eye is blitted left/right is determined by which order left/right was added to mMirrorTextureViews
         int dstX = 0;
         gl->glBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
-        Stereo::Manager::instance().multiviewFramebuffer()->layerFbo(i)->apply(
-            *state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        outputFbo(*state, i)->apply(*state, osg::FrameBufferObject::READ_FRAMEBUFFER);
         for (auto viewId : mMirrorTextureViews)
         {
             if (viewId == static_cast<unsigned int>(i))
-                gl->glBlitFramebuffer(0, 0, mFramebufferWidth, mFramebufferHeight, dstX, 0, dstX + dstWidth,
-                    screenHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+                gl->glBlitFramebuffer(0, 0, mDrawFrame.renderWidth, mDrawFrame.renderHeight, dstX, 0,
+                    dstX + dstWidth, screenHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
             dstX += dstWidth;
         }
     }
 
     void Viewer::setupSwapchains()
     {
+        // Multiview renders both eyes at once, so rendering it directly to the swapchain needs one swapchain holding
+        // each eye in a layer. The native Android path attaches plain 2D textures only.
+        bool arraySwapchains = Settings::vr().mRenderToSwapchain && Stereo::getMultiview();
+#ifdef __ANDROID__
+        arraySwapchains = false;
+#endif
+        const uint32_t arraySize = arraySwapchains ? 2 : 1;
+
         for (int i : { 0, 1 })
         {
-            mColorSwapchain[i] = VR::Session::instance().createSwapchain(mFramebufferWidth, mFramebufferHeight, 1, 1,
-                VR::Swapchain::Attachment::Color, i == 0 ? "LeftEye" : "RightEye");
-            if (mSession->appShouldShareDepthInfo())
+            if (arraySwapchains && i == 1)
+            {
+                mColorSwapchain[1] = mColorSwapchain[0];
+                mDepthSwapchain[1] = mDepthSwapchain[0];
+            }
+            else
+                mColorSwapchain[i] = VR::Session::instance().createSwapchain(mFramebufferWidth, mFramebufferHeight, 1,
+                    arraySize, VR::Swapchain::Attachment::Color,
+                    arraySwapchains ? "Eyes" : i == 0 ? "LeftEye" : "RightEye");
+            if (mSession->appShouldShareDepthInfo() && !mDepthSwapchain[i])
             {
                 // Depth support is buggy or just not supported on some runtimes and has to be guarded.
                 try
                 {
                     mDepthSwapchain[i] = VR::Session::instance().createSwapchain(mFramebufferWidth, mFramebufferHeight,
-                        1, 1, VR::Swapchain::Attachment::DepthStencil, i == 0 ? "LeftEye" : "RightEye");
+                        1, arraySize, VR::Swapchain::Attachment::DepthStencil,
+                        arraySwapchains ? "Eyes" : i == 0 ? "LeftEye" : "RightEye");
                 }
                 catch (std::exception& e)
                 {
@@ -549,6 +914,33 @@ namespace VR
                     mDepthSwapchain[0] = mDepthSwapchain[1] = nullptr;
                 }
             }
+            if (mSession->appShouldShareDepthInfo() && mSession->appShouldSubmitMotionVectors())
+            {
+                auto resolution = mSession->motionVectorResolution();
+                try
+                {
+                    mMotionVectorSwapchain[i] = VR::Session::instance().createSwapchain(resolution.x(),
+                        resolution.y(), 1, 1, VR::Swapchain::Attachment::MotionVector,
+                        i == 0 ? "LeftEyeMotionVector" : "RightEyeMotionVector");
+                    mMotionVectorDepthSwapchain[i] = VR::Session::instance().createSwapchain(resolution.x(),
+                        resolution.y(), 1, 1, VR::Swapchain::Attachment::DepthStencil,
+                        i == 0 ? "LeftEyeMotionVectorDepth" : "RightEyeMotionVectorDepth");
+                }
+                catch (std::exception& e)
+                {
+                    Log(Debug::Warning) << "XR_FB_space_warp was enabled, but motion vector swapchains could not be "
+                                           "created. Motion vectors will not be submitted: "
+                                        << e.what();
+                    mSession->setAppShouldSubmitMotionVectors(false);
+                }
+            }
+        }
+
+        if (!mSession->appShouldShareDepthInfo() || !mSession->appShouldSubmitMotionVectors())
+        {
+            mSession->setAppShouldSubmitMotionVectors(false);
+            mMotionVectorSwapchain[0] = mMotionVectorSwapchain[1] = nullptr;
+            mMotionVectorDepthSwapchain[0] = mMotionVectorDepthSwapchain[1] = nullptr;
         }
     }
 
@@ -557,21 +949,40 @@ namespace VR
         auto* state = info.getState();
         auto* gl = osg::GLExtensions::Get(state->getContextID(), false);
 
+        // Array swapchains are shared by both eyes and must only be acquired and released once
+        std::vector<VR::Swapchain*> swapchains;
+        for (auto* eyeSwapchains : { &mColorSwapchain, &mDepthSwapchain, &mMotionVectorSwapchain,
+                 &mMotionVectorDepthSwapchain })
+            for (auto& swapchain : *eyeSwapchains)
+                if (swapchain && std::find(swapchains.begin(), swapchains.end(), swapchain.get()) == swapchains.end())
+                    swapchains.push_back(swapchain.get());
+
+        for (auto* swapchain : swapchains)
+            swapchain->beginFrame(state->getGraphicsContext());
+
         for (auto i = 0; i < 2; i++)
         {
-            mColorSwapchain[i]->beginFrame(state->getGraphicsContext());
-            if (mSession->appShouldShareDepthInfo())
-                mDepthSwapchain[i]->beginFrame(state->getGraphicsContext());
-
-            if (mMirrorTextureEnabled)
+            // The eye framebuffer does not hold the image when rendering natively
+            if (mMirrorTextureEnabled && !mRenderToSwapchainNatively)
                 blitMirrorTexture(state, i);
-            blitXrFramebuffer(state, i);
+            if (!mRenderToSwapchain)
+                blitXrFramebuffer(state, i);
+            if (mSession->appShouldSubmitMotionVectors())
+                blitMotionVectors(info, i);
 
-            mColorSwapchain[i]->endFrame(state->getGraphicsContext());
-            if (mSession->appShouldShareDepthInfo())
-                mDepthSwapchain[i]->endFrame(state->getGraphicsContext());
+            // Everything has been read from the eye framebuffer, it is redrawn from scratch next frame
+            if (!mRenderToSwapchain || mRenderToSwapchainNatively)
+            {
+                Stereo::Manager::instance().multiviewFramebuffer()->layerFbo(i)->apply(
+                    *state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+                SceneUtil::invalidateFramebuffer(
+                    *state, GL_READ_FRAMEBUFFER_EXT, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            }
         }
 
+        for (auto* swapchain : swapchains)
+            swapchain->endFrame(state->getGraphicsContext());
+
         // Undo all framebuffer bindings we have done.
         gl->glBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
     }
@@ -588,6 +999,41 @@ namespace VR
             mReadyFrames.pop();
         }
         VR::Session::instance().frameBeginRender(mDrawFrame);
+
+        if (mLateLatchHeadPose && mDrawFrame.shouldRender && mDrawFrame.headPose)
+            lateLatch(info, mDrawFrame);
+    }
+
+    void Viewer::lateLatch(osg::RenderInfo& info, VR::Frame& frame)
+    {
+        // Re-locating the views this close to draw gives the runtime a much shorter prediction interval than the
+        // query made during update. Both use the same display time, so the runtime's own timing stays consistent.
+        auto referenceSpaceLocal = mSession->getReferenceSpace(VR::ReferenceSpace::Local);
+        auto localViews = mSession->locateViews(frame.predictedDisplayTime, *referenceSpaceLocal);
+
+        // Express the new eye poses relative to the head pose the frame was culled with.
+        const Stereo::Pose toCulledHead = inversePose(*frame.headPose);
+        std::array<Stereo::View, 2> latchedViews;
+        for (auto side : { VR::Side_Left, VR::Side_Right })
+        {
+            latchedViews[side].pose = toCulledHead + localViews[side].pose;
+            latchedViews[side].fov = localViews[side].fov;
+        }
+        Stereo::Manager::instance().lateLatchViews(info, latchedViews);
+        if (mMotionVectors)
+            mMotionVectors->lateLatchViews(info.getState()->getFrameStamp()->getFrameNumber(), latchedViews);
+
+        // The compositor must reproject from the pose we actually rendered with.
+        for (auto& layer : frame.layers)
+        {
+            if (layer->getType() != Layer::Type::ProjectionLayer)
+                continue;
+            auto* projectionLayer = static_cast<VR::ProjectionLayer*>(layer.get());
+            if (projectionLayer->space != referenceSpaceLocal)
+                continue;
+            for (auto side : { VR::Side_Left, VR::Side_Right })
+                projectionLayer->views[side].view = localViews[side];
+        }
     }
 
     void Viewer::finalDrawCallback(osg::RenderInfo& info, Misc::CallbackManager::View view)
@@ -615,12 +1061,81 @@ namespace VR
         mReadyFrames.push(frame);
     }
 
+    void Viewer::updateDynamicResolution()
+    {
+        if (!mDynamicResolution)
+            return;
+
+        osg::Stats* cameraStats = mViewer->getCamera()->getStats();
+        const unsigned int frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+
+        // Draw and GPU timings of a frame are only complete a few frames later, same as for the stats report
+        constexpr unsigned int statsDelay = 3;
+
+        // The profiler overlay resets these whenever it is toggled
+        cameraStats->collectStats("rendering", true);
+        cameraStats->collectStats("gpu", true);
+
+        if (frameNumber >= statsDelay)
+        {
+            // Cull, draw and GPU run in parallel on different frames, the slowest stage bounds the frame rate
+            double frameCost = 0;
+            for (const char* attribute :
+                { "Cull traversal time taken", "Draw traversal time taken", "GPU draw time taken" })
+            {
+                double value = 0;
+                if (cameraStats->getAttribute(frameNumber - statsDelay, attribute, value))
+                    frameCost = std::max(frameCost, value);
+            }
+
+            const double displayPeriod = static_cast<double>(VR::getPredictedDisplayPeriod()) * 1e-9;
+            if (frameCost > 0)
+                mDynamicResolution->update(frameCost, displayPeriod);
+        }
+
+        const float scale = mRequireFullResolution ? 1.f : mDynamicResolution->getScale();
+        if (scale < 1.f)
+            setRenderResolution(osg::Vec2i(static_cast<int>(mFramebufferWidth * scale) & ~1,
+                static_cast<int>(mFramebufferHeight * scale) & ~1));
+        else
+            setRenderResolution(osg::Vec2i(mFramebufferWidth, mFramebufferHeight));
+
+        osg::Stats* viewerStats = mViewer->getViewerStats();
+        if (viewerStats->collectStats("resource"))
+        {
+            mDynamicResolution->reportStats(frameNumber, *viewerStats);
+            viewerStats->setAttribute(frameNumber, "VR Resolution Width", mRenderResolution.x());
+            viewerStats->setAttribute(frameNumber, "VR Resolution Height", mRenderResolution.y());
+        }
+    }
+
+    void Viewer::setRenderResolution(const osg::Vec2i& resolution)
+    {
+        if (resolution == mRenderResolution)
+            return;
+
+        Log(Debug::Verbose) << "Dynamic resolution: " << resolution.x() << "x" << resolution.y();
+
+        // Framebuffers and swapchains keep their full size, only the rendered region changes. The scene viewport
+        // follows the stereo manager, the projection layer's sub image tells the compositor what to upscale.
+        mRenderResolution = resolution;
+        Stereo::Manager::instance().setRenderResolution(resolution);
+    }
+
+    osg::Vec2i Viewer::drawResolution() const
+    {
+        return osg::Vec2i(mDrawFrame.renderWidth, mDrawFrame.renderHeight);
+    }
+
     void Viewer::updateView(Stereo::View& left, Stereo::View& right)
     {
         newFrame();
+        updateDynamicResolution();
 
         std::unique_lock<std::mutex> lock(mMutex);
         auto& frame = mReadyFrames.back();
+        frame.renderWidth = mRenderResolution.x();
+        frame.renderHeight = mRenderResolution.y();
 
         auto referenceSpaceLocal = mSession->getReferenceSpace(VR::ReferenceSpace::Local);
         auto referenceSpaceView = mSession->getReferenceSpace(VR::ReferenceSpace::View);
@@ -645,10 +1160,26 @@ namespace VR
             std::shared_ptr<VR::ProjectionLayer> projectionLayer
                 = std::make_shared<VR::ProjectionLayer>(*mProjectionLayer);
 
+            if (mLateLatchHeadPose)
+            {
+                auto headPose = referenceSpaceView->locate(*referenceSpaceLocal);
+                if (!!headPose.status)
+                    frame.headPose = headPose.pose;
+            }
+
             projectionLayer->space = referenceSpaceLocal;
             for (uint32_t i = 0; i < 2; i++)
             {
                 projectionLayer->views[i].view = localViews[i];
+                projectionLayer->views[i].subImage.width = mRenderResolution.x();
+                projectionLayer->views[i].subImage.height = mRenderResolution.y();
+                if (auto& motionVectorSwapchain = projectionLayer->views[i].motionVectorSwapchain)
+                {
+                    projectionLayer->views[i].motionVectorSubImage.width
+                        = motionVectorSwapchain->width() * mRenderResolution.x() / mFramebufferWidth;
+                    projectionLayer->views[i].motionVectorSubImage.height
+                        = motionVectorSwapchain->height() * mRenderResolution.y() / mFramebufferHeight;
+                }
             }
             frame.layers.push_back(projectionLayer);
             if (!mLayers.empty())
@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <tuple>
 
 #include <osg/Camera>
 #include <osg/Group>
@@ -15,12 +16,14 @@
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/stereo/multiview.hpp>
 #include <components/vr/constants.hpp>
+#include <components/vr/dynamicresolution.hpp>
 #include <components/vr/frame.hpp>
 #include <components/vr/layer.hpp>
 #include <components/vr/vr.hpp>
 
 namespace osg
 {
+    class Texture2D;
     class Transform;
 }
 
@@ -30,8 +33,14 @@ namespace Stereo
     struct View;
 }
 
+namespace Shader
+{
+    class ShaderManager;
+}
+
 namespace VR
 {
+    class MotionVectors;
     class Swapchain;
     class TrackingManager;
     class Session;
@@ -75,18 +84,43 @@ namespace VR
         void insertLayer(std::shared_ptr<Layer> layer);
         void removeLayer(std::shared_ptr<Layer> layer);
 
-        osg::ref_ptr<osg::FrameBufferObject> getFboForView(Stereo::Eye view);
+        //! Framebuffer the post processor writes the final image of the view to. When rendering directly to the
+        //! swapchain this acquires the swapchain images of the view.
+        osg::ref_ptr<osg::FrameBufferObject> getFboForView(osg::State& state, Stereo::Eye view);
+
+        //! Must be called whenever the framebuffer from getFboForView() has been bound for drawing. On Android the
+        //! swapchain images are only drawn to through the native driver, which is bound in its place.
+        void bindFboForView(osg::State& state, Stereo::Eye view);
 
         void submitDepthForView(osg::State& state, osg::FrameBufferObject* fbo, Stereo::Eye view);
 
         const VR::Frame& currentUpdateFrame();
 
+        //! Size of the rendered region of the eye framebuffers for the frame being drawn.
+        //! Must be called from the draw thread.
+        osg::Vec2i drawResolution() const;
+
+        //! Keeps dynamic resolution at full resolution, for rendering that can only use the full framebuffers.
+        void setRequireFullResolution(bool require) { mRequireFullResolution = require; }
+
+        //! Starts rendering real motion vectors for space warp, until then only the depth is submitted with zero
+        //! motion. Does nothing when space warp is not active.
+        void setupMotionVectors(Shader::ShaderManager& shaderManager);
+
     private:
         osg::ref_ptr<osg::FrameBufferObject> getXrFramebuffer(uint32_t view, osg::State* state);
+        osg::ref_ptr<osg::FrameBufferObject> getXrMultiviewFramebuffer(osg::State* state);
         void blitXrFramebuffer(osg::State* state, int i);
         void blitMirrorTexture(osg::State* state, int i);
+        void blitMotionVectors(osg::RenderInfo& info, int i);
+        void setupMotionVectorFramebuffer();
         void setupSwapchains();
+        void setupRenderToSwapchain();
+        osg::FrameBufferObject* outputFbo(osg::State& state, int i);
         void newFrame();
+        void lateLatch(osg::RenderInfo& info, VR::Frame& frame);
+        void updateDynamicResolution();
+        void setRenderResolution(const osg::Vec2i& resolution);
 
     private:
         std::mutex mMutex{};
@@ -103,16 +137,37 @@ namespace VR
         bool mMirrorTextureEnabled{ false };
         bool mFlipMirrorTextureOrder{ false };
         MirrorTextureEye mMirrorTextureEye{ MirrorTextureEye::Both };
+        bool mLateLatchHeadPose{ false };
+        bool mRenderToSwapchain{ false };
+        //! Rendering to the swapchain goes through the native GLES driver, the eye framebuffers keep the depth.
+        bool mRenderToSwapchainNatively{ false };
 
         osg::ref_ptr<osg::FrameBufferObject> mGammaResolveFramebuffer;
         int mFramebufferWidth = 0;
         int mFramebufferHeight = 0;
+        //! Region of the framebuffers that is actually rendered to, smaller than the framebuffers
+        //! when dynamic resolution has scaled down.
+        osg::Vec2i mRenderResolution;
+        std::unique_ptr<DynamicResolution> mDynamicResolution;
+        bool mRequireFullResolution{ false };
 
         std::array<std::shared_ptr<VR::Swapchain>, 2> mColorSwapchain;
         std::array<std::shared_ptr<VR::Swapchain>, 2> mDepthSwapchain;
+        std::array<std::shared_ptr<VR::Swapchain>, 2> mMotionVectorSwapchain;
+        std::array<std::shared_ptr<VR::Swapchain>, 2> mMotionVectorDepthSwapchain;
+        std::unique_ptr<MotionVectors> mMotionVectors;
+        //! Motion vectors are rendered here and copied to the swapchains, which only the native GLES driver may
+        //! touch on Android.
+        osg::ref_ptr<osg::FrameBufferObject> mMotionVectorFramebuffer;
+        //! Copy of the depth of the eye when rendering directly to the swapchain.
+        osg::ref_ptr<osg::FrameBufferObject> mEyeDepthFramebuffer;
+        osg::ref_ptr<osg::Texture2D> mEyeDepthTexture;
         std::array<VR::SubImage, 2> mSubImages;
 
-        std::map<std::pair<uint32_t, uint32_t>, osg::ref_ptr<osg::FrameBufferObject>> mSwapchainFramebuffers;
+        //! Framebuffers of swapchain images by color image, depth image and array layer.
+        std::map<std::tuple<uint32_t, uint32_t, uint32_t>, osg::ref_ptr<osg::FrameBufferObject>>
+            mSwapchainFramebuffers;
+        std::map<std::pair<uint32_t, uint32_t>, osg::ref_ptr<osg::FrameBufferObject>> mSwapchainMultiviewFramebuffers;
 
         std::queue<VR::Frame> mReadyFrames;
         VR::Frame mDrawFrame;
@@ -62,8 +62,7 @@ namespace XR
         // List of extensions we always enable if supported
         std::vector<std::string> autoExtensions = {
             "XR_KHR_composition_layer_depth", "XR_EXT_debug_utils", "XR_MSFT_composition_layer_reprojection",
-            // "XR_FB_space_warp",
-
+            "XR_FB_space_warp",
         };
 
         for (auto& extension : autoExtensions)
@@ -601,7 +601,9 @@ namespace XR
     std::pair<int64_t, GLenum> Platform::selectSwapchainFormat(
         VR::Swapchain::Attachment attachment)
     {
-        std::string typeString = attachment == VR::Swapchain::Attachment::Color ? "color" : "depth";
+        std::string typeString = attachment == VR::Swapchain::Attachment::Color ? "color"
+            : attachment == VR::Swapchain::Attachment::MotionVector           ? "motion vector"
+                                                                               : "depth";
         GLenum glFormat = 0;
         if (attachment == VR::Swapchain::Attachment::Color)
         {
@@ -609,6 +611,13 @@ namespace XR
                 throw std::runtime_error("Could not find a usable runtime color format");
             glFormat = SceneUtil::Color::colorInternalFormat();
         }
+        else if (attachment == VR::Swapchain::Attachment::MotionVector)
+        {
+            // XR_FB_space_warp mandates a signed float format for motion vectors
+            glFormat = GL_RGBA16F;
+            if (std::find(mMWColorFormatsGL.begin(), mMWColorFormatsGL.end(), glFormat) == mMWColorFormatsGL.end())
+                throw std::runtime_error("The runtime does not support GL_RGBA16F, cannot submit motion vectors.");
+        }
         else
         {
             if (mMWDepthFormatsGL.empty())
@@ -7,6 +7,7 @@
 
 #include <components/misc/constants.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/settings/values.hpp>
 #include <components/vr/frame.hpp>
 #include <components/vr/layer.hpp>
 #include <components/vr/trackingsource.hpp>
@@ -109,6 +110,10 @@ namespace XR
         compositionLayerDepth[0].type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR;
         compositionLayerDepth[1].type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR;
 
+        std::array<XrCompositionLayerSpaceWarpInfoFB, 2> compositionLayerSpaceWarp{};
+        compositionLayerSpaceWarp[0].type = XR_TYPE_COMPOSITION_LAYER_SPACE_WARP_INFO_FB;
+        compositionLayerSpaceWarp[1].type = XR_TYPE_COMPOSITION_LAYER_SPACE_WARP_INFO_FB;
+
         XrCompositionLayerReprojectionInfoMSFT reprojectionInfoDepth{};
         reprojectionInfoDepth.type = XR_TYPE_COMPOSITION_LAYER_REPROJECTION_INFO_MSFT;
         reprojectionInfoDepth.reprojectionMode = XR_REPROJECTION_MODE_DEPTH_MSFT;
@@ -164,7 +169,7 @@ namespace XR
                                 xrDepth.maxDepth = 1.0;
                                 xrDepth.nearZ = nearClip;
                                 xrDepth.farZ = farClip;
-                                xrDepth.subImage.imageArrayIndex = 0;
+                                xrDepth.subImage.imageArrayIndex = view.subImage.index;
                                 xrDepth.subImage.imageRect.extent.width = view.subImage.width;
                                 xrDepth.subImage.imageRect.extent.height = view.subImage.height;
                                 xrDepth.subImage.imageRect.offset.x = view.subImage.x;
@@ -174,6 +179,45 @@ namespace XR
                                 auto& xrView = compositionLayerProjectionViews[i];
                                 xrView.next = &xrDepth;
                             }
+
+                            if (appShouldSubmitMotionVectors())
+                            {
+                                // The movement of the tracking space through the world is part of the motion
+                                // vectors along with the movement of objects, see VR::MotionVectors.
+                                const Stereo::Pose appSpaceDelta{};
+
+                                for (uint32_t i = 0; i < 2; i++)
+                                {
+                                    auto& view = projectionLayer->views[i];
+                                    if (!view.motionVectorSwapchain || !view.motionVectorDepthSwapchain)
+                                        continue;
+
+                                    auto& xrSpaceWarp = compositionLayerSpaceWarp[i];
+                                    xrSpaceWarp.layerFlags = 0;
+                                    xrSpaceWarp.appSpaceDeltaPose = toXR(appSpaceDelta);
+                                    xrSpaceWarp.minDepth = 0.;
+                                    xrSpaceWarp.maxDepth = 1.0;
+                                    xrSpaceWarp.nearZ = nearClip;
+                                    xrSpaceWarp.farZ = farClip;
+                                    for (auto* subImage :
+                                        { &xrSpaceWarp.motionVectorSubImage, &xrSpaceWarp.depthSubImage })
+                                    {
+                                        subImage->imageArrayIndex = 0;
+                                        subImage->imageRect.extent.width = view.motionVectorSubImage.width;
+                                        subImage->imageRect.extent.height = view.motionVectorSubImage.height;
+                                        subImage->imageRect.offset.x = view.motionVectorSubImage.x;
+                                        subImage->imageRect.offset.y = view.motionVectorSubImage.y;
+                                    }
+                                    xrSpaceWarp.motionVectorSubImage.swapchain
+                                        = static_cast<XrSwapchain>(view.motionVectorSwapchain->handle());
+                                    xrSpaceWarp.depthSubImage.swapchain
+                                        = static_cast<XrSwapchain>(view.motionVectorDepthSwapchain->handle());
+
+                                    auto& xrView = compositionLayerProjectionViews[i];
+                                    xrSpaceWarp.next = xrView.next;
+                                    xrView.next = &xrSpaceWarp;
+                                }
+                            }
                         }
 
                         const void** layerNext = &xrProjectionLayer.next;
@@ -435,6 +479,7 @@ namespace XR
     {
         initCompositionLayerDepth();
         initMSFTReprojection();
+        initSpaceWarp();
         createReferenceSpaces();
     }
 
@@ -511,6 +556,40 @@ namespace XR
         }
     }
 
+    void Session::initSpaceWarp()
+    {
+        if (!Settings::vr().mSpaceWarp)
+            return;
+
+        if (!XR::Extensions::instance().extensionEnabled(XR_FB_SPACE_WARP_EXTENSION_NAME))
+        {
+            Log(Debug::Warning) << "Space warp was requested, but " << XR_FB_SPACE_WARP_EXTENSION_NAME
+                                << " is not supported by the runtime";
+            return;
+        }
+
+        // Space warp reconstructs from depth, there is nothing to submit without it
+        if (!appShouldShareDepthInfo())
+        {
+            Log(Debug::Warning) << "Space warp was requested, but depth submission is unavailable";
+            return;
+        }
+
+        XrSystemSpaceWarpPropertiesFB spaceWarpProperties{};
+        spaceWarpProperties.type = XR_TYPE_SYSTEM_SPACE_WARP_PROPERTIES_FB;
+        XrSystemProperties systemProperties{};
+        systemProperties.type = XR_TYPE_SYSTEM_PROPERTIES;
+        systemProperties.next = &spaceWarpProperties;
+        CHECK_XRCMD(xrGetSystemProperties(
+            Instance::instance().xrInstance(), Instance::instance().xrSystemId(), &systemProperties));
+
+        mMotionVectorResolution = osg::Vec2i(spaceWarpProperties.recommendedMotionVectorImageRectWidth,
+            spaceWarpProperties.recommendedMotionVectorImageRectHeight);
+        Log(Debug::Verbose) << "Space warp enabled, recommended motion vector resolution: "
+                            << mMotionVectorResolution.x() << "x" << mMotionVectorResolution.y();
+        setAppShouldSubmitMotionVectors(mMotionVectorResolution.x() > 0 && mMotionVectorResolution.y() > 0);
+    }
+
     std::shared_ptr<VR::Swapchain> Session::createSwapchain(uint32_t width, uint32_t height, uint32_t samples,
         uint32_t arraySize, VR::Swapchain::Attachment attachment, const std::string& name)
     {
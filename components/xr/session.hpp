@@ -71,6 +71,7 @@ namespace XR
 
         void initCompositionLayerDepth();
         void initMSFTReprojection();
+        void initSpaceWarp();
 
         void destroyXrSession();
 
@@ -92,7 +92,9 @@ namespace XR
 
     void Swapchain::init()
     {
-        std::string typeString = mAttachment == Attachment::Color ? "color" : "depth";
+        std::string typeString = mAttachment == Attachment::Color ? "color"
+            : mAttachment == Attachment::MotionVector             ? "motion vector"
+                                                                  : "depth";
 
         XrSwapchainCreateInfo swapchainCreateInfo{};
         swapchainCreateInfo.type = XR_TYPE_SWAPCHAIN_CREATE_INFO;
@@ -103,7 +105,7 @@ namespace XR
         swapchainCreateInfo.faceCount = 1;
         swapchainCreateInfo.format = 0;
         swapchainCreateInfo.usageFlags = 0;
-        if (mAttachment == Attachment::Color)
+        if (mAttachment == Attachment::Color || mAttachment == Attachment::MotionVector)
             swapchainCreateInfo.usageFlags |= XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT;
         else
             swapchainCreateInfo.usageFlags |= XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
@@ -0,0 +1,28 @@
+#version 120
+
+uniform vec2 foveationRadii;
+
+varying vec2 ndc;
+varying vec2 fovea;
+
+void main()
+{
+    // Fragments are shaded in 2x2 quads, a quad with a single shaded pixel costs as much as a full one.
+    // Whole quads are skipped, and the radius is taken at the quad center so all of its pixels agree.
+    vec2 quad = floor(gl_FragCoord.xy * 0.5);
+    vec2 ndcPerPixel = vec2(dFdx(ndc.x), dFdy(ndc.y));
+    vec2 quadCenter = ndc + (quad * 2.0 + 1.0 - gl_FragCoord.xy) * ndcPerPixel;
+    float radius = length(quadCenter - fovea);
+
+    if (radius < foveationRadii.x)
+        discard;
+
+    vec2 parity = mod(quad, 2.0);
+
+    // Between the radii every other quad is shaded, beyond the outer radius one quad of each 2x2 block of quads.
+    // Quads with two even coordinates are shaded everywhere, reconstruction relies on that.
+    bool shaded = radius < foveationRadii.y ? parity.x == parity.y : parity.x + parity.y == 0.0;
+
+    if (shaded)
+        discard;
+}
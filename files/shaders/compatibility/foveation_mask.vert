@@ -0,0 +1,17 @@
+#version 120
+
+varying vec2 ndc;
+varying vec2 fovea;
+
+#include "lib/core/vertex.h.glsl"
+
+void main()
+{
+    // The depth of the near plane comes with the vertices, so the fragment shader doesn't write gl_FragDepth
+    gl_Position = vec4(gl_Vertex.xyz, 1.0);
+    ndc = gl_Position.xy;
+
+    // Projected view direction, the center of an asymmetric frustum is not at the center of the screen
+    vec4 center = viewToClip(vec4(0.0, 0.0, -1.0, 0.0));
+    fovea = center.xy / center.w;
+}
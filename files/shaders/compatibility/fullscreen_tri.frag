@@ -4,7 +4,34 @@ varying vec2 uv;
 
 #include "lib/core/fragment.h.glsl"
 
+#if @foveation
+uniform float foveationDepth;
+uniform vec2 foveationTexelSize;
+// Size of the rendered region of the scene texture in pixels
+uniform vec2 foveationResolution;
+
+// Fills in 2x2 quads skipped by the foveation mask with the nearest shaded pixel. Quads with two even coordinates are
+// never skipped, so a skipped quad is shaded on both sides along each of its odd axes.
+vec4 reconstructFoveated(vec2 coord)
+{
+    vec2 pixel = floor(coord / foveationTexelSize);
+    vec2 quad = floor(pixel * 0.5);
+    vec2 offset = pixel - quad * 2.0;
+    // One pixel before the quad for its first row or column, one after it for the second
+    vec2 nearest = pixel + mod(quad, 2.0) * (offset * 2.0 - 1.0);
+    // Except at the far edge, where there is nothing after the quad
+    nearest = mix(nearest, pixel - offset - 1.0, step(foveationResolution, nearest + 0.5));
+
+    bool skipped = sampleOpaqueDepthTex(coord).x == foveationDepth;
+    return samplerLastShader(skipped ? (nearest + 0.5) * foveationTexelSize : coord);
+}
+#endif
+
 void main()
 {
+#if @foveation
+    gl_FragColor = reconstructFoveated(uv);
+#else
     gl_FragColor = samplerLastShader(uv);
-}
\ No newline at end of file
+#endif
+}
@@ -0,0 +1,39 @@
+#version 120
+
+uniform sampler2D depthTex;
+uniform vec2 scaling;
+uniform mat4 reprojection;
+uniform int objectCount;
+uniform mat4 objectBoxes[@maxObjects];
+uniform mat4 objectReprojections[@maxObjects];
+
+varying vec2 uv;
+
+void main()
+{
+    float depth = texture2D(depthTex, uv).r;
+#if @reverseZ
+    vec4 ndc = vec4(uv / scaling * 2.0 - 1.0, depth, 1.0);
+#else
+    vec4 ndc = vec4(uv / scaling * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+#endif
+
+    // Pixels outside of the bounding boxes of all moving objects only move with the tracking space
+    mat4 toPrevious = reprojection;
+    for (int i = 0; i < @maxObjects; ++i)
+    {
+        if (i >= objectCount)
+            break;
+
+        vec4 box = objectBoxes[i] * ndc;
+        if (all(lessThanEqual(abs(box.xyz), vec3(abs(box.w)))))
+        {
+            toPrevious = objectReprojections[i];
+            break;
+        }
+    }
+
+    vec4 previous = toPrevious * ndc;
+    gl_FragData[0] = vec4(ndc.xyz - previous.xyz / previous.w, 0.0);
+    gl_FragDepth = depth;
+}
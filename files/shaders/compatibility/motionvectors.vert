@@ -0,0 +1,11 @@
+#version 120
+
+uniform vec2 scaling;
+
+varying vec2 uv;
+
+void main()
+{
+    gl_Position = vec4(gl_Vertex.xyz, 1.0);
+    uv = (gl_Position.xy * 0.5 + 0.5) * scaling;
+}